@@ -0,0 +1,18 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+/** @file */
+
+#ifndef _VT_CHANGEPOINT_CONFIG_H
+#define _VT_CHANGEPOINT_CONFIG_H
+
+/* Chance per check that a sensor which has not changed is reported as changed, the CUSUM decision interval is ln(1 / rate) */
+#define VT_CHANGEPOINT_DEFAULT_FALSE_ALARM_RATE 0.001f
+/* Fraction of captures failing on a healthy sensor, from noise alone */
+#define VT_CHANGEPOINT_DEFAULT_IN_CONTROL_FAIL_RATE 0.05f
+/* Fraction of captures failing once the sensor has changed */
+#define VT_CHANGEPOINT_DEFAULT_OUT_OF_CONTROL_FAIL_RATE 0.5f
+/* EWMA weight of the newest drift in the debounced drift */
+#define VT_CHANGEPOINT_DEFAULT_DRIFT_WEIGHT 0.25f
+
+#endif
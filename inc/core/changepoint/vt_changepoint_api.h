@@ -0,0 +1,50 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+/** @file */
+
+#ifndef _VT_CHANGEPOINT_API_H
+#define _VT_CHANGEPOINT_API_H
+
+#include "vt_changepoint_config.h"
+#include "vt_defs.h"
+
+/* Bernoulli CUSUM over failing checks and EWMA over drift, cusum accumulates the log-likelihood ratio of the sensor having
+   changed while in control and of it having recovered while in alarm. Until the first decision after a reset the raw status
+   of every check is reported while cusum and recovery_cusum gather evidence for a change and for a match */
+typedef struct VT_CHANGEPOINT_DETECTOR_STRUCT
+{
+    VT_FLOAT fail_score;
+    VT_FLOAT pass_score;
+    VT_FLOAT decision_interval;
+    VT_FLOAT drift_weight;
+    VT_FLOAT cusum;
+    VT_FLOAT recovery_cusum;
+    VT_FLOAT drift;
+    VT_UINT status;
+    VT_BOOL decided;
+    VT_BOOL drift_available;
+} VT_CHANGEPOINT_DETECTOR;
+
+// Initialize a detector with the default false alarm rate and fail rates
+VT_VOID vt_changepoint_detector_initialize(VT_CHANGEPOINT_DETECTOR* detector);
+
+// Set the false alarm rate per check, the fail rates of a healthy and a changed sensor and the EWMA weight of the drift,
+// resets the detector
+VT_UINT vt_changepoint_detector_configure(VT_CHANGEPOINT_DETECTOR* detector,
+    VT_FLOAT false_alarm_rate,
+    VT_FLOAT in_control_fail_rate,
+    VT_FLOAT out_of_control_fail_rate,
+    VT_FLOAT drift_weight);
+
+// Forget every check, call after the template changes
+VT_VOID vt_changepoint_detector_reset(VT_CHANGEPOINT_DETECTOR* detector);
+
+// Consume the status and drift of one check, VT_SIGNATURE_DB_EMPTY passes through undebounced
+VT_VOID vt_changepoint_detector_update(VT_CHANGEPOINT_DETECTOR* detector, VT_UINT sensor_status, VT_UINT sensor_drift);
+
+// Fetch the debounced status and drift, VT_SIGNATURE_EVAL_DEFAULT_VALUE until the first check and the raw status of the
+// latest check until the first decision
+VT_VOID vt_changepoint_detector_fetch_status(VT_CHANGEPOINT_DETECTOR* detector, VT_UINT* sensor_status, VT_UINT* sensor_drift);
+
+#endif
@@ -0,0 +1,41 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#ifndef _VT_CODEC_BINARY_H
+#define _VT_CODEC_BINARY_H
+
+#include "vt_codec_api.h"
+#include "vt_defs.h"
+
+/* Cursor over an encode or decode buffer, error latches on the first field that does not fit or is out of range */
+typedef struct VT_CODEC_CURSOR_STRUCT
+{
+    VT_UCHAR* buffer;
+    VT_ULONG size;
+    VT_ULONG position;
+    VT_BOOL error;
+} VT_CODEC_CURSOR;
+
+VT_UINT codec_crc16(VT_UCHAR* buffer, VT_ULONG size);
+
+VT_VOID codec_encode_begin(VT_CODEC_CURSOR* cursor, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_UINT8 kind);
+
+VT_VOID codec_encode_u8(VT_CODEC_CURSOR* cursor, VT_UINT8 value);
+
+VT_VOID codec_encode_u32(VT_CODEC_CURSOR* cursor, VT_ULONG value);
+
+VT_VOID codec_encode_fixed(VT_CODEC_CURSOR* cursor, VT_FLOAT value);
+
+VT_UINT codec_encode_end(VT_CODEC_CURSOR* cursor, VT_ULONG* encoded_size);
+
+VT_UINT codec_decode_begin(VT_CODEC_CURSOR* cursor, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_UINT8 kind);
+
+VT_UINT8 codec_decode_u8(VT_CODEC_CURSOR* cursor);
+
+VT_ULONG codec_decode_u32(VT_CODEC_CURSOR* cursor);
+
+VT_FLOAT codec_decode_fixed(VT_CODEC_CURSOR* cursor);
+
+VT_UINT codec_decode_end(VT_CODEC_CURSOR* cursor);
+
+#endif
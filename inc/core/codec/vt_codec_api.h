@@ -0,0 +1,90 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+/** @file */
+
+#ifndef _VT_CODEC_API_H
+#define _VT_CODEC_API_H
+
+#include "vt_cs_api.h"
+#include "vt_defs.h"
+#include "vt_fc_api.h"
+
+/* Binary template: version, kind and payload length header, little-endian payload with every float as signed Q16.16
+   fixed point, CRC-16/CCITT of header and payload as trailer */
+
+/* A full template encodes to 96 bytes instead of the 260 of the flattened strings for currentsense, 68 instead of 160 for
+   fallcurve. The gain is template size, a round trip through the bitwise CRC is slower than the vt_codec_csv strings */
+#define VT_CODEC_VERSION                       0x01
+#define VT_CODEC_KIND_FALLCURVE                0x01
+#define VT_CODEC_KIND_CURRENTSENSE             0x02
+#define VT_CODEC_KIND_CURRENTSENSE_CALIBRATION 0x03
+#define VT_CODEC_HEADER_SIZE                   4
+#define VT_CODEC_CRC_SIZE                      2
+
+/* Fallcurve payload flags, rise curve fields follow the fall curve of every signature when set. The shape fit the template
+   was scored with sits above it, templates encoded before it was carried read as VT_FC_SHAPE_FIT_PEARSON */
+#define VT_CODEC_FALLCURVE_FLAG_RISE_CURVE      0x01
+#define VT_CODEC_FALLCURVE_FLAG_SHAPE_FIT_MASK  0x06
+#define VT_CODEC_FALLCURVE_FLAG_SHAPE_FIT_SHIFT 1
+
+/* Largest encoded templates, a fallcurve signature is at most 5 fields and a repeating currentsense signature 4 */
+#define VT_CODEC_FALLCURVE_MAX_SIZE (VT_CODEC_HEADER_SIZE + 2 + (VT_FC_MAX_SIGNATURES * 5 * 4) + VT_CODEC_CRC_SIZE)
+#define VT_CODEC_CURRENTSENSE_MAX_SIZE (VT_CODEC_HEADER_SIZE + 2 + (2 * 4) + (VT_CS_MAX_SIGNATURES * 4 * 4) + VT_CODEC_CRC_SIZE)
+
+/* Calibration record of a currentsense template: tolerances, pre-check bounds and the adaptation baseline template */
+#define VT_CODEC_CURRENTSENSE_CALIBRATION_MAX_SIZE (VT_CODEC_CURRENTSENSE_MAX_SIZE + ((VT_CS_MAX_SIGNATURES + 2) * 4) + (8 * 4))
+
+/* Fractional digits of the numbers in flattened string templates */
+#define VT_CODEC_CSV_DECIMALS 4
+
+/* Characters needed for the base64 text of size bytes, including the terminating null */
+#define VT_CODEC_BASE64_SIZE(size) ((((size) + 2) / 3) * 4 + 1)
+
+// Encode a fallcurve template into buffer, encoded_size receives the bytes written
+VT_UINT vt_codec_fallcurve_database_encode(
+    VT_FALLCURVE_DATABASE* database, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* encoded_size);
+
+// Decode a fallcurve template, database is left untouched unless version, kind, length and CRC all check out
+VT_UINT vt_codec_fallcurve_database_decode(VT_FALLCURVE_DATABASE* database, VT_UCHAR* buffer, VT_ULONG buffer_size);
+
+// Encode a currentsense template into buffer, encoded_size receives the bytes written
+VT_UINT vt_codec_currentsense_database_encode(
+    VT_CURRENTSENSE_DATABASE* database, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* encoded_size);
+
+// Decode a currentsense template, database is left untouched unless version, kind, length and CRC all check out
+VT_UINT vt_codec_currentsense_database_decode(VT_CURRENTSENSE_DATABASE* database, VT_UCHAR* buffer, VT_ULONG buffer_size);
+
+// Encode what calibration learnt beside the currentsense template: tolerances, pre-check bounds and adaptation baseline
+VT_UINT vt_codec_currentsense_calibration_encode(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* encoded_size);
+
+// Decode a calibration record into cs_object, which is left untouched unless version, kind, length and CRC all check out
+VT_UINT vt_codec_currentsense_calibration_decode(VT_CURRENTSENSE_OBJECT* cs_object, VT_UCHAR* buffer, VT_ULONG buffer_size);
+
+// Size of the binary record at the start of buffer, header and CRC included, without checking its CRC
+VT_UINT vt_codec_encoded_size(VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* encoded_size);
+
+// Wrap an encoded template as null terminated base64 text for twin transport
+VT_UINT vt_codec_base64_encode(VT_UCHAR* buffer, VT_ULONG buffer_size, VT_CHAR* text, VT_ULONG text_size);
+
+// Unwrap null terminated base64 text, decoded_size receives the bytes written
+VT_UINT vt_codec_base64_decode(VT_CHAR* text, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* decoded_size);
+
+// Append value with decimals fractional digits to the null terminated text of text_length characters, after a comma
+// unless text is empty, text is left as it was if the number does not fit or value * 10^decimals reaches 1.8e19
+VT_UINT vt_codec_csv_append_fixed(
+    VT_CHAR* text, VT_ULONG text_size, VT_ULONG* text_length, VT_FLOAT value, VT_UINT decimals);
+
+// Append value zero padded to min_digits digits, after a comma unless text is empty
+VT_UINT vt_codec_csv_append_unsigned(
+    VT_CHAR* text, VT_ULONG text_size, VT_ULONG* text_length, VT_ULONG value, VT_UINT min_digits);
+
+// Parse the number at position in comma separated text of at most text_size characters and move position past its comma,
+// fails at the end of text or on anything but an optionally signed decimal number
+VT_UINT vt_codec_csv_parse_float(VT_CHAR* text, VT_ULONG text_size, VT_ULONG* position, VT_FLOAT* value);
+
+// Parse an unsigned integer the same way, without the float rounding of large values
+VT_UINT vt_codec_csv_parse_unsigned(VT_CHAR* text, VT_ULONG text_size, VT_ULONG* position, VT_ULONG* value);
+
+#endif
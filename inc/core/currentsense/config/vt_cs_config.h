@@ -5,7 +5,9 @@
 #define _VT_CONFIG_CS_H
 
 #define VT_CS_MAX_SIGNATURES 5
+/* Largest sample length a per-object plan may use, sizes every raw signature buffer */
 #define VT_CS_SAMPLE_LENGTH 128
+#define VT_CS_MIN_SAMPLE_LENGTH 16
 #define VT_CS_FFT_LENGTH VT_CS_SAMPLE_LENGTH/2
 #define VT_CS_FMIN 0.1f
 #define VT_CS_ADC_MAX_SAMPLING_FREQ 5000
@@ -17,13 +19,50 @@
    #define VT_CS_MAX_TEST_FREQUENCIES VT_CS_MAX_SIGNATURES
 #endif
 #define VT_CS_MAX_HARMONICS_REMOVAL 6
+/* Calibration reads one raw signature buffer per range */
+#define VT_CS_MAX_CALIBRATION_RANGES VT_CS_MAX_SIGNATURES
+/* Autocorrelation lag of the plan made at initialize, vt_currentsense_object_plan_create() takes its own and never scales it */
 #define VT_CS_AUTO_CORRELATION_LAG 32
 #define VT_CS_MIN_CORRELATION 0.4f
 #define VT_CS_CALIB_MINIMUM_CYCLES 4
+/* Suggested captures for vt_currentsense_object_sensor_calibrate_multi_capture() */
 #define VT_CS_AVG_SIGNATURE_REPEATABILITY_TEST 3
 #define VT_CS_MAX_AVG_CURR_DRIFT 50
 #define VT_CS_MAX_SIGNATURE_DRIFT 50
+/* Calibrated tolerances are VT_CS_CALIB_TOLERANCE_SIGMA standard deviations, never tighter than these floors */
+#define VT_CS_CALIB_TOLERANCE_SIGMA 3
+#define VT_CS_MIN_AVG_CURR_DRIFT 10
+#define VT_CS_MIN_SIGNATURE_DRIFT 10
+/* Template adaptation: EWMA weight of the newest matching evaluation, largest drift (%) an evaluation may show to be
+ * folded in, largest drift (%) the adapted template may reach from its calibrated baseline, and change of that drift (%)
+ * before the adapted template is reported again */
+#define VT_CS_ADAPTATION_ALPHA 0.1f
+#define VT_CS_ADAPTATION_MAX_DRIFT 10
+#define VT_CS_ADAPTATION_MAX_CUMULATIVE_DRIFT 25
+#define VT_CS_ADAPTATION_REPORT_DRIFT 1
+/* Tier-0 pre-check: a capture whose mean, standard deviation and on ratio stay within the calibrated range widened by
+ * VT_CS_PRECHECK_TOLERANCE (%), and VT_CS_PRECHECK_ON_RATIO_TOLERANCE for the ratio, matches without feature extraction.
+ * A mean more than VT_CS_PRECHECK_REJECT_DRIFT (%) away from calibration does not match, anything else runs the full check */
+#define VT_CS_PRECHECK_TOLERANCE 10
+#define VT_CS_PRECHECK_ON_RATIO_TOLERANCE 0.05f
+#define VT_CS_PRECHECK_REJECT_DRIFT 90
+/* Confidence (%) of a provisional template built from every calibration range, scaled down by the ranges still pending */
+#define VT_CS_PROVISIONAL_TEMPLATE_CONFIDENCE 40
 #define VT_CS_NON_REPEATING_SIGNATURE 0x01
 #define VT_CS_REPEATING_SIGNATURE 0x02
+#define VT_CS_BUFFER_POOL_MAX_OBJECTS 4
+
+/* Scratch arena (bytes) holding currentsense temporaries, sized for the deepest call path which is repeating signature
+ * calibration: extrapolated raw signature (VT_CS_SAMPLE_LENGTH floats) + FFT input (VT_CS_SAMPLE_LENGTH complex) + two
+ * spectograms of VT_CS_MAX_TEST_FREQUENCIES entries, plus alignment padding. Feature extraction needs at most
+ * VT_CS_SAMPLE_LENGTH floats and flags on top of the raw signature, which is always smaller. */
+#define VT_CS_ARENA_SIZE                                                                                                         \
+    ((VT_CS_SAMPLE_LENGTH * sizeof(float)) + (VT_CS_SAMPLE_LENGTH * 2 * sizeof(float)) +                                        \
+        (2 * VT_CS_MAX_TEST_FREQUENCIES * 2 * sizeof(float)) + 64)
+
+/* The FFT twiddle table covers transforms of up to 256 points */
+#if VT_CS_SAMPLE_LENGTH > 256
+   #error "VT_CS_SAMPLE_LENGTH must not exceed 256"
+#endif
 
 #endif
@@ -0,0 +1,16 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#ifndef _VT_CS_ARENA_H
+#define _VT_CS_ARENA_H
+
+#include "vt_cs_api.h"
+#include "vt_defs.h"
+
+VT_VOID* cs_arena_alloc(VT_CURRENTSENSE_SCRATCH_ARENA* arena, VT_ULONG size);
+
+VT_ULONG cs_arena_mark(VT_CURRENTSENSE_SCRATCH_ARENA* arena);
+
+VT_VOID cs_arena_release(VT_CURRENTSENSE_SCRATCH_ARENA* arena, VT_ULONG mark);
+
+#endif
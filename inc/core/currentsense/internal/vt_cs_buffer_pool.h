@@ -0,0 +1,19 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#ifndef _VT_CS_BUFFER_POOL_H
+#define _VT_CS_BUFFER_POOL_H
+
+#include "vt_cs_api.h"
+#include "vt_defs.h"
+
+VT_UINT cs_raw_signatures_reader_assign(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_CHAR* raw_signatures_buffer, VT_ULONG raw_signatures_buffer_size);
+
+VT_UINT cs_raw_signatures_required_repeating_buffers(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_UINT cs_buffer_pool_register(VT_CURRENTSENSE_BUFFER_POOL* buffer_pool, VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_UINT cs_buffer_pool_repack(VT_CURRENTSENSE_BUFFER_POOL* buffer_pool);
+
+#endif
@@ -15,8 +15,18 @@ VT_VOID cs_calibrate_repeating_signatures_compute_sampling_frequencies(VT_CURREN
 VT_VOID cs_calibrate_repeating_signatures_compute_collection_settings(
     VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* top_N_sample_frequencies, VT_FLOAT* lowest_sample_freq);
 
-VT_VOID cs_calibrate_sensor(VT_CURRENTSENSE_OBJECT* cs_object);
+VT_UINT cs_calibrate_sensor(VT_CURRENTSENSE_OBJECT* cs_object);
 
-VT_VOID cs_recalibrate_sensor(VT_CURRENTSENSE_OBJECT* cs_object);
+VT_UINT cs_recalibrate_sensor(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_UINT cs_calibrate_sensor_partial(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_VOID cs_calibration_statistics_reset(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_UINT cs_calibration_statistics_repeating_accumulate(VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* raw_signature);
+
+VT_UINT cs_calibration_statistics_non_repeating_accumulate(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_VOID cs_calibration_statistics_finalize(VT_CURRENTSENSE_OBJECT* cs_object);
 
 #endif
\ No newline at end of file
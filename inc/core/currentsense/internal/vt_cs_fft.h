@@ -37,6 +37,8 @@ VT_VOID cs_fft_complex_to_magnitude(COMPLEX* Y, VT_UINT N);
 VT_VOID cs_fft_normalize(COMPLEX* Y, VT_UINT N);
 VT_VOID cs_fft_dc_removal(COMPLEX* Y, VT_UINT N);
 VT_VOID cs_fft_windowing(COMPLEX* Y, VT_UINT N, VT_UINT8 windowType, VT_UINT8 dir);
+VT_VOID cs_fft_window_weights_compute(VT_FLOAT* weights, VT_UINT N, VT_UINT8 windowType);
+VT_VOID cs_fft_windowing_precomputed(COMPLEX* Y, VT_UINT N, const VT_FLOAT* weights, VT_UINT8 dir);
 VT_VOID cs_fft_major_peak(COMPLEX* Y, VT_UINT N, VT_FLOAT sampling_freq, VT_FLOAT* f, VT_FLOAT* v, VT_INT* index);
 
 #endif
@@ -0,0 +1,14 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#ifndef _VT_CS_PLAN_H
+#define _VT_CS_PLAN_H
+
+#include "vt_cs_api.h"
+#include "vt_defs.h"
+
+VT_UINT cs_plan_create(VT_CURRENTSENSE_PLAN* plan, VT_UINT sample_length, VT_UINT auto_correlation_lag);
+
+VT_VOID cs_plan_dump(const VT_CURRENTSENSE_PLAN* plan);
+
+#endif
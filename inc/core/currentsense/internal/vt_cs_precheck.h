@@ -0,0 +1,22 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#ifndef _VT_CS_PRECHECK_H
+#define _VT_CS_PRECHECK_H
+
+#include "vt_cs_api.h"
+#include "vt_defs.h"
+
+VT_VOID cs_precheck_bounds_reset(VT_CURRENTSENSE_PRECHECK_BOUNDS* bounds);
+
+VT_VOID cs_precheck_statistics_reset(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_VOID cs_precheck_statistics_accumulate(VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* adc_samples, VT_UINT num_samples);
+
+VT_VOID cs_precheck_calibration_accumulate(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_VOID cs_precheck_calibration_finalize(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_UINT cs_precheck_sensor_status(VT_CURRENTSENSE_OBJECT* cs_object);
+
+#endif
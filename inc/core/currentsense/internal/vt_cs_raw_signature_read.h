@@ -7,22 +7,32 @@
 #include "vt_cs_api.h"
 #include "vt_defs.h"
 
+/* Read-only view into a raw signature buffer owned by the raw signatures reader */
+typedef struct VT_CURRENTSENSE_RAW_SIGNATURE_VIEW_STRUCT
+{
+    const VT_FLOAT* current_measured;
+    VT_UINT sample_length;
+    VT_FLOAT sampling_frequency;
+} VT_CURRENTSENSE_RAW_SIGNATURE_VIEW;
+
 VT_UINT cs_raw_signature_read(VT_CURRENTSENSE_OBJECT* cs_object,
     VT_FLOAT* repeating_signature_sampling_frequencies,
     VT_UINT num_repeating_signature_sampling_frequencies,
     VT_UINT sample_length);
 
-VT_UINT cs_repeating_raw_signature_fetch_stored_current_measurement(
-    VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* repeating_raw_signature, VT_FLOAT sampling_frequency, VT_UINT sample_length);
+VT_BOOL cs_repeating_raw_signature_buffer_filled(VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT slot, VT_FLOAT sampling_frequency);
+
+VT_UINT cs_repeating_raw_signature_view(VT_CURRENTSENSE_OBJECT* cs_object,
+    VT_UINT slot,
+    VT_FLOAT sampling_frequency,
+    VT_CURRENTSENSE_RAW_SIGNATURE_VIEW* raw_signature_view);
 
 VT_UINT cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_calibration(VT_CURRENTSENSE_OBJECT* cs_object,
     VT_FLOAT* extrapolated_repeating_raw_signature,
     VT_FLOAT desired_sampling_frequency,
     VT_UINT desired_sample_length);
 
-VT_UINT cs_non_repeating_raw_signature_fetch_stored_current_measurement(VT_CURRENTSENSE_OBJECT* cs_object,
-    VT_FLOAT* non_repeating_raw_signature,
-    VT_FLOAT* sampling_frequency,
-    VT_UINT* num_datapoints);
+VT_UINT cs_non_repeating_raw_signature_view(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_CURRENTSENSE_RAW_SIGNATURE_VIEW* raw_signature_view);
 
 #endif
@@ -9,4 +9,8 @@
 
 VT_VOID cs_sensor_status(VT_CURRENTSENSE_OBJECT* cs_object);
 
+VT_UINT cs_sensor_status_partial(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_UINT cs_sensor_status_provisional(VT_CURRENTSENSE_OBJECT* cs_object, VT_BOOL evaluate_filled_only);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,19 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#ifndef _VT_CS_TEMPLATE_ADAPT_H
+#define _VT_CS_TEMPLATE_ADAPT_H
+
+#include "vt_cs_api.h"
+#include "vt_defs.h"
+
+VT_VOID cs_template_adaptation_baseline_set(VT_CURRENTSENSE_OBJECT* cs_object);
+
+// Keep the baseline for a template adapted from it and return VT_SUCCESS, otherwise make the template the baseline
+VT_UINT cs_template_adaptation_template_synced(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_VOID cs_template_adapt_repeating_signatures(VT_CURRENTSENSE_OBJECT* cs_object);
+
+VT_VOID cs_template_adapt_non_repeating_signature(VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT avg_curr_on, VT_FLOAT avg_curr_off);
+
+#endif
@@ -17,32 +17,104 @@ typedef struct VT_CURRENTSENSE_RAW_SIGNATURE_BUFFER_STRUCT
     VT_FLOAT current_measured[VT_CS_SAMPLE_LENGTH];
 } VT_CURRENTSENSE_RAW_SIGNATURE_BUFFER;
 
+typedef struct VT_CURRENTSENSE_REPEATING_SIGNATURE_FEATURE_VECTOR_STRUCT
+{
+    VT_FLOAT sampling_freq;
+    VT_FLOAT signature_freq;
+    VT_FLOAT relative_curr_draw;
+    VT_FLOAT duty_cycle;
+} VT_CURRENTSENSE_REPEATING_SIGNATURE_FEATURE_VECTOR;
+
+typedef struct VT_CURRENTSENSE_SCRATCH_ARENA_STRUCT
+{
+    VT_ULONG used;
+    VT_ULONG peak;
+    VT_ULONG memory[(VT_CS_ARENA_SIZE + sizeof(VT_ULONG) - 1) / sizeof(VT_ULONG)];
+} VT_CURRENTSENSE_SCRATCH_ARENA;
+
+/* Running statistics of the raw current, merged one half ADC buffer at a time while capturing */
+typedef struct VT_CURRENTSENSE_PRECHECK_STATISTICS_STRUCT
+{
+    VT_ULONG count;
+    VT_FLOAT mean;
+    VT_FLOAT m2;
+    VT_ULONG num_on;
+    VT_FLOAT on_threshold;
+} VT_CURRENTSENSE_PRECHECK_STATISTICS;
+
 typedef struct VT_CURRENTSENSE_RAW_SIGNATURES_READER_STRUCT
 {
-    VT_CURRENTSENSE_RAW_SIGNATURE_BUFFER repeating_raw_signatures[VT_CS_MAX_SIGNATURES];
     VT_CURRENTSENSE_RAW_SIGNATURE_BUFFER non_repeating_raw_signature;
     VT_UINT num_repeating_raw_signatures;
+    VT_UINT repeating_raw_signatures_capacity;
     VT_FLOAT adc_read_buffer[VT_CS_SAMPLE_LENGTH];
     VT_FLOAT adc_read_sampling_frequency;
     VT_BOOL repeating_raw_signature_ongoing_collection;
     VT_BOOL repeating_raw_signature_buffers_filled;
     VT_BOOL non_repeating_raw_signature_stop_collection;
+
+    /* Incremental evaluation of repeating signatures whose buffers have filled */
+    VT_UINT repeating_signatures_evaluated_mask;
+    VT_UINT num_repeating_signatures_evaluated;
+    VT_FLOAT repeating_signatures_drift_sum;
+    VT_FLOAT repeating_signatures_tolerance_sum;
+    VT_BOOL repeating_signatures_compute_fail;
+
+    /* Features measured by the latest evaluation, folded into the template by adaptation */
+    VT_UINT repeating_signatures_computed_mask;
+    VT_CURRENTSENSE_REPEATING_SIGNATURE_FEATURE_VECTOR repeating_signatures_under_test[VT_CS_MAX_SIGNATURES];
+    VT_FLOAT offset_current_under_test;
+
+    /* Calibration ranges already folded into the provisional template */
+    VT_UINT calibration_ranges_processed;
+
+    /* Statistics of every sample read, checked by the tier-0 pre-check before feature extraction */
+    VT_CURRENTSENSE_PRECHECK_STATISTICS precheck_statistics;
+
+    /* Scratch memory for signature processing temporaries */
+    VT_CURRENTSENSE_SCRATCH_ARENA scratch_arena;
+
+    /* Repeating raw signature buffers, sized by the memory handed to the reader */
+    VT_CURRENTSENSE_RAW_SIGNATURE_BUFFER repeating_raw_signatures[];
 } VT_CURRENTSENSE_RAW_SIGNATURES_READER;
 
+/* Bytes needed by a raw signatures reader holding num_repeating_signatures repeating buffers */
+#define VT_CS_RAW_SIGNATURES_BUFFER_SIZE(num_repeating_signatures)                                                              \
+    (sizeof(VT_CURRENTSENSE_RAW_SIGNATURES_READER) +                                                                            \
+        ((num_repeating_signatures) * sizeof(VT_CURRENTSENSE_RAW_SIGNATURE_BUFFER)))
+#define VT_CS_RAW_SIGNATURES_BUFFER_MAX_SIZE VT_CS_RAW_SIGNATURES_BUFFER_SIZE(VT_CS_MAX_SIGNATURES)
+
+typedef struct VT_CURRENTSENSE_CALIBRATION_RANGE_STRUCT
+{
+    VT_FLOAT sampling_freq;
+
+    /* FFT bin width, harmonics of order k are merged when within k bins of the exact multiple */
+    VT_FLOAT bin_width;
+} VT_CURRENTSENSE_CALIBRATION_RANGE;
+
+typedef struct VT_CURRENTSENSE_PLAN_STRUCT
+{
+    VT_UINT sample_length;
+    VT_UINT fft_length;
+    VT_UINT auto_correlation_lag;
+
+    /* First half of the symmetric Hamming window over sample_length points */
+    VT_FLOAT hamming_window[VT_CS_SAMPLE_LENGTH / 2];
+
+    /* Calibration ranges from VT_CS_ADC_MAX_SAMPLING_FREQ down to the range resolving VT_CS_FMIN */
+    VT_UINT num_calibration_ranges;
+    VT_CURRENTSENSE_CALIBRATION_RANGE calibration_ranges[VT_CS_MAX_CALIBRATION_RANGES];
+
+    /* Raw signature sampling frequency per Hz of signature frequency, fits VT_CS_CALIB_MINIMUM_CYCLES periods */
+    VT_FLOAT signature_sampling_factor;
+} VT_CURRENTSENSE_PLAN;
+
 typedef struct VT_CURRENTSENSE_NON_REPEATING_SIGNATURE_TEMPLATE_STRUCT
 {
     VT_FLOAT avg_curr_on;
     VT_FLOAT avg_curr_off;
 } VT_CURRENTSENSE_NON_REPEATING_SIGNATURE_TEMPLATE;
 
-typedef struct VT_CURRENTSENSE_REPEATING_SIGNATURE_FEATURE_VECTOR_STRUCT
-{
-    VT_FLOAT sampling_freq;
-    VT_FLOAT signature_freq;
-    VT_FLOAT relative_curr_draw;
-    VT_FLOAT duty_cycle;
-} VT_CURRENTSENSE_REPEATING_SIGNATURE_FEATURE_VECTOR;
-
 typedef struct VT_CURRENTSENSE_REPEATING_SIGNATURES_TEMPLATE_STRUCT
 {
     VT_UINT num_signatures;
@@ -66,20 +138,105 @@ typedef struct VT_CURRENTSENSE_DATABASE_STRUCT
     union VT_CURRENTSENSE_SIGNATURES_TEMPLATE template;
 } VT_CURRENTSENSE_DATABASE;
 
+/* Running mean and sum of squared deviations of one feature, updated with Welford's method */
+typedef struct VT_CURRENTSENSE_FEATURE_STATISTICS_STRUCT
+{
+    VT_UINT count;
+    VT_FLOAT mean;
+    VT_FLOAT m2;
+} VT_CURRENTSENSE_FEATURE_STATISTICS;
+
+/* Range of capture statistics seen during calibration, samples above on_threshold count as the sensor being on */
+typedef struct VT_CURRENTSENSE_PRECHECK_BOUNDS_STRUCT
+{
+    VT_UINT num_captures;
+    VT_FLOAT on_threshold;
+    VT_FLOAT mean_min;
+    VT_FLOAT mean_max;
+    VT_FLOAT deviation_min;
+    VT_FLOAT deviation_max;
+    VT_FLOAT on_ratio_min;
+    VT_FLOAT on_ratio_max;
+} VT_CURRENTSENSE_PRECHECK_BOUNDS;
+
+typedef struct VT_CURRENTSENSE_CALIBRATION_STRUCT
+{
+    VT_UINT num_captures_required;
+    VT_UINT num_captures;
+
+    /* Repeating signature features per template slot */
+    VT_CURRENTSENSE_FEATURE_STATISTICS signature_freq[VT_CS_MAX_SIGNATURES];
+    VT_CURRENTSENSE_FEATURE_STATISTICS relative_curr_draw[VT_CS_MAX_SIGNATURES];
+    VT_CURRENTSENSE_FEATURE_STATISTICS duty_cycle[VT_CS_MAX_SIGNATURES];
+    VT_CURRENTSENSE_FEATURE_STATISTICS offset_current;
+
+    /* Non-repeating signature features */
+    VT_CURRENTSENSE_FEATURE_STATISTICS avg_curr_on;
+    VT_CURRENTSENSE_FEATURE_STATISTICS avg_curr_off;
+
+    /* Pre-check bounds, the first capture only sets the on threshold used by the ratio of later ones */
+    VT_CURRENTSENSE_PRECHECK_BOUNDS precheck;
+} VT_CURRENTSENSE_CALIBRATION;
+
+/* Allowed drift (%) per template feature, derived from the spread observed during calibration */
+typedef struct VT_CURRENTSENSE_TEMPLATE_TOLERANCE_STRUCT
+{
+    VT_FLOAT repeating_signature_drift[VT_CS_MAX_SIGNATURES];
+    VT_FLOAT offset_current_drift;
+    VT_FLOAT avg_curr_drift;
+} VT_CURRENTSENSE_TEMPLATE_TOLERANCE;
+
+/* Exponential averaging of matching evaluations into the template, bounded by the drift from the calibrated baseline */
+typedef struct VT_CURRENTSENSE_ADAPTATION_STRUCT
+{
+    VT_BOOL enabled;
+    VT_FLOAT alpha;
+    VT_UINT num_updates;
+    VT_UINT num_rejected;
+    VT_FLOAT cumulative_drift;
+    VT_FLOAT reported_drift;
+    VT_CURRENTSENSE_DATABASE baseline;
+} VT_CURRENTSENSE_ADAPTATION;
+
+/* Tier-0 check of capture statistics against calibrated bounds, counting how often each tier decided the status */
+typedef struct VT_CURRENTSENSE_PRECHECK_STRUCT
+{
+    VT_BOOL enabled;
+    VT_CURRENTSENSE_PRECHECK_BOUNDS bounds;
+    VT_ULONG num_tier0_matching;
+    VT_ULONG num_tier0_not_matching;
+    VT_ULONG num_full;
+} VT_CURRENTSENSE_PRECHECK;
+
 typedef struct VT_CURRENTSENSE_OBJECT_STRUCT
 {
     VT_SENSOR_HANDLE* sensor_handle;
     VT_CURRENTSENSE_DATABASE fingerprintdb;
+    VT_CURRENTSENSE_TEMPLATE_TOLERANCE template_tolerance;
+    VT_CURRENTSENSE_CALIBRATION calibration;
+    VT_CURRENTSENSE_ADAPTATION adaptation;
+    VT_CURRENTSENSE_PRECHECK precheck;
     VT_DEVICE_DRIVER* device_driver;
     VT_CURRENTSENSE_RAW_SIGNATURES_READER* raw_signatures_reader;
     VT_BOOL raw_signatures_reader_initialized;
+    struct VT_CURRENTSENSE_BUFFER_POOL_STRUCT* buffer_pool;
+    VT_CURRENTSENSE_PLAN plan;
     VT_UINT8 mode;
     VT_UINT8 sensor_status;
     VT_UINT8 sensor_drift;
+    VT_BOOL sensor_status_updated;
     VT_UINT8 template_confidence_metric;
     VT_UINT8 db_updated;
 } VT_CURRENTSENSE_OBJECT;
 
+typedef struct VT_CURRENTSENSE_BUFFER_POOL_STRUCT
+{
+    VT_CHAR* buffer;
+    VT_ULONG buffer_size;
+    VT_CURRENTSENSE_OBJECT* objects[VT_CS_BUFFER_POOL_MAX_OBJECTS];
+    VT_UINT num_objects;
+} VT_CURRENTSENSE_BUFFER_POOL;
+
 typedef struct VT_CURRENTSENSE_DATABASE_FLATTENED
 {
     VT_UCHAR template_type[VT_CHARACTERS_IN_A_NUMBER];
@@ -101,18 +258,67 @@ VT_UINT vt_currentsense_object_initialize(VT_CURRENTSENSE_OBJECT* cs_object,
     VT_CHAR* raw_signatures_buffer,
     VT_UINT raw_signatures_buffer_size);
 
-// Set mode to calibrate
+// Initialize a pool that hands out right-sized raw signature buffers to several objects
+VT_UINT vt_currentsense_buffer_pool_initialize(VT_CURRENTSENSE_BUFFER_POOL* buffer_pool, VT_CHAR* buffer, VT_ULONG buffer_size);
+
+// Initialize with raw signature buffer carved from a pool
+VT_UINT vt_currentsense_object_initialize_from_pool(VT_CURRENTSENSE_OBJECT* cs_object,
+    VT_DEVICE_DRIVER* device_driver,
+    VT_SENSOR_HANDLE* sensor_handle,
+    VT_CURRENTSENSE_BUFFER_POOL* buffer_pool);
+
+// Create the processing plan used for this object, sample_length must be a power of two up to VT_CS_SAMPLE_LENGTH and
+// auto_correlation_lag below it. A plan sets how much is read and processed, buffers stay sized for VT_CS_SAMPLE_LENGTH
+VT_UINT vt_currentsense_object_plan_create(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT sample_length, VT_UINT auto_correlation_lag);
+
+// Log the processing plan and its calibration range table
+VT_VOID vt_currentsense_object_plan_dump(VT_CURRENTSENSE_OBJECT* cs_object);
+
+// Bytes of raw signature buffer needed for the next read in the current mode and template
+VT_ULONG vt_currentsense_object_raw_signatures_buffer_size(VT_CURRENTSENSE_OBJECT* cs_object);
+
+// Set mode to calibrate from a single capture
 VT_VOID vt_currentsense_object_sensor_calibrate(VT_CURRENTSENSE_OBJECT* cs_object);
 
-// Set mode to re-calibrate
+// Set mode to re-calibrate from a single capture
 VT_VOID vt_currentsense_object_sensor_recalibrate(VT_CURRENTSENSE_OBJECT* cs_object);
 
+// Set mode to calibrate over num_captures read and process cycles, template keeps the mean of every capture and
+// tolerances follow their spread, VT_CS_AVG_SIGNATURE_REPEATABILITY_TEST is a suggested count
+VT_UINT vt_currentsense_object_sensor_calibrate_multi_capture(VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT num_captures);
+
+// Enable or disable folding matching evaluations into the template, alpha in (0, 1] weighs the newest evaluation
+VT_UINT vt_currentsense_object_adaptation_enable(VT_CURRENTSENSE_OBJECT* cs_object, VT_BOOL enable, VT_FLOAT alpha);
+
+// Fetch template adaptation state
+VT_VOID vt_currentsense_object_adaptation_fetch_status(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT* num_updates, VT_UINT* num_rejected, VT_FLOAT* cumulative_drift);
+
+// Enable or disable deciding clear matches and gross failures from capture statistics before feature extraction
+VT_VOID vt_currentsense_object_precheck_enable(VT_CURRENTSENSE_OBJECT* cs_object, VT_BOOL enable);
+
+// Fetch how many evaluations the pre-check decided and how many needed the full feature check
+VT_VOID vt_currentsense_object_precheck_fetch_status(VT_CURRENTSENSE_OBJECT* cs_object,
+    VT_ULONG* num_tier0_matching,
+    VT_ULONG* num_tier0_not_matching,
+    VT_ULONG* num_full);
+
 // Fetch Status
 VT_VOID vt_currentsense_object_sensor_fetch_status(
     VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT* sensor_status, VT_UINT* sensor_drift);
 
-// Start reading current signature
-VT_VOID vt_currentsense_object_signature_read(VT_CURRENTSENSE_OBJECT* cs_object);
+// Fetch Status if an evaluation updated it since the last call, returns VT_ERROR otherwise
+VT_UINT vt_currentsense_object_sensor_fetch_status_update(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT* sensor_status, VT_UINT* sensor_drift);
+
+// Start reading current signature, fails without starting it while a pooled object cannot get the buffers it needs
+VT_UINT vt_currentsense_object_signature_read(VT_CURRENTSENSE_OBJECT* cs_object);
+
+// Process signatures whose buffers have filled so far and update status, returns number of signatures or ranges still
+// being read. The first calibration capture publishes a provisional template from the ranges read so far, later
+// calibration captures and recalibration are checked against the template held so far
+VT_UINT vt_currentsense_object_signature_process_partial(VT_CURRENTSENSE_OBJECT* cs_object);
 
 // Stop reading current signature and process it
 VT_VOID vt_currentsense_object_signature_process(VT_CURRENTSENSE_OBJECT* cs_object);
@@ -120,6 +326,17 @@ VT_VOID vt_currentsense_object_signature_process(VT_CURRENTSENSE_OBJECT* cs_obje
 // Sync Database
 VT_VOID vt_currentsense_object_database_sync(VT_CURRENTSENSE_OBJECT* cs_object, VT_CURRENTSENSE_DATABASE_FLATTENED* flattened_db);
 
+// Sync Database from a binary template made by vt_codec_currentsense_database_encode, template is kept on error
+VT_UINT vt_currentsense_object_database_sync_binary(VT_CURRENTSENSE_OBJECT* cs_object, VT_UCHAR* buffer, VT_ULONG buffer_size);
+
+// Persist Database with its calibration record through the storage hooks of the device driver under key, a template
+// already stored unchanged is not written again
+VT_UINT vt_currentsense_object_database_store(VT_CURRENTSENSE_OBJECT* cs_object, VT_CHAR* key);
+
+// Restore Database stored under key along with its tolerances, pre-check bounds and adaptation baseline, template is kept
+// if nothing valid is stored
+VT_UINT vt_currentsense_object_database_load(VT_CURRENTSENSE_OBJECT* cs_object, VT_CHAR* key);
+
 // Fetch Database and template confidence
 VT_VOID vt_currentsense_object_database_fetch(VT_CURRENTSENSE_OBJECT* cs_object,
     VT_CURRENTSENSE_DATABASE_FLATTENED* flattened_db,
@@ -13,7 +13,25 @@
 #define VT_FC_MAX_FALLTIME_DEVIATION     20.0f
 #define VT_FC_MAX_SHAPE_DEVIATION_FACTOR 20.0f
 #define VT_FC_MAX_SHAPE_DEVIATION        ((1.0f - VT_FC_MIN_SHAPE_MATCH) / VT_FC_MIN_SHAPE_MATCH) * VT_FC_MAX_SHAPE_DEVIATION_FACTOR
+/* Largest sample length a per-object plan may use */
 #define VT_FC_SAMPLE_LENGTH              100
+#define VT_FC_MIN_SAMPLE_LENGTH          10
 #define VT_FC_MAX_SIGNATURES             5
+/* A capture ends early once a sample falls below this fraction of the peak and the last VT_FC_EARLY_STOP_FLAT_SAMPLES
+   samples lie within VT_FC_EARLY_STOP_FLAT_TOLERANCE ADC counts (or three noise deviations when oversampling) */
+#define VT_FC_EARLY_STOP_FRACTION        0.25f
+#define VT_FC_EARLY_STOP_FLAT_SAMPLES    4
+#define VT_FC_EARLY_STOP_FLAT_TOLERANCE  2
+/* Sensors vt_fallcurve_object_sensor_status_batch() can evaluate in one discharge window. Samples are read into each
+   object's scratch, the batch itself needs about VT_FC_MAX_BATCH_SENSORS * 200 bytes of stack for capture bookkeeping */
+#define VT_FC_MAX_BATCH_SENSORS          4
+/* Samples of the caller-owned buffer passed to vt_fallcurve_object_rise_curve_enable(), one rise curve per template */
+#define VT_FC_RISE_CURVE_BUFFER_LENGTH   (VT_FC_MAX_SIGNATURES * VT_FC_SAMPLE_LENGTH)
+/* Samples kept from the single full-rate discharge captured during calibration. Captures, DMA processing and calibration
+   work in a scratch inside each VT_FALLCURVE_OBJECT rather than on the stack, it takes the larger of
+   VT_FC_MAX_SIGNATURES * (VT_FC_SAMPLE_LENGTH + 2) VT_UINTs plus VT_FC_MAX_SIGNATURES VT_ULONGs, and
+   VT_FC_SAMPLE_LENGTH + VT_FC_CALIBRATION_CAPTURE_LENGTH VT_UINTs plus VT_FC_CALIBRATION_CAPTURE_LENGTH VT_ULONGs,
+   about 1.4 KB per object with the defaults on 32-bit targets */
+#define VT_FC_CALIBRATION_CAPTURE_LENGTH (2 * VT_FC_SAMPLE_LENGTH)
 
 #endif
@@ -8,8 +8,12 @@
 
 VT_VOID fc_reset_db(VT_FALLCURVE_OBJECT* fc_object);
 
-VT_UINT fc_store_signature(
-    VT_FALLCURVE_OBJECT* fc_object, VT_ULONG sampling_interval_us, VT_ULONG falltime, VT_FLOAT pearson_coeff);
+VT_UINT fc_store_signature(VT_FALLCURVE_OBJECT* fc_object,
+    VT_ULONG sampling_interval_us,
+    VT_ULONG falltime,
+    VT_FLOAT pearson_coeff,
+    VT_ULONG risetime,
+    VT_FLOAT rise_pearson_coeff);
 
 VT_UINT fc_fetch_signature(VT_FALLCURVE_OBJECT* fc_object,
     VT_UINT signature_iter,
@@ -17,4 +21,9 @@ VT_UINT fc_fetch_signature(VT_FALLCURVE_OBJECT* fc_object,
     VT_ULONG* falltime,
     VT_FLOAT* pearson_coeff);
 
+VT_UINT fc_fetch_rise_signature(
+    VT_FALLCURVE_OBJECT* fc_object, VT_UINT signature_iter, VT_ULONG* risetime, VT_FLOAT* rise_pearson_coeff);
+
+VT_UINT fc_fetch_sampling_intervals(VT_FALLCURVE_OBJECT* fc_object, VT_ULONG* sampling_intervals_us, VT_UINT buffer_length);
+
 #endif
@@ -7,6 +7,70 @@
 #include "vt_defs.h"
 #include "vt_fc_api.h"
 
-VT_VOID fc_adc_read(VT_FALLCURVE_OBJECT* fc_object, VT_UINT* raw_signature, VT_ULONG sampling_interval_us, VT_UINT sample_length);
+/* Running mean of the reads within one sampling interval, with the co-moments against the read index needed to measure
+   their noise around the interval's linear trend instead of the decay itself */
+typedef struct FC_OVERSAMPLE_STRUCT
+{
+    VT_FLOAT mean;
+    VT_FLOAT m2;
+    VT_FLOAT index_mean;
+    VT_FLOAT index_m2;
+    VT_FLOAT co_moment;
+    VT_UINT count;
+} FC_OVERSAMPLE;
+
+typedef struct FC_VARIANCE_STRUCT
+{
+    VT_FLOAT sum;
+    VT_UINT count;
+} FC_VARIANCE;
+
+/* Polled capture of one sensor, the caller fills the fields up to rise_sampling_stretch and fc_adc_read() owns the rest.
+   Leave rise_signatures NULL to skip the rise curve captured while the sensor recharges. The sampling stretches, NULL when
+   not needed, receive how much wider each template's samples were spaced than when the sensor is read alone */
+typedef struct FC_ADC_CAPTURE_STRUCT
+{
+    VT_FALLCURVE_OBJECT* fc_object;
+    VT_UINT* raw_signatures;
+    const VT_ULONG* sampling_intervals_us;
+    VT_UINT num_signatures;
+    VT_UINT sample_length;
+    VT_UINT* samples_read;
+    VT_UINT* rise_signatures;
+    VT_UINT* rise_samples_read;
+    VT_FLOAT* sampling_stretch;
+    VT_FLOAT* rise_sampling_stretch;
+
+    VT_ULONG sampling_period_us[VT_FC_MAX_SIGNATURES];
+    VT_ULONG last_sample_time_us[VT_FC_MAX_SIGNATURES];
+    VT_UINT peak_value[VT_FC_MAX_SIGNATURES];
+    VT_BOOL signature_complete[VT_FC_MAX_SIGNATURES];
+    VT_UINT rise_reference[VT_FC_MAX_SIGNATURES];
+    FC_OVERSAMPLE oversample[VT_FC_MAX_SIGNATURES];
+    FC_VARIANCE variance;
+    VT_UINT signatures_complete;
+} FC_ADC_CAPTURE;
+
+// Power down every captured sensor together and sample their discharges round-robin within one interrupt blackout, the
+// optional recharge is sampled after it with interrupts enabled. The channel is selected again before every read that
+// follows the read of another sensor
+VT_VOID fc_adc_read(FC_ADC_CAPTURE* captures, VT_UINT num_captures);
+
+VT_VOID fc_adc_calibration_read(VT_FALLCURVE_OBJECT* fc_object,
+    VT_UINT* raw_signature,
+    VT_UINT sample_length,
+    VT_UINT* samples_read,
+    VT_UINT* rise_signature,
+    VT_UINT* rise_samples_read,
+    VT_ULONG* sampling_interval_us,
+    VT_ULONG* time_to_fall);
+
+VT_UINT fc_adc_buffer_read_start(VT_FALLCURVE_OBJECT* fc_object, VT_ULONG sampling_interval_us);
+
+VT_VOID fc_adc_buffer_decimate(VT_FALLCURVE_OBJECT* fc_object,
+    VT_UINT* raw_signatures,
+    const VT_ULONG* sampling_intervals_us,
+    VT_UINT num_signatures,
+    VT_UINT sample_length);
 
 #endif
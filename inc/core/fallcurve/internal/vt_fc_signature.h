@@ -6,13 +6,44 @@
 
 #include "vt_fc_api.h"
 
-VT_UINT fc_signature_compute(
-    VT_FALLCURVE_OBJECT* fc_object, VT_ULONG sampling_interval_us, VT_ULONG* falltime, VT_FLOAT* pearson_coeff);
+VT_UINT fc_signature_compute_from_raw(VT_FALLCURVE_OBJECT* fc_object,
+    VT_UINT* raw_signature,
+    VT_UINT sample_length,
+    VT_ULONG sampling_interval_us,
+    VT_ULONG* falltime,
+    VT_FLOAT* pearson_coeff);
 
 VT_UINT fc_signature_evaluate(
     VT_ULONG falltime_under_test, VT_ULONG falltime_saved, VT_FLOAT pearson_coeff_under_test, VT_FLOAT pearson_coeff_saved);
 
-VT_UINT fc_signature_compute_collection_settings(
-    VT_FALLCURVE_OBJECT* fc_object, VT_ULONG* sampling_interval_us, VT_UINT8* confidence_metric);
+// Integer only counterparts used by VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT, results are identical on every target
+VT_UINT fc_signature_compute_from_raw_fixed(
+    VT_UINT* raw_signature, VT_UINT sample_length, VT_ULONG sampling_interval_us, VT_ULONG* falltime, VT_FLOAT* pearson_coeff);
+
+VT_UINT fc_signature_evaluate_fixed(
+    VT_ULONG falltime_under_test, VT_ULONG falltime_saved, VT_FLOAT pearson_coeff_under_test, VT_FLOAT pearson_coeff_saved);
+
+// Evaluate raw_signatures, laid out one sample_length block per stored template holding samples_read samples each, against
+// those templates, rise_signatures is laid out alike or NULL when no rise curve was captured. Falltimes are scaled by the
+// sampling stretch of their template, NULL when the samples are spaced at the template intervals
+VT_VOID fc_signature_status_compute(VT_FALLCURVE_OBJECT* fc_object,
+    VT_UINT* raw_signatures,
+    const VT_UINT* samples_read,
+    VT_UINT* rise_signatures,
+    const VT_UINT* rise_samples_read,
+    const VT_FLOAT* sampling_stretch,
+    const VT_FLOAT* rise_sampling_stretch,
+    VT_UINT num_signatures,
+    VT_UINT* sensor_status,
+    VT_UINT* sensor_drift);
+
+// Collection settings and the signature sampled at them from a single discharge
+VT_UINT fc_signature_compute_collection_settings(VT_FALLCURVE_OBJECT* fc_object,
+    VT_ULONG* sampling_interval_us,
+    VT_ULONG* falltime,
+    VT_FLOAT* pearson_coeff,
+    VT_ULONG* risetime,
+    VT_FLOAT* rise_pearson_coeff,
+    VT_UINT8* confidence_metric);
 
 #endif
@@ -10,24 +10,95 @@
 #include "vt_fc_config.h"
 #include "vt_platform.h"
 
+/* Shape scores stored in the template pearson_coeff field, templates must be evaluated with the fit they were made with */
+#define VT_FC_SHAPE_FIT_PEARSON             0x00
+#define VT_FC_SHAPE_FIT_LOG_LINEAR          0x01
+#define VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT 0x02
+
+/* risetime and rise_pearson_coeff describe the recharge after the discharge, risetime is 0 for templates without one */
 typedef struct VT_FALLCURVE_TEMPLATE_SIGNATURE_STRUCT
 {
     VT_ULONG sampling_interval_us;
     VT_ULONG falltime;
     VT_FLOAT pearson_coeff;
+    VT_ULONG risetime;
+    VT_FLOAT rise_pearson_coeff;
 } VT_FALLCURVE_TEMPLATE_SIGNATURE;
 
+/* shape_fit is the VT_FC_SHAPE_FIT_* the pearson_coeff scores of every signature were computed with */
 typedef struct VT_FALLCURVE_DATABASE_STRUCT
 {
     VT_UINT num_signatures;
+    VT_UINT shape_fit;
     VT_FALLCURVE_TEMPLATE_SIGNATURE db[VT_FC_MAX_SIGNATURES];
 } VT_FALLCURVE_DATABASE;
 
+typedef struct VT_FALLCURVE_PLAN_STRUCT
+{
+    VT_UINT sample_length;
+    VT_ULONG max_capture_time_us;
+    VT_BOOL oversampling;
+    VT_FLOAT early_stop_fraction;
+    VT_UINT shape_fit;
+    VT_BOOL rise_curve;
+} VT_FALLCURVE_PLAN;
+
+/* Weighted least-squares fit of ln(v) against t from the peak to the 37% point, weights v^2 undo the log noise scaling */
+typedef struct VT_FALLCURVE_FIT_STRUCT
+{
+    VT_FLOAT tau_us;
+    VT_FLOAT r_squared;
+    VT_FLOAT residual_rms;
+    VT_UINT num_datapoints;
+} VT_FALLCURVE_FIT;
+
+/* Discharge sampled by the adc_buffer_read DMA hook at a fixed timer-triggered interval */
+typedef struct VT_FALLCURVE_DMA_CAPTURE_STRUCT
+{
+    VT_FLOAT* adc_read_buffer;
+    VT_UINT buffer_length;
+    VT_ULONG sampling_interval_us;
+    VT_BOOL ongoing_collection;
+    VT_BOOL collection_complete;
+} VT_FALLCURVE_DMA_CAPTURE;
+
+/* Buffers a polled capture is read into, kept in the object so batches do not need them on the stack */
+typedef struct VT_FALLCURVE_CAPTURE_SCRATCH_STRUCT
+{
+    VT_UINT raw_signatures[VT_FC_MAX_SIGNATURES * VT_FC_SAMPLE_LENGTH];
+    VT_ULONG sampling_intervals_us[VT_FC_MAX_SIGNATURES];
+    VT_UINT samples_read[VT_FC_MAX_SIGNATURES];
+    VT_UINT rise_samples_read[VT_FC_MAX_SIGNATURES];
+    VT_FLOAT sampling_stretch[VT_FC_MAX_SIGNATURES];
+    VT_FLOAT rise_sampling_stretch[VT_FC_MAX_SIGNATURES];
+} VT_FALLCURVE_CAPTURE_SCRATCH;
+
+/* Buffers of the full-rate calibration discharge and the signature decimated from it */
+typedef struct VT_FALLCURVE_CALIBRATION_SCRATCH_STRUCT
+{
+    VT_UINT raw_signature[VT_FC_SAMPLE_LENGTH];
+    VT_UINT capture_value[VT_FC_CALIBRATION_CAPTURE_LENGTH];
+    VT_ULONG capture_time_us[VT_FC_CALIBRATION_CAPTURE_LENGTH];
+} VT_FALLCURVE_CALIBRATION_SCRATCH;
+
+/* A capture and a calibration of one object never run at the same time, so they share its scratch */
+typedef union VT_FALLCURVE_SCRATCH_UNION {
+    VT_FALLCURVE_CAPTURE_SCRATCH capture;
+    VT_FALLCURVE_CALIBRATION_SCRATCH calibration;
+} VT_FALLCURVE_SCRATCH;
+
 typedef struct VT_FALLCURVE_OBJECT_STRUCT
 {
     VT_SENSOR_HANDLE* sensor_handle;
     VT_FALLCURVE_DATABASE fingerprintdb;
     VT_DEVICE_DRIVER* device_driver;
+    VT_FALLCURVE_PLAN plan;
+    VT_FALLCURVE_DMA_CAPTURE dma_capture;
+    VT_UINT* rise_buffer;
+    VT_FLOAT sample_variance;
+    VT_UINT samples_used;
+    VT_FALLCURVE_FIT fit;
+    VT_FALLCURVE_SCRATCH scratch;
 } VT_FALLCURVE_OBJECT;
 
 typedef struct VT_FALLCURVE_DATABASE_FLATTENED_STRUCT
@@ -42,6 +113,40 @@ typedef struct VT_FALLCURVE_DATABASE_FLATTENED_STRUCT
 VT_VOID vt_fallcurve_object_initialize(
     VT_FALLCURVE_OBJECT* fc_object, VT_DEVICE_DRIVER* device_driver, VT_SENSOR_HANDLE* sensor_handle);
 
+// Create the processing plan used for this object, sample_length must not exceed VT_FC_SAMPLE_LENGTH. A plan sets how much
+// is read and processed, buffers stay sized for VT_FC_SAMPLE_LENGTH
+VT_UINT vt_fallcurve_object_plan_create(VT_FALLCURVE_OBJECT* fc_object, VT_UINT sample_length);
+
+// Store the mean of every ADC read within a sampling interval instead of the last read, use the same setting for
+// calibration and status so templates and captures stay comparable
+VT_VOID vt_fallcurve_object_oversampling_enable(VT_FALLCURVE_OBJECT* fc_object, VT_BOOL enable);
+
+// Fetch the mean per-interval ADC read variance of the last oversampled capture, measured around the linear trend of each
+// interval so the discharge slope does not count as noise, 0 when not oversampling
+VT_VOID vt_fallcurve_object_oversampling_fetch_status(VT_FALLCURVE_OBJECT* fc_object, VT_FLOAT* sample_variance);
+
+// End captures once the curve falls below fraction of its peak and the tail is flat, 0 always captures sample_length
+VT_UINT vt_fallcurve_object_early_stop_set(VT_FALLCURVE_OBJECT* fc_object, VT_FLOAT fraction);
+
+// Fetch the number of samples the longest signature of the last polled capture needed
+VT_VOID vt_fallcurve_object_early_stop_fetch_status(VT_FALLCURVE_OBJECT* fc_object, VT_UINT* samples_used);
+
+// Fetch how long the last polled capture kept the sensor offline, estimated from the samples it used at the slowest template
+// interval and doubled when the rise curve is captured too
+VT_VOID vt_fallcurve_object_capture_time_fetch_status(VT_FALLCURVE_OBJECT* fc_object, VT_ULONG* capture_time_us);
+
+// Select VT_FC_SHAPE_FIT_PEARSON, VT_FC_SHAPE_FIT_LOG_LINEAR or VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT for falltime and shape,
+// recalibrate after switching
+VT_UINT vt_fallcurve_object_shape_fit_set(VT_FALLCURVE_OBJECT* fc_object, VT_UINT shape_fit);
+
+// Fetch the log-linear fit of the last signature computed with VT_FC_SHAPE_FIT_LOG_LINEAR
+VT_VOID vt_fallcurve_object_shape_fit_fetch_status(VT_FALLCURVE_OBJECT* fc_object, VT_FALLCURVE_FIT* fit);
+
+// Also fingerprint the recharge that follows every polled discharge into rise_buffer of VT_FC_RISE_CURVE_BUFFER_LENGTH samples,
+// NULL disables it. Templates calibrated with it must then match on both curves, recalibrate after enabling. The recharge is
+// sampled with interrupts enabled, so the interrupt blackout of a capture stays that of the discharge alone
+VT_UINT vt_fallcurve_object_rise_curve_enable(VT_FALLCURVE_OBJECT* fc_object, VT_UINT* rise_buffer, VT_UINT rise_buffer_length);
+
 // Calibrate
 VT_UINT vt_fallcurve_object_sensor_calibrate(VT_FALLCURVE_OBJECT* fc_object, VT_UINT8* confidence_metric);
 
@@ -51,9 +156,36 @@ VT_UINT vt_fallcurve_object_sensor_recalibrate(VT_FALLCURVE_OBJECT* fc_object, V
 // Status
 VT_VOID vt_fallcurve_object_sensor_status(VT_FALLCURVE_OBJECT* fc_object, VT_UINT* sensor_status, VT_UINT* sensor_drift);
 
+// Status of up to VT_FC_MAX_BATCH_SENSORS sensors from one shared discharge window, their channels are read round-robin and
+// the first object's device driver times the window, sensor_status and sensor_drift hold one entry per object. Each channel
+// is selected again before its reads, and falltimes follow the sample spacing the round-robin reads actually achieved
+VT_UINT vt_fallcurve_object_sensor_status_batch(
+    VT_FALLCURVE_OBJECT** fc_objects, VT_UINT num_objects, VT_UINT* sensor_status, VT_UINT* sensor_drift);
+
+// Assign the buffer the DMA capture path samples into, buffer_length bounds how finely the slowest template is resolved
+VT_UINT vt_fallcurve_object_dma_buffer_assign(VT_FALLCURVE_OBJECT* fc_object, VT_FLOAT* adc_read_buffer, VT_UINT buffer_length);
+
+// Start a timer-triggered DMA capture of one discharge, interrupts stay enabled while the curve is sampled, fails while
+// the DMA capture of any fallcurve object is ongoing
+VT_UINT vt_fallcurve_object_signature_read(VT_FALLCURVE_OBJECT* fc_object);
+
+// Evaluate the DMA capture against every template, returns VT_ERROR while the capture has not completed
+VT_UINT vt_fallcurve_object_signature_process(VT_FALLCURVE_OBJECT* fc_object, VT_UINT* sensor_status, VT_UINT* sensor_drift);
+
 // Sync Database
 VT_VOID vt_fallcurve_object_database_sync(VT_FALLCURVE_OBJECT* fc_object, VT_FALLCURVE_DATABASE_FLATTENED* flattened_db);
 
+// Sync Database from a binary template made by vt_codec_fallcurve_database_encode, rise curves included. Templates scored
+// with another shape fit than the one in use are rejected and the template kept
+VT_UINT vt_fallcurve_object_database_sync_binary(VT_FALLCURVE_OBJECT* fc_object, VT_UCHAR* buffer, VT_ULONG buffer_size);
+
+// Persist Database through the storage hooks of the device driver under key, a template already stored unchanged is not
+// written again
+VT_UINT vt_fallcurve_object_database_store(VT_FALLCURVE_OBJECT* fc_object, VT_CHAR* key);
+
+// Restore Database stored under key, template is kept if nothing valid is stored
+VT_UINT vt_fallcurve_object_database_load(VT_FALLCURVE_OBJECT* fc_object, VT_CHAR* key);
+
 // Fetch Database
 VT_VOID vt_fallcurve_object_database_fetch(VT_FALLCURVE_OBJECT* fc_object, VT_FALLCURVE_DATABASE_FLATTENED* flattened_db);
 
@@ -0,0 +1,22 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+/** @file */
+
+#ifndef _VT_SCHEDULER_CONFIG_H
+#define _VT_SCHEDULER_CONFIG_H
+
+/* Checks of a component kept to judge its stability and drift trend */
+#define VT_SCHEDULER_HISTORY_LENGTH 8
+/* Bounds on the number of cycles between two checks of a component */
+#define VT_SCHEDULER_MIN_INTERVAL 1
+#define VT_SCHEDULER_MAX_INTERVAL 16
+/* Consecutive matching checks without an upward drift trend after which the interval doubles */
+#define VT_SCHEDULER_STABLE_CHECKS 4
+/* Rise in drift across the history that counts as an upward trend and halves the interval */
+#define VT_SCHEDULER_DRIFT_TREND_RISE 5
+/* Default budget per cycle, a component deferred for VT_SCHEDULER_MAX_INTERVAL cycles is checked regardless */
+#define VT_SCHEDULER_DEFAULT_MAX_CHECKS_PER_CYCLE      4
+#define VT_SCHEDULER_DEFAULT_MAX_DOWNTIME_US_PER_CYCLE 100000
+
+#endif
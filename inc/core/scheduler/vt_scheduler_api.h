@@ -0,0 +1,69 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+/** @file */
+
+#ifndef _VT_SCHEDULER_API_H
+#define _VT_SCHEDULER_API_H
+
+#include "vt_defs.h"
+#include "vt_scheduler_config.h"
+
+/* Budget shared by every component verified in one telemetry cycle */
+typedef struct VT_SCHEDULER_STRUCT
+{
+    VT_ULONG cycle;
+    VT_UINT max_checks_per_cycle;
+    VT_ULONG max_downtime_us_per_cycle;
+    VT_UINT checks_spent;
+    VT_ULONG downtime_spent_us;
+} VT_SCHEDULER;
+
+/* Ring of the last checks of one component, downtime_us is how long one check takes its sensor offline */
+typedef struct VT_SCHEDULER_COMPONENT_STRUCT
+{
+    VT_UINT status_history[VT_SCHEDULER_HISTORY_LENGTH];
+    VT_UINT drift_history[VT_SCHEDULER_HISTORY_LENGTH];
+    VT_UINT history_head;
+    VT_UINT history_count;
+    VT_ULONG interval;
+    VT_ULONG next_check;
+    VT_ULONG last_check;
+    VT_ULONG downtime_us;
+} VT_SCHEDULER_COMPONENT;
+
+/* Schedule of one component, last_status is VT_SIGNATURE_EVAL_DEFAULT_VALUE until its first check */
+typedef struct VT_SCHEDULER_SCHEDULE_STRUCT
+{
+    VT_ULONG interval;
+    VT_ULONG cycles_until_check;
+    VT_ULONG cycles_since_check;
+    VT_UINT last_status;
+    VT_UINT last_drift;
+} VT_SCHEDULER_SCHEDULE;
+
+// Initialize a scheduler with a budget of checks and sensor downtime per cycle, 0 leaves that budget unlimited
+VT_VOID vt_scheduler_initialize(VT_SCHEDULER* scheduler, VT_UINT max_checks_per_cycle, VT_ULONG max_downtime_us_per_cycle);
+
+// Initialize a component so it is due in the next cycle, again whenever its template changes so the history of the old
+// template does not stretch the first checks of the new one
+VT_VOID vt_scheduler_component_initialize(VT_SCHEDULER_COMPONENT* component, VT_ULONG downtime_us);
+
+// Start a telemetry cycle and refill its budget
+VT_VOID vt_scheduler_cycle_start(VT_SCHEDULER* scheduler);
+
+// Whether a component should be checked this cycle, a true result charges its check and downtime to the budget
+VT_BOOL vt_scheduler_component_due(VT_SCHEDULER* scheduler, VT_SCHEDULER_COMPONENT* component);
+
+// Record the result of a check and pick the next one, a non-zero downtime_us replaces the component's downtime estimate
+VT_VOID vt_scheduler_component_record(VT_SCHEDULER* scheduler,
+    VT_SCHEDULER_COMPONENT* component,
+    VT_UINT sensor_status,
+    VT_UINT sensor_drift,
+    VT_ULONG downtime_us);
+
+// Fetch the schedule of a component, its last status stands for the telemetry until the next check
+VT_VOID vt_scheduler_component_fetch_schedule(
+    VT_SCHEDULER* scheduler, VT_SCHEDULER_COMPONENT* component, VT_SCHEDULER_SCHEDULE* schedule);
+
+#endif
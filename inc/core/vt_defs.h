@@ -35,16 +35,19 @@
 #define VT_DB_NOT_UPDATED 0x00
 #define VT_DB_UPDATED     0x01
 
-#define VT_UINT  uint16_t
-#define VT_INT   int16_t
-#define VT_UINT8 uint8_t
-#define VT_INT32 int32_t
-#define VT_ULONG unsigned long
-#define VT_UCHAR unsigned char
-#define VT_CHAR  char
-#define VT_VOID  void
-#define VT_FLOAT float
-#define VT_BOOL  bool
+#define VT_UINT   uint16_t
+#define VT_INT    int16_t
+#define VT_UINT8  uint8_t
+#define VT_INT32  int32_t
+#define VT_UINT32 uint32_t
+#define VT_INT64  int64_t
+#define VT_UINT64 uint64_t
+#define VT_ULONG  unsigned long
+#define VT_UCHAR  unsigned char
+#define VT_CHAR   char
+#define VT_VOID   void
+#define VT_FLOAT  float
+#define VT_BOOL   bool
 
 #define VT_ADC_ID         VT_UINT
 #define VT_ADC_CONTROLLER VT_VOID
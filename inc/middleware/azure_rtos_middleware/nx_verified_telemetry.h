@@ -21,7 +21,10 @@ extern "C" {
 #define VT_SIGNATURE_TYPE_FALLCURVE    0x01
 #define VT_SIGNATURE_TYPE_CURRENTSENSE 0x02
 
-#define VT_MINIMUM_BUFFER_SIZE_BYTES sizeof(VT_CURRENTSENSE_RAW_SIGNATURES_READER)
+/* Head of the scratch buffer reserved for telemetry message properties, the rest is pooled for currentsense signatures */
+#define NX_VT_MESSAGE_PROPERTIES_BUFFER_LENGTH 200
+
+#define VT_MINIMUM_BUFFER_SIZE_BYTES (NX_VT_MESSAGE_PROPERTIES_BUFFER_LENGTH + VT_CS_RAW_SIGNATURES_BUFFER_MAX_SIZE)
 
 union NX_VT_SIGNATURE_COMPONENT_UNION_TAG {
 
@@ -79,6 +82,18 @@ typedef struct NX_VERIFIED_TELEMETRY_DB_TAG
     /* Length of byte buffer passed from application layer, used for fingerprint calculation/storage */
     UINT scratch_buffer_length;
 
+    /* Length of the scratch buffer head used for telemetry message properties */
+    UINT message_properties_length;
+
+    /* Pool handing out right-sized raw signature buffers to currentsense sensors from the rest of the scratch buffer */
+    VT_CURRENTSENSE_BUFFER_POOL currentsense_buffer_pool;
+
+    /* Picks the fallcurve sensors verified in each nx_vt_compute_evaluate_fingerprint_all_sensors call */
+    VT_SCHEDULER fallcurve_scheduler;
+
+    /* Picks the currentsense sensors verified in each nx_vt_signature_read and nx_vt_signature_process pair */
+    VT_SCHEDULER currentsense_scheduler;
+
 } NX_VERIFIED_TELEMETRY_DB;
 
 /**
@@ -90,6 +105,7 @@ typedef struct NX_VERIFIED_TELEMETRY_DB_TAG
  * during runtime from a writable Digital Twin property.
  * @param[in] device_driver The platform specific device driver components for interacting with the device hardware.
  * @param[in] scratch_buffer Pointer to byte buffer passed from application layer, used for fingerprint calculation/storage.
+ * Currentsense sensors share it through a pool which sizes each sensor's raw signature buffer from its template.
  * @param[in] scratch_buffer_length Length of byte buffer passed from application layer, used for fingerprint calculation/storage.
  *
  * @retval NX_AZURE_IOT_SUCCESS upon success or an error code upon failure.
@@ -276,6 +292,19 @@ UINT nx_vt_signature_read(
 UINT nx_vt_signature_process(
     NX_VERIFIED_TELEMETRY_DB* verified_telemetry_DB, UCHAR* associated_telemetry, UINT associated_telemetry_length);
 
+/**
+ * @brief Processes the VT signatures collected so far while the read started by nx_vt_signature_read is still running,
+ * publishing a provisional template while a sensor calibrates
+ *
+ * @param[in] verified_telemetry_DB Pointer to variable of type VERIFIED_TELEMETRY_DB storing Verified Telemetry data.
+ * @param[in] associated_telemetry Name of the telemetry.
+ * @param[in] associated_telemetry_length Length of name of the telemetry.
+ *
+ * @retval NX_AZURE_IOT_SUCCESS upon success or an error code upon failure.
+ */
+UINT nx_vt_signature_process_partial(
+    NX_VERIFIED_TELEMETRY_DB* verified_telemetry_DB, UCHAR* associated_telemetry, UINT associated_telemetry_length);
+
 #ifdef __cplusplus
 }
 #endif
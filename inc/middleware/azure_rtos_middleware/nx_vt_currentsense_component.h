@@ -14,7 +14,9 @@ extern "C" {
 #include "nx_azure_iot_json_writer.h"
 #include "nx_azure_iot_pnp_client.h"
 
+#include "vt_changepoint_api.h"
 #include "vt_cs_api.h"
+#include "vt_scheduler_api.h"
 
 typedef struct NX_VT_CURRENTSENSE_COMPONENT_TAG
 {
@@ -33,6 +35,20 @@ typedef struct NX_VT_CURRENTSENSE_COMPONENT_TAG
     /* Status of reported properties sent  */
     UINT property_sent;
 
+    /* Check history deciding when this sensor is verified next, the sensor status holds the last check until then */
+    VT_SCHEDULER_COMPONENT scheduler_component;
+
+    /* Raw signatures were read this cycle and are waiting for nx_vt_currentsense_signature_process */
+    bool signature_read_pending;
+
+    /* Debounces the sensor status of every evaluation into the reported telemetry status */
+    VT_CHANGEPOINT_DETECTOR drift_detector;
+
+    /* Status of the signatures evaluated so far in the read still running, reported until the full evaluation lands */
+    bool partial_status_pending;
+    VT_UINT partial_sensor_status;
+    VT_UINT partial_sensor_drift;
+
 } NX_VT_CURRENTSENSE_COMPONENT;
 
 /**
@@ -44,8 +60,7 @@ typedef struct NX_VT_CURRENTSENSE_COMPONENT_TAG
  * @param[in] sensor_handle The platform driver references for interacting with the particular sensor connected to device
  * hardware.
  * @param[in] associated_telemetry Name of the telemetry associated with this component.
- * @param[in] shared_buffer Pointer to byte buffer passed from application layer, used for fingerprint calculation/storage.
- * @param[in] shared_buffer_length Length of byte buffer passed from application layer, used for fingerprint calculation/storage.
+ * @param[in] buffer_pool Pool over the application scratch buffer from which this sensor's raw signature buffer is carved.
  *
  * @retval VT_SUCCESS upon success or an error code upon failure.
  */
@@ -55,8 +70,7 @@ UINT nx_vt_currentsense_init(NX_VT_CURRENTSENSE_COMPONENT* handle,
     VT_DEVICE_DRIVER* device_driver,
     VT_SENSOR_HANDLE* sensor_handle,
     UCHAR* associated_telemetry,
-    CHAR* shared_buffer,
-    UINT shared_buffer_size);
+    VT_CURRENTSENSE_BUFFER_POOL* buffer_pool);
 
 /**
  * @brief Send read-only properties of the currentsense component like telemetryStatus, fingerprintType, fingerprintTemplate,
@@ -125,6 +139,7 @@ UINT nx_vt_currentsense_process_reported_property_sync(NX_VT_CURRENTSENSE_COMPON
  * @brief Start reading current on the device. Call this function just before reading sensor data.
  *
  * @param[in] handle The currentsense handle created by a call to the initialization function.
+ * @param[in] scheduler Scheduler deciding whether this cycle evaluates the sensor, NX_NULL evaluates every cycle.
  * @param[in] associated_telemetry Name of the telemetry associated with this component.
  * @param[in] associated_telemetry_length Length of the name of the telemetry associated with this component.
  * @param[in] toggle_verified_telemetry Bool value to enable VT for this component or not.
@@ -133,6 +148,7 @@ UINT nx_vt_currentsense_process_reported_property_sync(NX_VT_CURRENTSENSE_COMPON
  */
 
 UINT nx_vt_currentsense_signature_read(NX_VT_CURRENTSENSE_COMPONENT* handle,
+    VT_SCHEDULER* scheduler,
     UCHAR* associated_telemetry,
     UINT associated_telemetry_length,
     bool toggle_verified_telemetry);
@@ -141,6 +157,7 @@ UINT nx_vt_currentsense_signature_read(NX_VT_CURRENTSENSE_COMPONENT* handle,
  * @brief Process the raw current data stored. Get status in normal operation, calibrate and recalibrate based on commands.
  *
  * @param[in] handle The currentsense handle created by a call to the initialization function.
+ * @param[in] scheduler Scheduler the evaluated sensor status is recorded with, the same one passed to the read.
  * @param[in] associated_telemetry Name of the telemetry associated with this component.
  * @param[in] associated_telemetry_length Length of the name of the telemetry associated with this component.
  * @param[in] toggle_verified_telemetry Bool value to enable VT for this component or not.
@@ -149,6 +166,27 @@ UINT nx_vt_currentsense_signature_read(NX_VT_CURRENTSENSE_COMPONENT* handle,
  */
 
 UINT nx_vt_currentsense_signature_process(NX_VT_CURRENTSENSE_COMPONENT* handle,
+    VT_SCHEDULER* scheduler,
+    UCHAR* associated_telemetry,
+    UINT associated_telemetry_length,
+    bool toggle_verified_telemetry);
+
+/**
+ * @brief Process the raw current data whose buffers have filled so far while the read is still running. The first
+ * calibration capture publishes a provisional template, later calibration captures and recalibration are checked against
+ * the template held so far and report a status with its reduced confidence metric. A status from the signatures evaluated
+ * so far is reported by nx_vt_currentsense_fetch_telemetry_status until nx_vt_currentsense_signature_process evaluates the
+ * whole capture.
+ *
+ * @param[in] handle The currentsense handle created by a call to the initialization function.
+ * @param[in] associated_telemetry Name of the telemetry associated with this component.
+ * @param[in] associated_telemetry_length Length of the name of the telemetry associated with this component.
+ * @param[in] toggle_verified_telemetry Bool value to enable VT for this component or not.
+ *
+ * @retval NX_AZURE_IOT_SUCCESS upon success or an error code upon failure.
+ */
+
+UINT nx_vt_currentsense_signature_process_partial(NX_VT_CURRENTSENSE_COMPONENT* handle,
     UCHAR* associated_telemetry,
     UINT associated_telemetry_length,
     bool toggle_verified_telemetry);
@@ -14,7 +14,9 @@ extern "C" {
 #include "nx_azure_iot_json_writer.h"
 #include "nx_azure_iot_pnp_client.h"
 
+#include "vt_changepoint_api.h"
 #include "vt_fc_api.h"
+#include "vt_scheduler_api.h"
 
 typedef struct NX_VT_FALLCURVE_COMPONENT_TAG
 {
@@ -42,6 +44,12 @@ typedef struct NX_VT_FALLCURVE_COMPONENT_TAG
     /* Compute sensor status when a global command is issued */
     bool telemetry_status_auto_update;
 
+    /* Check history deciding when this sensor is verified next, telemetry_status holds the last check until then */
+    VT_SCHEDULER_COMPONENT scheduler_component;
+
+    /* Debounces the sensor status of every check into telemetry_status */
+    VT_CHANGEPOINT_DETECTOR drift_detector;
+
 } NX_VT_FALLCURVE_COMPONENT;
 
 /**
@@ -144,6 +152,21 @@ UINT nx_vt_fallcurve_process_reported_property_sync(NX_VT_FALLCURVE_COMPONENT* h
 
 UINT nx_vt_fallcurve_compute_sensor_status_global(NX_VT_FALLCURVE_COMPONENT* handle, bool toggle_verified_telemetry);
 
+/**
+ * @brief Get status of the sensors related to several fallcurve components from one shared discharge window.
+ *
+ * @param[in] handles The fallcurve handles created by calls to the initialization function.
+ * @param[in] num_handles Number of handles, at most VT_FC_MAX_BATCH_SENSORS.
+ * @param[in] scheduler Scheduler whose budget the batch is drawn from, only sensors due this cycle are verified. NX_NULL
+ * verifies every sensor.
+ * @param[in] toggle_verified_telemetry Bool value to enable VT for these components or not.
+ *
+ * @retval NX_AZURE_IOT_SUCCESS upon success or an error code upon failure.
+ */
+
+UINT nx_vt_fallcurve_compute_sensor_status_global_batch(
+    NX_VT_FALLCURVE_COMPONENT** handles, UINT num_handles, VT_SCHEDULER* scheduler, bool toggle_verified_telemetry);
+
 #ifdef __cplusplus
 }
 #endif
@@ -65,6 +65,9 @@ typedef struct FreeRTOS_VERIFIED_TELEMETRY_DB_TAG
     /* Device Status Property Sent*/
     bool device_status_property_sent;
 
+    /* Picks the fallcurve sensors verified in each FreeRTOS_vt_compute_evaluate_fingerprint_all_sensors call */
+    VT_SCHEDULER fallcurve_scheduler;
+
 } FreeRTOS_VERIFIED_TELEMETRY_DB;
 
 /**
@@ -11,6 +11,9 @@
 /**
  * @brief Initializes ADC controller and channel for single adc read
  *
+ * Fallcurve sensors evaluated in a batch are read round-robin, this is called again before the reads of each sensor to
+ * select its channel, so it must be cheap enough to call between two reads and leave the sensor itself untouched.
+ *
  * @param[in] adc_id User defined ADC controller/Channel identifier for a particular sensor / current measurement circuit.
  * Variables adc_controller and adc_channel can be used alternatively.
  * @param[in] adc_controller Void pointer to the system ADC Controller to which a particular sensor / current measurement circuit
@@ -128,4 +131,29 @@ void vt_interrupt_enable();
  */
 void vt_interrupt_disable();
 
+/**
+ * @brief Persists an opaque blob in non-volatile storage, replacing any blob previously stored under the same key. Optional,
+ * enable it together with vt_storage_load() through vt_device_driver_storage_set(), without them templates are only restored
+ * from the cloud. A blob identical to the stored one is not written again.
+ *
+ * @param[in] key Null terminated name of the blob, one per Verified Telemetry component.
+ * @param[in] buffer Blob to be stored.
+ * @param[in] size Size of the blob in bytes.
+ *
+ * @retval 0x00 upon success or 0x01 upon failure.
+ */
+uint16_t vt_storage_store(char* key, uint8_t* buffer, unsigned long size);
+
+/**
+ * @brief Reads back a blob previously stored under a key
+ *
+ * @param[in] key Null terminated name of the blob.
+ * @param[out] buffer Buffer in which the blob would be stored.
+ * @param[in] buffer_size Size of the buffer in bytes.
+ * @param[out] size Size of the blob read in bytes.
+ *
+ * @retval 0x00 upon success or 0x01 if no blob is stored under the key or it does not fit in the buffer.
+ */
+uint16_t vt_storage_load(char* key, uint8_t* buffer, unsigned long buffer_size, unsigned long* size);
+
 #endif // _VT_DEVICE_DRIVER_TEMPLATE_H
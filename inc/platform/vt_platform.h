@@ -27,6 +27,13 @@ typedef VT_UINT (*VT_GPIO_FUNC)(VT_GPIO_ID gpio_id, VT_GPIO_PORT* gpio_port, VT_
 typedef VT_UINT (*VT_TICK_INIT_FUNC)(VT_UINT* max_value, VT_UINT* resolution_usec);
 typedef VT_ULONG (*VT_TICK_FUNC)();
 typedef VT_VOID (*VT_INTERRUPT_CTRL)();
+typedef VT_UINT (*VT_STORAGE_STORE_FUNC)(VT_CHAR* key, VT_UCHAR* buffer, VT_ULONG size);
+typedef VT_UINT (*VT_STORAGE_LOAD_FUNC)(VT_CHAR* key, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* size);
+
+/* Optional hooks are only called once enabled through their setter, which stamps optional_hooks_key so a driver struct
+   filled field by field without them never has garbage in optional_hooks or their pointers called */
+#define VT_DEVICE_DRIVER_OPTIONAL_HOOKS_KEY 0x56544448UL
+#define VT_DEVICE_DRIVER_HOOK_STORAGE       0x0002
 
 typedef struct VT_DEVICE_DRIVER_STRUCT
 {
@@ -40,6 +47,10 @@ typedef struct VT_DEVICE_DRIVER_STRUCT
     VT_TICK_FUNC tick;
     VT_INTERRUPT_CTRL interrupt_enable;
     VT_INTERRUPT_CTRL interrupt_disable;
+    VT_ULONG optional_hooks_key;
+    VT_UINT optional_hooks;
+    VT_STORAGE_STORE_FUNC storage_store;
+    VT_STORAGE_LOAD_FUNC storage_load;
 } VT_DEVICE_DRIVER;
 
 typedef struct VT_SENSOR_HANDLE_STRUCT
@@ -55,4 +66,11 @@ typedef struct VT_SENSOR_HANDLE_STRUCT
     VT_FLOAT* currentsense_mV_to_mA;
 } VT_SENSOR_HANDLE;
 
+// Enable the storage hooks templates are persisted through, both are required and either NULL disables them
+VT_VOID vt_device_driver_storage_set(
+    VT_DEVICE_DRIVER* device_driver, VT_STORAGE_STORE_FUNC storage_store, VT_STORAGE_LOAD_FUNC storage_load);
+
+// Whether the optional hook was enabled through its setter
+VT_BOOL vt_device_driver_hook_enabled(VT_DEVICE_DRIVER* device_driver, VT_UINT hook);
+
 #endif
@@ -0,0 +1,134 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include <math.h>
+
+#include "vt_changepoint_api.h"
+#include "vt_debug.h"
+
+/* Scores adding up to the decision interval exactly, e.g. 3 x ln(10) against ln(1000), must not miss it by float rounding */
+#define CHANGEPOINT_DECISION_TOLERANCE 1e-3f
+
+VT_VOID vt_changepoint_detector_initialize(VT_CHANGEPOINT_DETECTOR* detector)
+{
+    vt_changepoint_detector_configure(detector,
+        VT_CHANGEPOINT_DEFAULT_FALSE_ALARM_RATE,
+        VT_CHANGEPOINT_DEFAULT_IN_CONTROL_FAIL_RATE,
+        VT_CHANGEPOINT_DEFAULT_OUT_OF_CONTROL_FAIL_RATE,
+        VT_CHANGEPOINT_DEFAULT_DRIFT_WEIGHT);
+}
+
+VT_UINT vt_changepoint_detector_configure(VT_CHANGEPOINT_DETECTOR* detector,
+    VT_FLOAT false_alarm_rate,
+    VT_FLOAT in_control_fail_rate,
+    VT_FLOAT out_of_control_fail_rate,
+    VT_FLOAT drift_weight)
+{
+    if (false_alarm_rate <= 0 || false_alarm_rate >= 1 || in_control_fail_rate <= 0 ||
+        out_of_control_fail_rate <= in_control_fail_rate || out_of_control_fail_rate >= 1 || drift_weight <= 0 ||
+        drift_weight > 1)
+    {
+        VTLogError("Change point detector settings not supported \r\n");
+        return VT_ERROR;
+    }
+
+    // Lorden's bound, the mean run length between false alarms of a CUSUM with decision interval h is at least e^h
+    detector->fail_score        = logf(out_of_control_fail_rate / in_control_fail_rate);
+    detector->pass_score        = logf((1.0f - out_of_control_fail_rate) / (1.0f - in_control_fail_rate));
+    detector->decision_interval = logf(1.0f / false_alarm_rate) - CHANGEPOINT_DECISION_TOLERANCE;
+    detector->drift_weight      = drift_weight;
+    vt_changepoint_detector_reset(detector);
+
+    return VT_SUCCESS;
+}
+
+VT_VOID vt_changepoint_detector_reset(VT_CHANGEPOINT_DETECTOR* detector)
+{
+    detector->cusum           = 0;
+    detector->recovery_cusum  = 0;
+    detector->drift           = 0;
+    detector->status          = VT_SIGNATURE_EVAL_DEFAULT_VALUE;
+    detector->decided         = false;
+    detector->drift_available = false;
+}
+
+/* Before the first decision a fresh template is neither presumed to match nor to fail, the raw status is reported until
+   the evidence for a change or for a match crosses the decision interval */
+static VT_VOID changepoint_detector_decide(VT_CHANGEPOINT_DETECTOR* detector, VT_UINT sensor_status)
+{
+    VT_FLOAT score = (sensor_status == VT_SIGNATURE_MATCHING) ? detector->pass_score : detector->fail_score;
+
+    detector->cusum          = (detector->cusum + score > 0) ? (detector->cusum + score) : 0;
+    detector->recovery_cusum = (detector->recovery_cusum - score > 0) ? (detector->recovery_cusum - score) : 0;
+    detector->status         = sensor_status;
+    if (detector->cusum >= detector->decision_interval)
+    {
+        detector->decided = true;
+    }
+    else if (detector->recovery_cusum >= detector->decision_interval)
+    {
+        detector->decided = true;
+        detector->status  = VT_SIGNATURE_MATCHING;
+    }
+    if (detector->decided)
+    {
+        detector->cusum          = 0;
+        detector->recovery_cusum = 0;
+        VTLogDebug("First decision, debounced sensor status %d \r\n", detector->status);
+    }
+}
+
+VT_VOID vt_changepoint_detector_update(VT_CHANGEPOINT_DETECTOR* detector, VT_UINT sensor_status, VT_UINT sensor_drift)
+{
+    VT_FLOAT score = 0;
+
+    if (detector->drift_available)
+    {
+        detector->drift += detector->drift_weight * ((VT_FLOAT)sensor_drift - detector->drift);
+    }
+    else
+    {
+        detector->drift           = sensor_drift;
+        detector->drift_available = true;
+    }
+
+    if (sensor_status == VT_SIGNATURE_DB_EMPTY || sensor_status == VT_SIGNATURE_EVAL_DEFAULT_VALUE)
+    {
+        detector->cusum          = 0;
+        detector->recovery_cusum = 0;
+        detector->decided        = false;
+        detector->status         = sensor_status;
+        return;
+    }
+    if (!detector->decided)
+    {
+        changepoint_detector_decide(detector, sensor_status);
+        return;
+    }
+
+    // Once decided the status only flips when enough evidence has accumulated
+
+    score = (sensor_status == VT_SIGNATURE_MATCHING) ? detector->pass_score : detector->fail_score;
+    if (detector->status != VT_SIGNATURE_MATCHING)
+    {
+        score = -score;
+    }
+    detector->cusum = (detector->cusum + score > 0) ? (detector->cusum + score) : 0;
+    if (detector->cusum >= detector->decision_interval)
+    {
+        detector->cusum  = 0;
+        detector->status = sensor_status;
+        VTLogDebug("Change point detected, debounced sensor status %d \r\n", detector->status);
+    }
+    else if (detector->status != VT_SIGNATURE_MATCHING && sensor_status != VT_SIGNATURE_MATCHING)
+    {
+        // Still failing, report the latest way it fails
+        detector->status = sensor_status;
+    }
+}
+
+VT_VOID vt_changepoint_detector_fetch_status(VT_CHANGEPOINT_DETECTOR* detector, VT_UINT* sensor_status, VT_UINT* sensor_drift)
+{
+    *sensor_status = detector->status;
+    *sensor_drift  = detector->drift_available ? (VT_UINT)(detector->drift + 0.5f) : VT_SIGNATURE_DRIFT_DEFAULT_VALUE;
+}
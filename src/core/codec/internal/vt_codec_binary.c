@@ -0,0 +1,210 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_codec_binary.h"
+#include "vt_debug.h"
+#include <math.h>
+
+#define CODEC_CRC16_POLYNOMIAL 0x1021
+#define CODEC_CRC16_SEED       0xFFFF
+#define CODEC_FIXED_ONE        65536.0f
+#define CODEC_FIXED_LIMIT      32768.0f
+
+VT_UINT codec_crc16(VT_UCHAR* buffer, VT_ULONG size)
+{
+    VT_UINT crc = CODEC_CRC16_SEED;
+
+    for (VT_ULONG iter = 0; iter < size; iter++)
+    {
+        crc ^= (VT_UINT)(buffer[iter] << 8);
+        for (VT_UINT bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (VT_UINT)((crc << 1) ^ CODEC_CRC16_POLYNOMIAL) : (VT_UINT)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static VT_VOID codec_encode_bytes(VT_CODEC_CURSOR* cursor, VT_ULONG value, VT_UINT num_bytes)
+{
+    if (cursor->error || (cursor->size - cursor->position) < num_bytes)
+    {
+        if (cursor->error == false)
+        {
+            VTLogError("Binary template does not fit in %lu bytes \r\n", (long unsigned int)cursor->size);
+        }
+        cursor->error = true;
+        return;
+    }
+
+    // Least significant byte first whatever the byte order of the target
+    for (VT_UINT iter = 0; iter < num_bytes; iter++)
+    {
+        cursor->buffer[cursor->position++] = (VT_UCHAR)((value >> (8 * iter)) & 0xFF);
+    }
+}
+
+static VT_ULONG codec_decode_bytes(VT_CODEC_CURSOR* cursor, VT_UINT num_bytes)
+{
+    VT_ULONG value = 0;
+
+    if (cursor->error || (cursor->size - cursor->position) < num_bytes)
+    {
+        cursor->error = true;
+        return 0;
+    }
+
+    for (VT_UINT iter = 0; iter < num_bytes; iter++)
+    {
+        value |= ((VT_ULONG)cursor->buffer[cursor->position++]) << (8 * iter);
+    }
+
+    return value;
+}
+
+VT_VOID codec_encode_begin(VT_CODEC_CURSOR* cursor, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_UINT8 kind)
+{
+    cursor->buffer   = buffer;
+    cursor->size     = buffer_size;
+    cursor->position = 0;
+    cursor->error    = false;
+
+    codec_encode_u8(cursor, VT_CODEC_VERSION);
+    codec_encode_u8(cursor, kind);
+
+    // Payload length is filled in once the payload is written
+    codec_encode_bytes(cursor, 0, 2);
+}
+
+VT_VOID codec_encode_u8(VT_CODEC_CURSOR* cursor, VT_UINT8 value)
+{
+    codec_encode_bytes(cursor, value, 1);
+}
+
+VT_VOID codec_encode_u32(VT_CODEC_CURSOR* cursor, VT_ULONG value)
+{
+    if (value > 0xFFFFFFFFUL)
+    {
+        cursor->error = true;
+        return;
+    }
+    codec_encode_bytes(cursor, value, 4);
+}
+
+VT_VOID codec_encode_fixed(VT_CODEC_CURSOR* cursor, VT_FLOAT value)
+{
+    VT_INT32 fixed;
+
+    if (!(value > -CODEC_FIXED_LIMIT && value < CODEC_FIXED_LIMIT))
+    {
+        VTLogError("Template value out of fixed point range \r\n");
+        cursor->error = true;
+        return;
+    }
+    fixed = (VT_INT32)floorf((value * CODEC_FIXED_ONE) + 0.5f);
+    codec_encode_bytes(cursor, (VT_ULONG)(VT_UINT32)fixed, 4);
+}
+
+VT_UINT codec_encode_end(VT_CODEC_CURSOR* cursor, VT_ULONG* encoded_size)
+{
+    VT_ULONG payload_length = cursor->position - VT_CODEC_HEADER_SIZE;
+
+    if (cursor->error == false)
+    {
+        cursor->buffer[2] = (VT_UCHAR)(payload_length & 0xFF);
+        cursor->buffer[3] = (VT_UCHAR)((payload_length >> 8) & 0xFF);
+        codec_encode_bytes(cursor, codec_crc16(cursor->buffer, cursor->position), VT_CODEC_CRC_SIZE);
+    }
+    if (cursor->error)
+    {
+        return VT_ERROR;
+    }
+
+    *encoded_size = cursor->position;
+    return VT_SUCCESS;
+}
+
+VT_UINT codec_decode_begin(VT_CODEC_CURSOR* cursor, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_UINT8 kind)
+{
+    VT_ULONG payload_length;
+    VT_ULONG crc_offset;
+
+    cursor->buffer   = buffer;
+    cursor->size     = buffer_size;
+    cursor->position = 0;
+    cursor->error    = false;
+
+    if (buffer_size < VT_CODEC_HEADER_SIZE + VT_CODEC_CRC_SIZE)
+    {
+        return VT_ERROR;
+    }
+    if (codec_decode_u8(cursor) != VT_CODEC_VERSION)
+    {
+        VTLogError("Binary template version %d not supported \r\n", buffer[0]);
+        return VT_ERROR;
+    }
+    if (codec_decode_u8(cursor) != kind)
+    {
+        VTLogError("Binary template kind %d does not match \r\n", buffer[1]);
+        return VT_ERROR;
+    }
+    payload_length = codec_decode_bytes(cursor, 2);
+    crc_offset     = VT_CODEC_HEADER_SIZE + payload_length;
+    if (crc_offset + VT_CODEC_CRC_SIZE > buffer_size)
+    {
+        return VT_ERROR;
+    }
+    if (codec_crc16(buffer, crc_offset) != (VT_UINT)(buffer[crc_offset] | (buffer[crc_offset + 1] << 8)))
+    {
+        VTLogError("Binary template CRC mismatch \r\n");
+        return VT_ERROR;
+    }
+
+    // Fields are read from the payload only
+    cursor->size = crc_offset;
+    return VT_SUCCESS;
+}
+
+VT_UINT8 codec_decode_u8(VT_CODEC_CURSOR* cursor)
+{
+    return (VT_UINT8)codec_decode_bytes(cursor, 1);
+}
+
+VT_ULONG codec_decode_u32(VT_CODEC_CURSOR* cursor)
+{
+    return codec_decode_bytes(cursor, 4);
+}
+
+VT_FLOAT codec_decode_fixed(VT_CODEC_CURSOR* cursor)
+{
+    VT_INT32 fixed = (VT_INT32)(VT_UINT32)codec_decode_bytes(cursor, 4);
+
+    return (VT_FLOAT)fixed / CODEC_FIXED_ONE;
+}
+
+VT_UINT codec_decode_end(VT_CODEC_CURSOR* cursor)
+{
+    // Every payload byte must have been consumed by a field
+    if (cursor->error || cursor->position != cursor->size)
+    {
+        return VT_ERROR;
+    }
+    return VT_SUCCESS;
+}
+
+VT_UINT vt_codec_encoded_size(VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* encoded_size)
+{
+    VT_ULONG size;
+
+    if (buffer_size < VT_CODEC_HEADER_SIZE + VT_CODEC_CRC_SIZE)
+    {
+        return VT_ERROR;
+    }
+    size = VT_CODEC_HEADER_SIZE + (VT_ULONG)(buffer[2] | (buffer[3] << 8)) + VT_CODEC_CRC_SIZE;
+    if (size > buffer_size)
+    {
+        return VT_ERROR;
+    }
+    *encoded_size = size;
+    return VT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_codec_api.h"
+
+#define CODEC_BASE64_PADDING '='
+#define CODEC_BASE64_INVALID 0xFF
+
+static const VT_CHAR codec_base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static VT_UINT8 codec_base64_value(VT_CHAR character)
+{
+    if (character >= 'A' && character <= 'Z')
+    {
+        return (VT_UINT8)(character - 'A');
+    }
+    if (character >= 'a' && character <= 'z')
+    {
+        return (VT_UINT8)(character - 'a' + 26);
+    }
+    if (character >= '0' && character <= '9')
+    {
+        return (VT_UINT8)(character - '0' + 52);
+    }
+    if (character == '+')
+    {
+        return 62;
+    }
+    if (character == '/')
+    {
+        return 63;
+    }
+    return CODEC_BASE64_INVALID;
+}
+
+VT_UINT vt_codec_base64_encode(VT_UCHAR* buffer, VT_ULONG buffer_size, VT_CHAR* text, VT_ULONG text_size)
+{
+    VT_ULONG text_length = 0;
+    VT_ULONG group;
+
+    if (text_size < VT_CODEC_BASE64_SIZE(buffer_size))
+    {
+        return VT_ERROR;
+    }
+
+    for (VT_ULONG iter = 0; iter < buffer_size; iter += 3)
+    {
+        group = (VT_ULONG)buffer[iter] << 16;
+        if (iter + 1 < buffer_size)
+        {
+            group |= (VT_ULONG)buffer[iter + 1] << 8;
+        }
+        if (iter + 2 < buffer_size)
+        {
+            group |= buffer[iter + 2];
+        }
+
+        text[text_length++] = codec_base64_alphabet[(group >> 18) & 0x3F];
+        text[text_length++] = codec_base64_alphabet[(group >> 12) & 0x3F];
+        text[text_length++] = (iter + 1 < buffer_size) ? codec_base64_alphabet[(group >> 6) & 0x3F] : CODEC_BASE64_PADDING;
+        text[text_length++] = (iter + 2 < buffer_size) ? codec_base64_alphabet[group & 0x3F] : CODEC_BASE64_PADDING;
+    }
+    text[text_length] = '\0';
+
+    return VT_SUCCESS;
+}
+
+VT_UINT vt_codec_base64_decode(VT_CHAR* text, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* decoded_size)
+{
+    VT_ULONG decoded_length = 0;
+    VT_ULONG group;
+    VT_UINT num_padding;
+    VT_UINT8 value;
+
+    for (VT_ULONG iter = 0; text[iter] != '\0'; iter += 4)
+    {
+        group       = 0;
+        num_padding = 0;
+        for (VT_UINT position = 0; position < 4; position++)
+        {
+            if (text[iter + position] == '\0')
+            {
+                return VT_ERROR;
+            }
+
+            // Padding may only close the final group
+            if (text[iter + position] == CODEC_BASE64_PADDING && position >= 2)
+            {
+                num_padding++;
+                group <<= 6;
+                continue;
+            }
+            value = codec_base64_value(text[iter + position]);
+            if (value == CODEC_BASE64_INVALID || num_padding)
+            {
+                return VT_ERROR;
+            }
+            group = (group << 6) | value;
+        }
+        if (num_padding && text[iter + 4] != '\0')
+        {
+            return VT_ERROR;
+        }
+        if (decoded_length + 3 - num_padding > buffer_size)
+        {
+            return VT_ERROR;
+        }
+
+        buffer[decoded_length++] = (VT_UCHAR)((group >> 16) & 0xFF);
+        if (num_padding < 2)
+        {
+            buffer[decoded_length++] = (VT_UCHAR)((group >> 8) & 0xFF);
+        }
+        if (num_padding < 1)
+        {
+            buffer[decoded_length++] = (VT_UCHAR)(group & 0xFF);
+        }
+    }
+
+    *decoded_size = decoded_length;
+    return VT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_codec_api.h"
+#include <math.h>
+
+#define CODEC_CSV_SEPARATOR       ','
+#define CODEC_CSV_MAX_DECIMALS    9
+#define CODEC_CSV_MAX_SCALED      1.8e19
+#define CODEC_CSV_MAX_MANTISSA    100000000000000000ULL
+#define CODEC_CSV_MAX_FIELD_CHARS 40
+
+static VT_UINT64 codec_csv_power_of_ten(VT_UINT exponent)
+{
+    VT_UINT64 power = 1;
+
+    while (exponent--)
+    {
+        power *= 10;
+    }
+    return power;
+}
+
+/* Writes the number back to front into a local field, then copies it behind the separator in a single pass */
+static VT_UINT codec_csv_append_number(VT_CHAR* text,
+    VT_ULONG text_size,
+    VT_ULONG* text_length,
+    VT_BOOL negative,
+    VT_UINT64 magnitude,
+    VT_UINT decimals,
+    VT_UINT min_digits)
+{
+    VT_CHAR field[CODEC_CSV_MAX_FIELD_CHARS];
+    VT_UINT field_start   = CODEC_CSV_MAX_FIELD_CHARS;
+    VT_UINT integer_chars = 0;
+    VT_ULONG length       = *text_length;
+
+    for (VT_UINT iter = 0; iter < decimals; iter++)
+    {
+        field[--field_start] = (VT_CHAR)('0' + (magnitude % 10));
+        magnitude /= 10;
+    }
+    if (decimals)
+    {
+        field[--field_start] = '.';
+    }
+    do
+    {
+        field[--field_start] = (VT_CHAR)('0' + (magnitude % 10));
+        magnitude /= 10;
+        integer_chars++;
+    } while ((magnitude || integer_chars < min_digits) && field_start > 1);
+    if (negative)
+    {
+        field[--field_start] = '-';
+    }
+
+    // Room for the separator, the field and the terminating null
+    if (length + (length ? 1 : 0) + (CODEC_CSV_MAX_FIELD_CHARS - field_start) + 1 > text_size)
+    {
+        if (length < text_size)
+        {
+            text[length] = '\0';
+        }
+        return VT_ERROR;
+    }
+    if (length)
+    {
+        text[length++] = CODEC_CSV_SEPARATOR;
+    }
+    while (field_start < CODEC_CSV_MAX_FIELD_CHARS)
+    {
+        text[length++] = field[field_start++];
+    }
+    text[length] = '\0';
+
+    *text_length = length;
+    return VT_SUCCESS;
+}
+
+VT_UINT vt_codec_csv_append_fixed(
+    VT_CHAR* text, VT_ULONG text_size, VT_ULONG* text_length, VT_FLOAT value, VT_UINT decimals)
+{
+    double magnitude = fabs((double)value);
+    VT_UINT64 scaled;
+
+    // The value scaled to its last digit must fit VT_UINT64, NaN fails the comparison too
+    if (decimals > CODEC_CSV_MAX_DECIMALS ||
+        !((magnitude * (double)codec_csv_power_of_ten(decimals)) < CODEC_CSV_MAX_SCALED))
+    {
+        if (*text_length < text_size)
+        {
+            text[*text_length] = '\0';
+        }
+        return VT_ERROR;
+    }
+
+    // Rounded to the last digit written, a value that rounds to zero is written without its sign
+    scaled = (VT_UINT64)((magnitude * (double)codec_csv_power_of_ten(decimals)) + 0.5);
+
+    return codec_csv_append_number(text, text_size, text_length, (value < 0 && scaled), scaled, decimals, 1);
+}
+
+VT_UINT vt_codec_csv_append_unsigned(
+    VT_CHAR* text, VT_ULONG text_size, VT_ULONG* text_length, VT_ULONG value, VT_UINT min_digits)
+{
+    return codec_csv_append_number(text, text_size, text_length, false, value, 0, min_digits);
+}
+
+static VT_UINT codec_csv_parse_number(VT_CHAR* text,
+    VT_ULONG text_size,
+    VT_ULONG* position,
+    VT_BOOL* negative,
+    VT_UINT64* mantissa,
+    VT_UINT* fraction_digits)
+{
+    VT_ULONG iter      = *position;
+    VT_UINT digits     = 0;
+    VT_BOOL seen_point = false;
+
+    *negative        = false;
+    *mantissa        = 0;
+    *fraction_digits = 0;
+
+    if (iter >= text_size || text[iter] == '\0')
+    {
+        return VT_ERROR;
+    }
+    if (text[iter] == '-' || text[iter] == '+')
+    {
+        *negative = (text[iter] == '-');
+        iter++;
+    }
+
+    for (; iter < text_size && text[iter] != '\0' && text[iter] != CODEC_CSV_SEPARATOR; iter++)
+    {
+        if (text[iter] == '.' && seen_point == false)
+        {
+            seen_point = true;
+            continue;
+        }
+        if (text[iter] < '0' || text[iter] > '9')
+        {
+            return VT_ERROR;
+        }
+        digits++;
+
+        // Fraction digits past the mantissa precision are dropped, integer digits past it do not fit
+        if (*mantissa >= CODEC_CSV_MAX_MANTISSA)
+        {
+            if (seen_point == false)
+            {
+                return VT_ERROR;
+            }
+            continue;
+        }
+        *mantissa = (*mantissa * 10) + (VT_UINT64)(text[iter] - '0');
+        if (seen_point)
+        {
+            (*fraction_digits)++;
+        }
+    }
+    if (digits == 0)
+    {
+        return VT_ERROR;
+    }
+
+    if (iter < text_size && text[iter] == CODEC_CSV_SEPARATOR)
+    {
+        iter++;
+    }
+    *position = iter;
+    return VT_SUCCESS;
+}
+
+VT_UINT vt_codec_csv_parse_float(VT_CHAR* text, VT_ULONG text_size, VT_ULONG* position, VT_FLOAT* value)
+{
+    VT_BOOL negative;
+    VT_UINT64 mantissa;
+    VT_UINT fraction_digits;
+    double parsed;
+
+    if (codec_csv_parse_number(text, text_size, position, &negative, &mantissa, &fraction_digits))
+    {
+        return VT_ERROR;
+    }
+
+    parsed = (double)mantissa / (double)codec_csv_power_of_ten(fraction_digits);
+    *value = (VT_FLOAT)(negative ? -parsed : parsed);
+    return VT_SUCCESS;
+}
+
+VT_UINT vt_codec_csv_parse_unsigned(VT_CHAR* text, VT_ULONG text_size, VT_ULONG* position, VT_ULONG* value)
+{
+    VT_BOOL negative;
+    VT_UINT64 mantissa;
+    VT_UINT fraction_digits;
+    VT_ULONG start = *position;
+
+    if (codec_csv_parse_number(text, text_size, position, &negative, &mantissa, &fraction_digits))
+    {
+        return VT_ERROR;
+    }
+    if (negative)
+    {
+        *position = start;
+        return VT_ERROR;
+    }
+
+    *value = (VT_ULONG)(mantissa / codec_csv_power_of_ten(fraction_digits));
+    return VT_SUCCESS;
+}
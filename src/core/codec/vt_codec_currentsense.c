@@ -0,0 +1,167 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_codec_api.h"
+#include "vt_codec_binary.h"
+
+static VT_UINT codec_currentsense_template_encode(VT_CODEC_CURSOR* cursor, VT_CURRENTSENSE_DATABASE* database)
+{
+    VT_CURRENTSENSE_REPEATING_SIGNATURES_TEMPLATE* repeating = &(database->template.repeating_signatures);
+
+    codec_encode_u8(cursor, database->template_type);
+    if (database->template_type == VT_CS_NON_REPEATING_SIGNATURE)
+    {
+        codec_encode_fixed(cursor, database->template.non_repeating_signature.avg_curr_on);
+        codec_encode_fixed(cursor, database->template.non_repeating_signature.avg_curr_off);
+    }
+    else if (database->template_type == VT_CS_REPEATING_SIGNATURE)
+    {
+        if (repeating->num_signatures > VT_CS_MAX_SIGNATURES)
+        {
+            return VT_ERROR;
+        }
+        codec_encode_u8(cursor, (VT_UINT8)repeating->num_signatures);
+        codec_encode_fixed(cursor, repeating->offset_current);
+        codec_encode_fixed(cursor, repeating->lowest_sample_freq);
+        for (VT_UINT iter = 0; iter < repeating->num_signatures; iter++)
+        {
+            codec_encode_fixed(cursor, repeating->signatures[iter].sampling_freq);
+            codec_encode_fixed(cursor, repeating->signatures[iter].signature_freq);
+            codec_encode_fixed(cursor, repeating->signatures[iter].relative_curr_draw);
+            codec_encode_fixed(cursor, repeating->signatures[iter].duty_cycle);
+        }
+    }
+    else
+    {
+        return VT_ERROR;
+    }
+    return VT_SUCCESS;
+}
+
+static VT_UINT codec_currentsense_template_decode(VT_CODEC_CURSOR* cursor, VT_CURRENTSENSE_DATABASE* decoded)
+{
+    VT_CURRENTSENSE_REPEATING_SIGNATURES_TEMPLATE* repeating = &(decoded->template.repeating_signatures);
+
+    decoded->template_type = codec_decode_u8(cursor);
+    if (decoded->template_type == VT_CS_NON_REPEATING_SIGNATURE)
+    {
+        decoded->template.non_repeating_signature.avg_curr_on  = codec_decode_fixed(cursor);
+        decoded->template.non_repeating_signature.avg_curr_off = codec_decode_fixed(cursor);
+    }
+    else if (decoded->template_type == VT_CS_REPEATING_SIGNATURE)
+    {
+        repeating->num_signatures = codec_decode_u8(cursor);
+        if (repeating->num_signatures > VT_CS_MAX_SIGNATURES)
+        {
+            return VT_ERROR;
+        }
+        repeating->offset_current     = codec_decode_fixed(cursor);
+        repeating->lowest_sample_freq = codec_decode_fixed(cursor);
+        for (VT_UINT iter = 0; iter < repeating->num_signatures; iter++)
+        {
+            repeating->signatures[iter].sampling_freq      = codec_decode_fixed(cursor);
+            repeating->signatures[iter].signature_freq     = codec_decode_fixed(cursor);
+            repeating->signatures[iter].relative_curr_draw = codec_decode_fixed(cursor);
+            repeating->signatures[iter].duty_cycle         = codec_decode_fixed(cursor);
+        }
+    }
+    else
+    {
+        return VT_ERROR;
+    }
+    return VT_SUCCESS;
+}
+
+VT_UINT vt_codec_currentsense_database_encode(
+    VT_CURRENTSENSE_DATABASE* database, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* encoded_size)
+{
+    VT_CODEC_CURSOR cursor;
+
+    codec_encode_begin(&cursor, buffer, buffer_size, VT_CODEC_KIND_CURRENTSENSE);
+    if (codec_currentsense_template_encode(&cursor, database))
+    {
+        return VT_ERROR;
+    }
+    return codec_encode_end(&cursor, encoded_size);
+}
+
+VT_UINT vt_codec_currentsense_database_decode(VT_CURRENTSENSE_DATABASE* database, VT_UCHAR* buffer, VT_ULONG buffer_size)
+{
+    VT_CODEC_CURSOR cursor;
+    VT_CURRENTSENSE_DATABASE decoded = {0};
+
+    if (codec_decode_begin(&cursor, buffer, buffer_size, VT_CODEC_KIND_CURRENTSENSE) ||
+        codec_currentsense_template_decode(&cursor, &decoded) || codec_decode_end(&cursor))
+    {
+        return VT_ERROR;
+    }
+    *database = decoded;
+    return VT_SUCCESS;
+}
+
+VT_UINT vt_codec_currentsense_calibration_encode(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* encoded_size)
+{
+    VT_CODEC_CURSOR cursor;
+    VT_CURRENTSENSE_TEMPLATE_TOLERANCE* tolerance = &(cs_object->template_tolerance);
+    VT_CURRENTSENSE_PRECHECK_BOUNDS* bounds       = &(cs_object->precheck.bounds);
+
+    codec_encode_begin(&cursor, buffer, buffer_size, VT_CODEC_KIND_CURRENTSENSE_CALIBRATION);
+    for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
+    {
+        codec_encode_fixed(&cursor, tolerance->repeating_signature_drift[iter]);
+    }
+    codec_encode_fixed(&cursor, tolerance->offset_current_drift);
+    codec_encode_fixed(&cursor, tolerance->avg_curr_drift);
+
+    codec_encode_u32(&cursor, bounds->num_captures);
+    codec_encode_fixed(&cursor, bounds->on_threshold);
+    codec_encode_fixed(&cursor, bounds->mean_min);
+    codec_encode_fixed(&cursor, bounds->mean_max);
+    codec_encode_fixed(&cursor, bounds->deviation_min);
+    codec_encode_fixed(&cursor, bounds->deviation_max);
+    codec_encode_fixed(&cursor, bounds->on_ratio_min);
+    codec_encode_fixed(&cursor, bounds->on_ratio_max);
+
+    if (codec_currentsense_template_encode(&cursor, &(cs_object->adaptation.baseline)))
+    {
+        return VT_ERROR;
+    }
+    return codec_encode_end(&cursor, encoded_size);
+}
+
+VT_UINT vt_codec_currentsense_calibration_decode(VT_CURRENTSENSE_OBJECT* cs_object, VT_UCHAR* buffer, VT_ULONG buffer_size)
+{
+    VT_CODEC_CURSOR cursor;
+    VT_CURRENTSENSE_TEMPLATE_TOLERANCE tolerance;
+    VT_CURRENTSENSE_PRECHECK_BOUNDS bounds;
+    VT_CURRENTSENSE_DATABASE baseline = {0};
+
+    if (codec_decode_begin(&cursor, buffer, buffer_size, VT_CODEC_KIND_CURRENTSENSE_CALIBRATION))
+    {
+        return VT_ERROR;
+    }
+    for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
+    {
+        tolerance.repeating_signature_drift[iter] = codec_decode_fixed(&cursor);
+    }
+    tolerance.offset_current_drift = codec_decode_fixed(&cursor);
+    tolerance.avg_curr_drift       = codec_decode_fixed(&cursor);
+
+    bounds.num_captures  = (VT_UINT)codec_decode_u32(&cursor);
+    bounds.on_threshold  = codec_decode_fixed(&cursor);
+    bounds.mean_min      = codec_decode_fixed(&cursor);
+    bounds.mean_max      = codec_decode_fixed(&cursor);
+    bounds.deviation_min = codec_decode_fixed(&cursor);
+    bounds.deviation_max = codec_decode_fixed(&cursor);
+    bounds.on_ratio_min  = codec_decode_fixed(&cursor);
+    bounds.on_ratio_max  = codec_decode_fixed(&cursor);
+
+    if (codec_currentsense_template_decode(&cursor, &baseline) || codec_decode_end(&cursor))
+    {
+        return VT_ERROR;
+    }
+    cs_object->template_tolerance  = tolerance;
+    cs_object->precheck.bounds     = bounds;
+    cs_object->adaptation.baseline = baseline;
+    return VT_SUCCESS;
+}
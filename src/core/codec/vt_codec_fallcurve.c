@@ -0,0 +1,80 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_codec_api.h"
+#include "vt_codec_binary.h"
+
+VT_UINT vt_codec_fallcurve_database_encode(
+    VT_FALLCURVE_DATABASE* database, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* encoded_size)
+{
+    VT_CODEC_CURSOR cursor;
+    VT_UINT8 flags = 0;
+
+    if (database->num_signatures > VT_FC_MAX_SIGNATURES ||
+        database->shape_fit > (VT_CODEC_FALLCURVE_FLAG_SHAPE_FIT_MASK >> VT_CODEC_FALLCURVE_FLAG_SHAPE_FIT_SHIFT))
+    {
+        return VT_ERROR;
+    }
+    flags = (VT_UINT8)(database->shape_fit << VT_CODEC_FALLCURVE_FLAG_SHAPE_FIT_SHIFT);
+    for (VT_UINT iter = 0; iter < database->num_signatures; iter++)
+    {
+        if (database->db[iter].risetime)
+        {
+            flags |= VT_CODEC_FALLCURVE_FLAG_RISE_CURVE;
+        }
+    }
+
+    codec_encode_begin(&cursor, buffer, buffer_size, VT_CODEC_KIND_FALLCURVE);
+    codec_encode_u8(&cursor, flags);
+    codec_encode_u8(&cursor, (VT_UINT8)database->num_signatures);
+    for (VT_UINT iter = 0; iter < database->num_signatures; iter++)
+    {
+        codec_encode_u32(&cursor, database->db[iter].sampling_interval_us);
+        codec_encode_u32(&cursor, database->db[iter].falltime);
+        codec_encode_fixed(&cursor, database->db[iter].pearson_coeff);
+        if (flags & VT_CODEC_FALLCURVE_FLAG_RISE_CURVE)
+        {
+            codec_encode_u32(&cursor, database->db[iter].risetime);
+            codec_encode_fixed(&cursor, database->db[iter].rise_pearson_coeff);
+        }
+    }
+
+    return codec_encode_end(&cursor, encoded_size);
+}
+
+VT_UINT vt_codec_fallcurve_database_decode(VT_FALLCURVE_DATABASE* database, VT_UCHAR* buffer, VT_ULONG buffer_size)
+{
+    VT_CODEC_CURSOR cursor;
+    VT_FALLCURVE_DATABASE decoded = {0};
+    VT_UINT8 flags;
+
+    if (codec_decode_begin(&cursor, buffer, buffer_size, VT_CODEC_KIND_FALLCURVE))
+    {
+        return VT_ERROR;
+    }
+
+    flags                  = codec_decode_u8(&cursor);
+    decoded.shape_fit      = (flags & VT_CODEC_FALLCURVE_FLAG_SHAPE_FIT_MASK) >> VT_CODEC_FALLCURVE_FLAG_SHAPE_FIT_SHIFT;
+    decoded.num_signatures = codec_decode_u8(&cursor);
+    if (decoded.num_signatures > VT_FC_MAX_SIGNATURES)
+    {
+        return VT_ERROR;
+    }
+    for (VT_UINT iter = 0; iter < decoded.num_signatures; iter++)
+    {
+        decoded.db[iter].sampling_interval_us = codec_decode_u32(&cursor);
+        decoded.db[iter].falltime             = codec_decode_u32(&cursor);
+        decoded.db[iter].pearson_coeff        = codec_decode_fixed(&cursor);
+        if (flags & VT_CODEC_FALLCURVE_FLAG_RISE_CURVE)
+        {
+            decoded.db[iter].risetime           = codec_decode_u32(&cursor);
+            decoded.db[iter].rise_pearson_coeff = codec_decode_fixed(&cursor);
+        }
+    }
+
+    if (codec_decode_end(&cursor))
+    {
+        return VT_ERROR;
+    }
+    *database = decoded;
+    return VT_SUCCESS;
+}
@@ -0,0 +1,39 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_cs_arena.h"
+#include "vt_debug.h"
+
+#define CS_ARENA_ALIGN(size) ((((size) + sizeof(VT_ULONG) - 1) / sizeof(VT_ULONG)) * sizeof(VT_ULONG))
+
+VT_VOID* cs_arena_alloc(VT_CURRENTSENSE_SCRATCH_ARENA* arena, VT_ULONG size)
+{
+    VT_ULONG aligned_size = CS_ARENA_ALIGN(size);
+    VT_VOID* block;
+
+    if (aligned_size > (sizeof(arena->memory) - arena->used))
+    {
+        VTLogError("Currentsense Scratch Arena Exhausted! \r\n");
+        return NULL;
+    }
+
+    block = (VT_UCHAR*)arena->memory + arena->used;
+    arena->used += aligned_size;
+    if (arena->used > arena->peak)
+    {
+        arena->peak = arena->used;
+    }
+    return block;
+}
+
+VT_ULONG cs_arena_mark(VT_CURRENTSENSE_SCRATCH_ARENA* arena)
+{
+    return arena->used;
+}
+
+VT_VOID cs_arena_release(VT_CURRENTSENSE_SCRATCH_ARENA* arena, VT_ULONG mark)
+{
+    if (mark < arena->used)
+    {
+        arena->used = mark;
+    }
+}
@@ -0,0 +1,142 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_cs_buffer_pool.h"
+#include "vt_cs_calibrate.h"
+#include "vt_cs_database.h"
+#include "vt_debug.h"
+
+#define CS_BUFFER_POOL_ALIGN(size) ((((size) + sizeof(VT_ULONG) - 1) / sizeof(VT_ULONG)) * sizeof(VT_ULONG))
+
+static VT_BOOL cs_raw_signatures_reader_collecting(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    if (cs_object->raw_signatures_reader_initialized == false)
+    {
+        return false;
+    }
+    return (cs_object->raw_signatures_reader->repeating_raw_signature_ongoing_collection ||
+            (cs_object->raw_signatures_reader->non_repeating_raw_signature_stop_collection == false));
+}
+
+VT_UINT cs_raw_signatures_reader_assign(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_CHAR* raw_signatures_buffer, VT_ULONG raw_signatures_buffer_size)
+{
+    VT_ULONG capacity;
+
+    cs_object->raw_signatures_reader_initialized = false;
+
+    if (raw_signatures_buffer == NULL || raw_signatures_buffer_size < VT_CS_RAW_SIGNATURES_BUFFER_SIZE(0))
+    {
+        return VT_ERROR;
+    }
+
+    capacity = (raw_signatures_buffer_size - VT_CS_RAW_SIGNATURES_BUFFER_SIZE(0)) /
+               sizeof(VT_CURRENTSENSE_RAW_SIGNATURE_BUFFER);
+    if (capacity > VT_CS_MAX_SIGNATURES)
+    {
+        capacity = VT_CS_MAX_SIGNATURES;
+    }
+
+    cs_object->raw_signatures_reader = (VT_CURRENTSENSE_RAW_SIGNATURES_READER*)raw_signatures_buffer;
+    cs_object->raw_signatures_reader->repeating_raw_signatures_capacity           = (VT_UINT)capacity;
+    cs_object->raw_signatures_reader->num_repeating_raw_signatures                = 0;
+    cs_object->raw_signatures_reader->repeating_raw_signature_ongoing_collection  = false;
+    cs_object->raw_signatures_reader->repeating_raw_signature_buffers_filled      = false;
+    cs_object->raw_signatures_reader->non_repeating_raw_signature_stop_collection = true;
+    cs_object->raw_signatures_reader->scratch_arena.used                          = 0;
+    cs_object->raw_signatures_reader->scratch_arena.peak                          = 0;
+    cs_object->raw_signatures_reader->precheck_statistics.count                   = 0;
+    cs_object->raw_signatures_reader_initialized                                  = true;
+
+    return VT_SUCCESS;
+}
+
+VT_UINT cs_raw_signatures_required_repeating_buffers(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_FLOAT sampling_frequencies[VT_CS_MAX_SIGNATURES];
+    VT_UINT num_sampling_frequencies = 0;
+
+    if (cs_object->mode == VT_MODE_RUNTIME_EVALUATE)
+    {
+        cs_fetch_template_repeating_signature_sampling_frequencies(
+            cs_object, sampling_frequencies, VT_CS_MAX_SIGNATURES, &num_sampling_frequencies);
+    }
+    else
+    {
+        cs_calibrate_repeating_signatures_compute_sampling_frequencies(
+            cs_object, sampling_frequencies, VT_CS_MAX_SIGNATURES, &num_sampling_frequencies);
+    }
+    return num_sampling_frequencies;
+}
+
+VT_UINT cs_buffer_pool_register(VT_CURRENTSENSE_BUFFER_POOL* buffer_pool, VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    for (VT_UINT iter = 0; iter < buffer_pool->num_objects; iter++)
+    {
+        if (buffer_pool->objects[iter] == cs_object)
+        {
+            return VT_SUCCESS;
+        }
+    }
+    if (buffer_pool->num_objects == VT_CS_BUFFER_POOL_MAX_OBJECTS)
+    {
+        VTLogError("Currentsense Buffer Pool Full! \r\n");
+        return VT_ERROR;
+    }
+    buffer_pool->objects[buffer_pool->num_objects] = cs_object;
+    buffer_pool->num_objects++;
+    cs_object->buffer_pool = buffer_pool;
+    return VT_SUCCESS;
+}
+
+VT_UINT cs_buffer_pool_repack(VT_CURRENTSENSE_BUFFER_POOL* buffer_pool)
+{
+    VT_ULONG region_size[VT_CS_BUFFER_POOL_MAX_OBJECTS];
+    VT_ULONG total_size    = 0;
+    VT_ULONG offset        = 0;
+    VT_BOOL layout_changed = false;
+
+    /* Size every region from what its object needs for its next read */
+    for (VT_UINT iter = 0; iter < buffer_pool->num_objects; iter++)
+    {
+        VT_CURRENTSENSE_OBJECT* cs_object = buffer_pool->objects[iter];
+        VT_UINT required_buffers          = cs_raw_signatures_required_repeating_buffers(cs_object);
+
+        region_size[iter] = CS_BUFFER_POOL_ALIGN(VT_CS_RAW_SIGNATURES_BUFFER_SIZE(required_buffers));
+        if (cs_object->raw_signatures_reader_initialized == false ||
+            (VT_CHAR*)cs_object->raw_signatures_reader != buffer_pool->buffer + total_size ||
+            cs_object->raw_signatures_reader->repeating_raw_signatures_capacity < required_buffers)
+        {
+            layout_changed = true;
+        }
+        total_size += region_size[iter];
+    }
+
+    if (layout_changed == false)
+    {
+        return VT_SUCCESS;
+    }
+
+    if (total_size > buffer_pool->buffer_size)
+    {
+        VTLogError("Currentsense Buffer Pool Overflow! \r\n");
+        return VT_ERROR;
+    }
+
+    /* Readers move, so no object may be mid capture */
+    for (VT_UINT iter = 0; iter < buffer_pool->num_objects; iter++)
+    {
+        if (cs_raw_signatures_reader_collecting(buffer_pool->objects[iter]))
+        {
+            VTLogInfo("Currentsense Buffer Pool repack deferred, signature collection ongoing \r\n");
+            return VT_ERROR;
+        }
+    }
+
+    for (VT_UINT iter = 0; iter < buffer_pool->num_objects; iter++)
+    {
+        cs_raw_signatures_reader_assign(buffer_pool->objects[iter], buffer_pool->buffer + offset, region_size[iter]);
+        offset += region_size[iter];
+    }
+
+    return VT_SUCCESS;
+}
@@ -1,5 +1,6 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
+#include "vt_cs_arena.h"
 #include "vt_cs_calibrate.h"
 #include "vt_cs_fft.h"
 #include "vt_cs_raw_signature_read.h"
@@ -16,33 +17,6 @@ typedef struct SPECTOGRAM_STRUCT
 
 } SPECTOGRAM;
 
-static VT_UINT calculate_fft_ranges()
-{
-    VT_UINT ranges = 1;
-    VT_FLOAT f_low = (VT_CS_ADC_MAX_SAMPLING_FREQ / 2) / VT_CS_SAMPLE_LENGTH;
-    while (true)
-    {
-        if (f_low < VT_CS_FMIN)
-        {
-            break;
-        }
-        f_low /= (((VT_FLOAT)VT_CS_SAMPLE_LENGTH) / 2.0f);
-        ranges++;
-    }
-    return ranges;
-}
-
-static VT_FLOAT get_calib_range_freq(VT_UINT range_id)
-{
-    VT_FLOAT sampling_freq = VT_CS_ADC_MAX_SAMPLING_FREQ / ((VT_FLOAT)pow(VT_CS_FFT_LENGTH, range_id));
-    VT_FLOAT f_min         = sampling_freq / VT_CS_SAMPLE_LENGTH;
-    if (f_min < VT_CS_FMIN)
-    {
-        sampling_freq = VT_CS_FMIN * VT_CS_SAMPLE_LENGTH;
-    }
-    return sampling_freq;
-}
-
 static VT_VOID swap_spectogram_object(SPECTOGRAM* spectogram_object, VT_INT index1, VT_INT index2)
 {
     float frequency_temp                = spectogram_object[index1].frequency;
@@ -87,7 +61,8 @@ static VT_VOID sort_spectogram_amplitude(SPECTOGRAM* spectogram_object, VT_INT s
     }
 }
 
-static VT_VOID remove_harmonics(SPECTOGRAM* spectogram_object, VT_INT start_index, VT_INT samples, VT_FLOAT sampling_frequency)
+static VT_VOID remove_harmonics(
+    const VT_CURRENTSENSE_CALIBRATION_RANGE* range, SPECTOGRAM* spectogram_object, VT_INT start_index, VT_INT samples)
 {
     VT_FLOAT frequency_multiplier    = 0;
     VT_FLOAT frequency_difference    = 0;
@@ -113,8 +88,7 @@ static VT_VOID remove_harmonics(SPECTOGRAM* spectogram_object, VT_INT start_inde
             }
             frequency_difference = fabsf(((VT_FLOAT)round(frequency_multiplier)) - frequency_multiplier);
             frequency_allowed_delta =
-                ((sampling_frequency / (VT_FLOAT)VT_CS_SAMPLE_LENGTH) * ((VT_FLOAT)round(frequency_multiplier))) /
-                spectogram_object[iter1].frequency;
+                (range->bin_width * ((VT_FLOAT)round(frequency_multiplier))) / spectogram_object[iter1].frequency;
             if (frequency_difference < frequency_allowed_delta)
             {
                 spectogram_object[iter1].magnitude += spectogram_object[iter2].magnitude;
@@ -131,8 +105,11 @@ static VT_VOID remove_harmonics(SPECTOGRAM* spectogram_object, VT_INT start_inde
     }
 }
 
-static VT_VOID calculate_top_N_signal_frequencies(
-    SPECTOGRAM* spectogram_object, VT_INT start_index, COMPLEX* signal, VT_FLOAT sampling_frequency)
+static VT_VOID calculate_top_N_signal_frequencies(const VT_CURRENTSENSE_PLAN* plan,
+    const VT_CURRENTSENSE_CALIBRATION_RANGE* range,
+    SPECTOGRAM* spectogram_object,
+    VT_INT start_index,
+    COMPLEX* signal)
 {
 #if VT_LOG_LEVEL > 2
     VT_INT decimal;
@@ -142,7 +119,7 @@ static VT_VOID calculate_top_N_signal_frequencies(
 
     VTLogDebug("Current Signature Raw: \r\n");
 #if VT_LOG_LEVEL > 2
-    for (VT_INT iter = 0; iter < VT_CS_SAMPLE_LENGTH; iter++)
+    for (VT_INT iter = 0; iter < plan->sample_length; iter++)
     {
         decimal    = signal[iter].real;
         frac_float = signal[iter].real - (VT_FLOAT)decimal;
@@ -152,14 +129,14 @@ static VT_VOID calculate_top_N_signal_frequencies(
 #endif /* VT_LOG_LEVEL > 2 */
     VTLogDebugNoTag("\r\n");
 
-    cs_fft_dc_removal(signal, VT_CS_SAMPLE_LENGTH);
-    cs_fft_windowing(signal, VT_CS_SAMPLE_LENGTH, FFT_WIN_TYP_HAMMING, FFT_FORWARD);
-    cs_fft_compute(signal, VT_CS_SAMPLE_LENGTH);
-    cs_fft_complex_to_magnitude(signal, VT_CS_SAMPLE_LENGTH);
+    cs_fft_dc_removal(signal, plan->sample_length);
+    cs_fft_windowing_precomputed(signal, plan->sample_length, plan->hamming_window, FFT_FORWARD);
+    cs_fft_compute(signal, plan->sample_length);
+    cs_fft_complex_to_magnitude(signal, plan->sample_length);
 
     VTLogDebug("FFT: \r\n");
 #if VT_LOG_LEVEL > 2
-    for (VT_INT iter = 0; iter < VT_CS_SAMPLE_LENGTH / 2; iter++)
+    for (VT_INT iter = 0; iter < plan->sample_length / 2; iter++)
     {
         decimal    = signal[iter].real;
         frac_float = signal[iter].real - (VT_FLOAT)decimal;
@@ -170,11 +147,11 @@ static VT_VOID calculate_top_N_signal_frequencies(
     VTLogDebugNoTag("\r\n");
 
     signal[0].real = 0;
-    cs_fft_normalize(signal, VT_CS_SAMPLE_LENGTH);
+    cs_fft_normalize(signal, plan->sample_length);
 
     VTLogDebug("Normalized FFT: \r\n");
 #if VT_LOG_LEVEL > 2
-    for (VT_INT iter = 0; iter < VT_CS_SAMPLE_LENGTH / 2; iter++)
+    for (VT_INT iter = 0; iter < plan->sample_length / 2; iter++)
     {
         decimal    = signal[iter].real;
         frac_float = signal[iter].real - (VT_FLOAT)decimal;
@@ -190,7 +167,7 @@ static VT_VOID calculate_top_N_signal_frequencies(
     VT_FLOAT average_of_peak_neighbour = 0;
     for (VT_INT iter = 0; iter < VT_CS_MAX_TEST_FREQUENCIES; iter++)
     {
-        cs_fft_major_peak(signal, VT_CS_SAMPLE_LENGTH, sampling_frequency, &frequency, &frequency_magnitude, &peak_index);
+        cs_fft_major_peak(signal, plan->sample_length, range->sampling_freq, &frequency, &frequency_magnitude, &peak_index);
         spectogram_object[start_index + iter].frequency = frequency;
         spectogram_object[start_index + iter].magnitude = frequency_magnitude;
         if (peak_index == 0)
@@ -199,7 +176,7 @@ static VT_VOID calculate_top_N_signal_frequencies(
             signal[peak_index].real     = average_of_peak_neighbour;
             signal[peak_index + 1].real = average_of_peak_neighbour;
         }
-        else if (peak_index == (VT_CS_SAMPLE_LENGTH - 1))
+        else if (peak_index == (plan->sample_length - 1))
         {
             average_of_peak_neighbour   = (signal[peak_index].real + signal[peak_index - 1].real) / 2.0f;
             signal[peak_index].real     = average_of_peak_neighbour;
@@ -230,7 +207,7 @@ static VT_VOID calculate_top_N_signal_frequencies(
     }
 #endif /* VT_LOG_LEVEL > 2 */
 
-    remove_harmonics(spectogram_object, start_index, VT_CS_MAX_TEST_FREQUENCIES, sampling_frequency);
+    remove_harmonics(range, spectogram_object, start_index, VT_CS_MAX_TEST_FREQUENCIES);
 
     VTLogDebug("Test Frequencies after Harmonic Removal: \r\n");
 #if VT_LOG_LEVEL > 2
@@ -248,9 +225,9 @@ static VT_VOID calculate_top_N_signal_frequencies(
 #endif /* VT_LOG_LEVEL > 2 */
 }
 
-static VT_FLOAT get_raw_signature_sample_freq(VT_FLOAT signal_freq)
+static VT_FLOAT get_raw_signature_sample_freq(const VT_CURRENTSENSE_PLAN* plan, VT_FLOAT signal_freq)
 {
-    VT_FLOAT sample_freq = signal_freq * (VT_CS_SAMPLE_LENGTH / VT_CS_CALIB_MINIMUM_CYCLES);
+    VT_FLOAT sample_freq = signal_freq * plan->signature_sampling_factor;
     if (sample_freq > VT_CS_ADC_MAX_SAMPLING_FREQ)
     {
         sample_freq = VT_CS_ADC_MAX_SAMPLING_FREQ;
@@ -263,15 +240,14 @@ VT_VOID cs_calibrate_repeating_signatures_compute_sampling_frequencies(VT_CURREN
     VT_UINT sampling_frequencies_buffer_length,
     VT_UINT* num_sampling_frequencies)
 {
-    VT_UINT8 fft_ranges       = calculate_fft_ranges();
     *num_sampling_frequencies = 0;
-    for (VT_UINT iter = 0; iter < fft_ranges; iter++)
+    for (VT_UINT iter = 0; iter < cs_object->plan.num_calibration_ranges; iter++)
     {
         if (iter == sampling_frequencies_buffer_length)
         {
             break;
         }
-        sampling_frequencies[iter] = get_calib_range_freq(iter);
+        sampling_frequencies[iter] = cs_object->plan.calibration_ranges[iter].sampling_freq;
         *num_sampling_frequencies  = *num_sampling_frequencies + 1;
     }
 }
@@ -286,36 +262,43 @@ VT_VOID cs_calibrate_repeating_signatures_compute_collection_settings(
 #endif /* VT_LOG_LEVEL > 2 */
 
     VTLogInfo("\tComputing Currentsense Collection Settings\n");
-    SPECTOGRAM spectogram_calib[VT_CS_MAX_TEST_FREQUENCIES];
+    const VT_CURRENTSENSE_PLAN* plan     = &(cs_object->plan);
+    VT_CURRENTSENSE_SCRATCH_ARENA* arena = &cs_object->raw_signatures_reader->scratch_arena;
+    VT_ULONG arena_mark                  = cs_arena_mark(arena);
+    SPECTOGRAM* spectogram_calib         = (SPECTOGRAM*)cs_arena_alloc(arena, VT_CS_MAX_TEST_FREQUENCIES * sizeof(SPECTOGRAM));
+    SPECTOGRAM* spectogram_calib_fetch   = (SPECTOGRAM*)cs_arena_alloc(arena, VT_CS_MAX_TEST_FREQUENCIES * sizeof(SPECTOGRAM));
+    COMPLEX* signal                      = (COMPLEX*)cs_arena_alloc(arena, plan->sample_length * sizeof(COMPLEX));
+    if (spectogram_calib == NULL || spectogram_calib_fetch == NULL || signal == NULL)
+    {
+        cs_arena_release(arena, arena_mark);
+        return;
+    }
     for (VT_UINT iter = 0; iter < VT_CS_MAX_TEST_FREQUENCIES; iter++)
     {
         spectogram_calib[iter].magnitude = 0;
         spectogram_calib[iter].frequency = 0;
     }
-    VT_UINT calib_ranges                          = calculate_fft_ranges();
-    VT_FLOAT adc_read_signal[VT_CS_SAMPLE_LENGTH] = {0};
-    COMPLEX signal[VT_CS_SAMPLE_LENGTH];
-    for (VT_UINT iter = 0; iter < VT_CS_SAMPLE_LENGTH; iter++)
+    VT_CURRENTSENSE_RAW_SIGNATURE_VIEW adc_read_signal;
+    for (VT_UINT iter = 0; iter < plan->sample_length; iter++)
     {
         signal[iter].imag = 0;
         signal[iter].real = 0;
     }
-    SPECTOGRAM spectogram_calib_fetch[VT_CS_FFT_LENGTH];
-    for (VT_INT iter = 0; iter < calib_ranges; iter++)
+    for (VT_INT iter = 0; iter < plan->num_calibration_ranges; iter++)
     {
 
-        if (cs_repeating_raw_signature_fetch_stored_current_measurement(
-                cs_object, adc_read_signal, get_calib_range_freq(iter), VT_CS_SAMPLE_LENGTH))
+        if (cs_repeating_raw_signature_view(cs_object, iter, plan->calibration_ranges[iter].sampling_freq, &adc_read_signal) ||
+            adc_read_signal.sample_length != plan->sample_length)
         {
             continue;
         }
         // [TODO] Add Digital Filter
-        for (VT_INT iter1 = 0; iter1 < VT_CS_SAMPLE_LENGTH; iter1++)
+        for (VT_INT iter1 = 0; iter1 < plan->sample_length; iter1++)
         {
-            signal[iter1].real = adc_read_signal[iter1];
+            signal[iter1].real = adc_read_signal.current_measured[iter1];
             signal[iter1].imag = 0;
         }
-        calculate_top_N_signal_frequencies(spectogram_calib_fetch, 0, signal, get_calib_range_freq(iter));
+        calculate_top_N_signal_frequencies(plan, &(plan->calibration_ranges[iter]), spectogram_calib_fetch, 0, signal);
         for (VT_INT iter1 = 0; iter1 < VT_CS_MAX_TEST_FREQUENCIES; iter1++)
         {
             for (VT_INT iter2 = 0; iter2 < VT_CS_MAX_TEST_FREQUENCIES; iter2++)
@@ -355,10 +338,11 @@ VT_VOID cs_calibrate_repeating_signatures_compute_collection_settings(
         {
             break;
         }
-        top_N_sample_frequencies[iter] = get_raw_signature_sample_freq(spectogram_calib[iter].frequency);
+        top_N_sample_frequencies[iter] = get_raw_signature_sample_freq(plan, spectogram_calib[iter].frequency);
         if (top_N_sample_frequencies[iter] < *lowest_sample_freq)
         {
             *lowest_sample_freq = top_N_sample_frequencies[iter];
         }
     }
+    cs_arena_release(arena, arena_mark);
 }
\ No newline at end of file
@@ -1,16 +1,18 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
 #include "vt_cs_api.h"
+#include "vt_cs_arena.h"
 #include "vt_cs_calibrate.h"
 #include "vt_cs_database.h"
+#include "vt_cs_precheck.h"
 #include "vt_cs_raw_signature_read.h"
+#include "vt_cs_sensor_status.h"
 #include "vt_cs_signature_features.h"
 #include "vt_debug.h"
 #include <math.h>
 
-static VT_UINT cs_calibrate_repeating_signature_template(VT_CURRENTSENSE_OBJECT* cs_object)
+static VT_UINT cs_calibrate_repeating_signature_template(VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* raw_signature)
 {
-    VT_FLOAT raw_signature[VT_CS_SAMPLE_LENGTH]            = {0};
     VT_FLOAT top_N_frequencies[VT_CS_MAX_TEST_FREQUENCIES] = {0};
     VT_FLOAT lowest_sample_freq                            = VT_CS_ADC_MAX_SAMPLING_FREQ;
     cs_calibrate_repeating_signatures_compute_collection_settings(cs_object, top_N_frequencies, &lowest_sample_freq);
@@ -34,7 +36,7 @@ static VT_UINT cs_calibrate_repeating_signature_template(VT_CURRENTSENSE_OBJECT*
         }
 
         if (cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_calibration(
-                cs_object, raw_signature, top_N_frequencies[iter], VT_CS_SAMPLE_LENGTH))
+                cs_object, raw_signature, top_N_frequencies[iter], cs_object->plan.sample_length))
         {
             VTLogDebug("Error in fetching extrapolated raw signature! \r\n");
             continue;
@@ -42,7 +44,7 @@ static VT_UINT cs_calibrate_repeating_signature_template(VT_CURRENTSENSE_OBJECT*
 
         if (cs_repeating_signature_feature_vector_compute(cs_object,
                 raw_signature,
-                VT_CS_SAMPLE_LENGTH,
+                cs_object->plan.sample_length,
                 top_N_frequencies[iter],
                 &signal_freq,
                 &duty_cycle,
@@ -74,12 +76,12 @@ static VT_UINT cs_calibrate_repeating_signature_template(VT_CURRENTSENSE_OBJECT*
     }
 
     if (cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_calibration(
-            cs_object, raw_signature, lowest_sample_freq, VT_CS_SAMPLE_LENGTH))
+            cs_object, raw_signature, lowest_sample_freq, cs_object->plan.sample_length))
     {
         return VT_ERROR;
     }
 
-    if (cs_repeating_signature_offset_current_compute(cs_object, raw_signature, VT_CS_SAMPLE_LENGTH, &offset_current))
+    if (cs_repeating_signature_offset_current_compute(cs_object, raw_signature, cs_object->plan.sample_length, &offset_current))
     {
         VTLogDebug("Error in computing offset current feature! \r\n");
         return VT_ERROR;
@@ -87,14 +89,12 @@ static VT_UINT cs_calibrate_repeating_signature_template(VT_CURRENTSENSE_OBJECT*
 
     cs_update_repeating_signature_offset_current_draw(cs_object, lowest_sample_freq, offset_current);
     VTLogDebug("Offset current feature stored! \r\n");
-    cs_object->template_confidence_metric = 100;
 
     return VT_SUCCESS;
 }
 
-static VT_UINT cs_recalibrate_repeating_signature_template(VT_CURRENTSENSE_OBJECT* cs_object)
+static VT_UINT cs_recalibrate_repeating_signature_template(VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* raw_signature)
 {
-    VT_FLOAT raw_signature[VT_CS_SAMPLE_LENGTH]            = {0};
     VT_FLOAT top_N_frequencies[VT_CS_MAX_TEST_FREQUENCIES] = {0};
     VT_FLOAT lowest_sample_freq                            = VT_CS_ADC_MAX_SAMPLING_FREQ;
     cs_calibrate_repeating_signatures_compute_collection_settings(cs_object, top_N_frequencies, &lowest_sample_freq);
@@ -118,14 +118,14 @@ static VT_UINT cs_recalibrate_repeating_signature_template(VT_CURRENTSENSE_OBJEC
         }
 
         if (cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_calibration(
-                cs_object, raw_signature, top_N_frequencies[iter], VT_CS_SAMPLE_LENGTH))
+                cs_object, raw_signature, top_N_frequencies[iter], cs_object->plan.sample_length))
         {
             continue;
         }
 
         if (cs_repeating_signature_feature_vector_compute(cs_object,
                 raw_signature,
-                VT_CS_SAMPLE_LENGTH,
+                cs_object->plan.sample_length,
                 top_N_frequencies[iter],
                 &signal_freq,
                 &duty_cycle,
@@ -149,35 +149,50 @@ static VT_UINT cs_recalibrate_repeating_signature_template(VT_CURRENTSENSE_OBJEC
     }
 
     if (cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_calibration(
-            cs_object, raw_signature, lowest_sample_freq, VT_CS_SAMPLE_LENGTH))
+            cs_object, raw_signature, lowest_sample_freq, cs_object->plan.sample_length))
     {
         return VT_ERROR;
     }
 
-    if (cs_repeating_signature_offset_current_compute(cs_object, raw_signature, VT_CS_SAMPLE_LENGTH, &offset_current))
+    if (cs_repeating_signature_offset_current_compute(cs_object, raw_signature, cs_object->plan.sample_length, &offset_current))
     {
         return VT_ERROR;
     }
 
     cs_update_repeating_signature_offset_current_draw(cs_object, lowest_sample_freq, offset_current);
-    cs_object->template_confidence_metric = 100;
 
     return VT_SUCCESS;
 }
 
+static VT_UINT cs_repeating_signature_template_update(VT_CURRENTSENSE_OBJECT* cs_object,
+    VT_UINT (*repeating_signature_template_update)(VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* raw_signature))
+{
+    VT_CURRENTSENSE_SCRATCH_ARENA* arena = &cs_object->raw_signatures_reader->scratch_arena;
+    VT_ULONG arena_mark                  = cs_arena_mark(arena);
+    VT_FLOAT* raw_signature              = NULL;
+    VT_UINT status                       = VT_ERROR;
+
+    /* Extrapolated raw signature stays allocated while collection settings and features use the arena above it */
+    raw_signature = (VT_FLOAT*)cs_arena_alloc(arena, cs_object->plan.sample_length * sizeof(VT_FLOAT));
+    if (raw_signature)
+    {
+        status = repeating_signature_template_update(cs_object, raw_signature);
+    }
+
+    cs_arena_release(arena, arena_mark);
+    return status;
+}
+
 static VT_UINT cs_calibrate_non_repeating_signature_template(VT_CURRENTSENSE_OBJECT* cs_object)
 {
-    VT_FLOAT raw_signature[VT_CS_SAMPLE_LENGTH] = {0};
-    VT_FLOAT sampling_frequency                 = 0;
-    VT_UINT num_datapoints                      = 0;
-    VT_FLOAT avg_curr_on                        = 0;
-    VT_FLOAT avg_curr_off                       = 0;
+    VT_CURRENTSENSE_RAW_SIGNATURE_VIEW raw_signature;
+    VT_FLOAT avg_curr_on  = 0;
+    VT_FLOAT avg_curr_off = 0;
 
-    if (cs_non_repeating_raw_signature_fetch_stored_current_measurement(
-            cs_object, raw_signature, &sampling_frequency, &num_datapoints) == VT_SUCCESS)
+    if (cs_non_repeating_raw_signature_view(cs_object, &raw_signature) == VT_SUCCESS)
     {
         if (cs_non_repeating_signature_average_current_compute(
-                cs_object, raw_signature, num_datapoints, &avg_curr_on, &avg_curr_off))
+                cs_object, raw_signature.current_measured, raw_signature.sample_length, &avg_curr_on, &avg_curr_off))
         {
             return VT_ERROR;
         }
@@ -186,59 +201,143 @@ static VT_UINT cs_calibrate_non_repeating_signature_template(VT_CURRENTSENSE_OBJ
     cs_reset_db(cs_object);
 
     cs_update_non_repeating_signature_average_current_draw(cs_object, avg_curr_on, avg_curr_off);
-    cs_object->template_confidence_metric = 100;
 
     return VT_SUCCESS;
 }
 
 static VT_UINT cs_recalibrate_non_repeating_signature_template(VT_CURRENTSENSE_OBJECT* cs_object)
 {
-    VT_FLOAT raw_signature[VT_CS_SAMPLE_LENGTH] = {0};
-    VT_FLOAT sampling_frequency                 = 0;
-    VT_UINT num_datapoints                      = 0;
-    VT_FLOAT avg_curr_on                        = 0;
-    VT_FLOAT avg_curr_off                       = 0;
+    VT_CURRENTSENSE_RAW_SIGNATURE_VIEW raw_signature;
+    VT_FLOAT avg_curr_on  = 0;
+    VT_FLOAT avg_curr_off = 0;
 
-    if (cs_non_repeating_raw_signature_fetch_stored_current_measurement(
-            cs_object, raw_signature, &sampling_frequency, &num_datapoints) == VT_SUCCESS)
+    if (cs_non_repeating_raw_signature_view(cs_object, &raw_signature) == VT_SUCCESS)
     {
         if (cs_non_repeating_signature_average_current_compute(
-                cs_object, raw_signature, num_datapoints, &avg_curr_on, &avg_curr_off))
+                cs_object, raw_signature.current_measured, raw_signature.sample_length, &avg_curr_on, &avg_curr_off))
         {
             return VT_ERROR;
         }
     }
 
     cs_update_non_repeating_signature_average_current_draw(cs_object, avg_curr_on, avg_curr_off);
-    cs_object->template_confidence_metric = 100;
 
     return VT_SUCCESS;
 }
 
-VT_VOID cs_calibrate_sensor(VT_CURRENTSENSE_OBJECT* cs_object)
+static VT_UINT cs_calibration_capture_accumulate(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_CURRENTSENSE_CALIBRATION* calibration = &(cs_object->calibration);
+
+    if (cs_object->fingerprintdb.template_type == VT_CS_NON_REPEATING_SIGNATURE)
+    {
+        cs_calibration_statistics_non_repeating_accumulate(cs_object);
+    }
+    else
+    {
+        cs_repeating_signature_template_update(cs_object, &cs_calibration_statistics_repeating_accumulate);
+    }
+    cs_precheck_calibration_accumulate(cs_object);
+    calibration->num_captures++;
+
+    if (calibration->num_captures < calibration->num_captures_required)
+    {
+        /* Template is only reported once every capture has been averaged into it */
+        cs_object->db_updated = VT_DB_NOT_UPDATED;
+        VTLogInfo("Calibration capture %d of %d done\r\n", calibration->num_captures, calibration->num_captures_required);
+        return calibration->num_captures_required - calibration->num_captures;
+    }
+
+    cs_calibration_statistics_finalize(cs_object);
+    return 0;
+}
+
+VT_UINT cs_calibrate_sensor(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_UINT captures_remaining;
+
+    cs_sensor_status_provisional(cs_object, false);
+    if (cs_object->calibration.num_captures == 0)
+    {
+        cs_calibration_statistics_reset(cs_object);
+        if (cs_repeating_signature_template_update(cs_object, &cs_calibrate_repeating_signature_template))
+        {
+            if (cs_calibrate_non_repeating_signature_template(cs_object))
+            {
+                VTLogInfo("Error calibrating sensor\r\n");
+                return 0;
+            }
+        }
+    }
+    captures_remaining = cs_calibration_capture_accumulate(cs_object);
+    if (captures_remaining == 0)
+    {
+        VTLogInfo("Successfully calibrated sensor\r\n");
+    }
+    return captures_remaining;
+}
+
+VT_UINT cs_recalibrate_sensor(VT_CURRENTSENSE_OBJECT* cs_object)
 {
-    if (cs_calibrate_repeating_signature_template(cs_object))
+    VT_UINT captures_remaining;
+
+    cs_sensor_status_provisional(cs_object, false);
+    if (cs_object->calibration.num_captures == 0)
     {
-        if (cs_calibrate_non_repeating_signature_template(cs_object))
+        cs_calibration_statistics_reset(cs_object);
+        if (cs_repeating_signature_template_update(cs_object, &cs_recalibrate_repeating_signature_template))
         {
-            VTLogInfo("Error calibrating sensor\r\n");
-            return;
+            if (cs_recalibrate_non_repeating_signature_template(cs_object))
+            {
+                VTLogInfo("Error re-calibrating sensor\r\n");
+                return 0;
+            }
         }
     }
-    VTLogInfo("Successfully calibrated sensor\r\n");
-    return;
+    captures_remaining = cs_calibration_capture_accumulate(cs_object);
+    if (captures_remaining == 0)
+    {
+        VTLogInfo("Successfully re-calibrated sensor\r\n");
+    }
+    return captures_remaining;
 }
 
-VT_VOID cs_recalibrate_sensor(VT_CURRENTSENSE_OBJECT* cs_object)
+VT_UINT cs_calibrate_sensor_partial(VT_CURRENTSENSE_OBJECT* cs_object)
 {
-    if (cs_recalibrate_repeating_signature_template(cs_object))
+    VT_CURRENTSENSE_RAW_SIGNATURES_READER* reader = cs_object->raw_signatures_reader;
+    VT_UINT num_ranges                            = reader->num_repeating_raw_signatures;
+    VT_UINT ranges_filled                         = 0;
+
+    /* Later captures and recalibration keep the template they are checked against until the capture completes */
+    if (cs_object->mode == VT_MODE_RECALIBRATE || cs_object->calibration.num_captures)
     {
-        if (cs_recalibrate_non_repeating_signature_template(cs_object))
+        return cs_sensor_status_provisional(cs_object, true);
+    }
+
+    /* While calibrating, the reader buffers hold one calibration range each */
+    for (VT_UINT iter = 0; iter < num_ranges; iter++)
+    {
+        if (cs_repeating_raw_signature_buffer_filled(cs_object, iter, reader->repeating_raw_signatures[iter].sampling_frequency))
         {
-            VTLogInfo("Error re-calibrating sensor\r\n");
-            return;
+            ranges_filled++;
         }
     }
-    VTLogInfo("Successfully re-calibrated sensor\r\n");
-    return;
+
+    if (ranges_filled == 0 || ranges_filled == reader->calibration_ranges_processed)
+    {
+        return num_ranges - ranges_filled;
+    }
+    reader->calibration_ranges_processed = ranges_filled;
+
+    /* Features are extracted only from ranges read so far, slower ranges refine the template as they fill */
+    cs_repeating_signature_template_update(cs_object, &cs_calibrate_repeating_signature_template);
+    if (cs_object->fingerprintdb.template_type == VT_CS_REPEATING_SIGNATURE &&
+        cs_object->fingerprintdb.template.repeating_signatures.num_signatures)
+    {
+        cs_object->template_confidence_metric = (VT_CS_PROVISIONAL_TEMPLATE_CONFIDENCE * ranges_filled) / num_ranges;
+        cs_object->db_updated                 = VT_DB_UPDATED;
+        VTLogInfo("Provisional template from %d of %d calibration ranges\r\n", ranges_filled, num_ranges);
+    }
+
+    return num_ranges - ranges_filled;
 }
\ No newline at end of file
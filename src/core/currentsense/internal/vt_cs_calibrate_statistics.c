@@ -0,0 +1,248 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_cs_api.h"
+#include "vt_cs_calibrate.h"
+#include "vt_cs_database.h"
+#include "vt_cs_precheck.h"
+#include "vt_cs_raw_signature_read.h"
+#include "vt_cs_signature_features.h"
+#include "vt_cs_template_adapt.h"
+#include "vt_debug.h"
+#include <math.h>
+
+static VT_VOID cs_feature_statistics_reset(VT_CURRENTSENSE_FEATURE_STATISTICS* statistics)
+{
+    statistics->count = 0;
+    statistics->mean  = 0;
+    statistics->m2    = 0;
+}
+
+static VT_VOID cs_feature_statistics_update(VT_CURRENTSENSE_FEATURE_STATISTICS* statistics, VT_FLOAT value)
+{
+    VT_FLOAT delta = value - statistics->mean;
+
+    statistics->count++;
+    statistics->mean += delta / statistics->count;
+    statistics->m2 += delta * (value - statistics->mean);
+}
+
+/* Spread (%) of a feature as VT_CS_CALIB_TOLERANCE_SIGMA standard deviations relative to its mean, max_spread when a
+ * single capture leaves it unknown */
+static VT_FLOAT cs_feature_statistics_spread(const VT_CURRENTSENSE_FEATURE_STATISTICS* statistics, VT_FLOAT max_spread)
+{
+    VT_FLOAT standard_deviation;
+
+    if (statistics->count < 2 || statistics->mean == 0)
+    {
+        return max_spread;
+    }
+    standard_deviation = sqrtf(statistics->m2 / (statistics->count - 1));
+
+    return (VT_CS_CALIB_TOLERANCE_SIGMA * standard_deviation * 100.0f) / fabsf(statistics->mean);
+}
+
+static VT_FLOAT cs_tolerance_from_spread(VT_FLOAT spread, VT_FLOAT min_tolerance, VT_FLOAT max_tolerance)
+{
+    if (spread < min_tolerance)
+    {
+        return min_tolerance;
+    }
+    if (spread > max_tolerance)
+    {
+        return max_tolerance;
+    }
+    return spread;
+}
+
+VT_VOID cs_calibration_statistics_reset(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_CURRENTSENSE_CALIBRATION* calibration = &(cs_object->calibration);
+
+    calibration->num_captures = 0;
+    for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
+    {
+        cs_feature_statistics_reset(&(calibration->signature_freq[iter]));
+        cs_feature_statistics_reset(&(calibration->relative_curr_draw[iter]));
+        cs_feature_statistics_reset(&(calibration->duty_cycle[iter]));
+    }
+    cs_feature_statistics_reset(&(calibration->offset_current));
+    cs_feature_statistics_reset(&(calibration->avg_curr_on));
+    cs_feature_statistics_reset(&(calibration->avg_curr_off));
+    cs_precheck_bounds_reset(&(calibration->precheck));
+}
+
+VT_UINT cs_calibration_statistics_repeating_accumulate(VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* raw_signature)
+{
+    VT_CURRENTSENSE_CALIBRATION* calibration = &(cs_object->calibration);
+    VT_FLOAT sampling_frequency;
+    VT_FLOAT signature_frequency;
+    VT_FLOAT duty_cycle;
+    VT_FLOAT relative_current_draw;
+    VT_FLOAT lowest_sample_freq;
+    VT_FLOAT offset_current;
+
+    /* Features are measured at the sampling frequencies the first capture chose for the template */
+    for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
+    {
+        if (cs_fetch_template_repeating_signature_feature_vector(
+                cs_object, iter, &sampling_frequency, &signature_frequency, &duty_cycle, &relative_current_draw))
+        {
+            break;
+        }
+
+        if (cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_calibration(
+                cs_object, raw_signature, sampling_frequency, cs_object->plan.sample_length))
+        {
+            continue;
+        }
+
+        if (cs_repeating_signature_feature_vector_compute(cs_object,
+                raw_signature,
+                cs_object->plan.sample_length,
+                sampling_frequency,
+                &signature_frequency,
+                &duty_cycle,
+                &relative_current_draw))
+        {
+            VTLogDebug("Error in computing feature vector for calibration statistics! \r\n");
+            continue;
+        }
+
+        cs_feature_statistics_update(&(calibration->signature_freq[iter]), signature_frequency);
+        cs_feature_statistics_update(&(calibration->relative_curr_draw[iter]), relative_current_draw);
+        cs_feature_statistics_update(&(calibration->duty_cycle[iter]), duty_cycle);
+    }
+
+    if (cs_fetch_template_repeating_signature_offset_current(cs_object, &lowest_sample_freq, &offset_current))
+    {
+        return VT_SUCCESS;
+    }
+
+    if (cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_calibration(
+            cs_object, raw_signature, lowest_sample_freq, cs_object->plan.sample_length) == VT_SUCCESS &&
+        cs_repeating_signature_offset_current_compute(cs_object, raw_signature, cs_object->plan.sample_length, &offset_current) ==
+            VT_SUCCESS)
+    {
+        cs_feature_statistics_update(&(calibration->offset_current), offset_current);
+    }
+
+    return VT_SUCCESS;
+}
+
+VT_UINT cs_calibration_statistics_non_repeating_accumulate(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_CURRENTSENSE_RAW_SIGNATURE_VIEW raw_signature;
+    VT_FLOAT avg_curr_on  = 0;
+    VT_FLOAT avg_curr_off = 0;
+
+    if (cs_non_repeating_raw_signature_view(cs_object, &raw_signature))
+    {
+        return VT_ERROR;
+    }
+
+    if (cs_non_repeating_signature_average_current_compute(
+            cs_object, raw_signature.current_measured, raw_signature.sample_length, &avg_curr_on, &avg_curr_off))
+    {
+        return VT_ERROR;
+    }
+
+    cs_feature_statistics_update(&(cs_object->calibration.avg_curr_on), avg_curr_on);
+    cs_feature_statistics_update(&(cs_object->calibration.avg_curr_off), avg_curr_off);
+
+    return VT_SUCCESS;
+}
+
+static VT_FLOAT cs_calibration_statistics_repeating_finalize(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_CURRENTSENSE_CALIBRATION* calibration                = &(cs_object->calibration);
+    VT_CURRENTSENSE_REPEATING_SIGNATURES_TEMPLATE* template = &(cs_object->fingerprintdb.template.repeating_signatures);
+    VT_FLOAT spread;
+    VT_FLOAT spread_sum = 0;
+    VT_UINT num_spreads = 0;
+
+    for (VT_UINT iter = 0; iter < template->num_signatures; iter++)
+    {
+        if (calibration->signature_freq[iter].count)
+        {
+            template->signatures[iter].signature_freq     = calibration->signature_freq[iter].mean;
+            template->signatures[iter].relative_curr_draw = calibration->relative_curr_draw[iter].mean;
+            template->signatures[iter].duty_cycle         = calibration->duty_cycle[iter].mean;
+        }
+
+        /* Matches cs_repeating_signature_feature_vector_evaluate, which averages the drift of all three features */
+        spread = (cs_feature_statistics_spread(&(calibration->signature_freq[iter]), VT_CS_MAX_SIGNATURE_DRIFT) +
+                     cs_feature_statistics_spread(&(calibration->relative_curr_draw[iter]), VT_CS_MAX_SIGNATURE_DRIFT) +
+                     cs_feature_statistics_spread(&(calibration->duty_cycle[iter]), VT_CS_MAX_SIGNATURE_DRIFT)) /
+                 3.0f;
+        cs_object->template_tolerance.repeating_signature_drift[iter] =
+            cs_tolerance_from_spread(spread, VT_CS_MIN_SIGNATURE_DRIFT, VT_CS_MAX_SIGNATURE_DRIFT);
+        spread_sum += spread;
+        num_spreads++;
+    }
+
+    if (template->offset_current != VT_DATA_NOT_AVAILABLE)
+    {
+        if (calibration->offset_current.count)
+        {
+            template->offset_current = calibration->offset_current.mean;
+        }
+        spread = cs_feature_statistics_spread(&(calibration->offset_current), VT_CS_MAX_AVG_CURR_DRIFT);
+        cs_object->template_tolerance.offset_current_drift =
+            cs_tolerance_from_spread(spread, VT_CS_MIN_AVG_CURR_DRIFT, VT_CS_MAX_AVG_CURR_DRIFT);
+        spread_sum += spread;
+        num_spreads++;
+    }
+
+    return num_spreads ? (spread_sum / num_spreads) : VT_CS_MAX_SIGNATURE_DRIFT;
+}
+
+static VT_FLOAT cs_calibration_statistics_non_repeating_finalize(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_CURRENTSENSE_CALIBRATION* calibration                  = &(cs_object->calibration);
+    VT_CURRENTSENSE_NON_REPEATING_SIGNATURE_TEMPLATE* template = &(cs_object->fingerprintdb.template.non_repeating_signature);
+    VT_FLOAT spread;
+
+    if (calibration->avg_curr_on.count)
+    {
+        template->avg_curr_on  = calibration->avg_curr_on.mean;
+        template->avg_curr_off = calibration->avg_curr_off.mean;
+    }
+
+    /* Matches cs_non_repeating_signature_average_current_evaluate, which averages the on and off drift */
+    spread = (cs_feature_statistics_spread(&(calibration->avg_curr_on), VT_CS_MAX_AVG_CURR_DRIFT) +
+                 cs_feature_statistics_spread(&(calibration->avg_curr_off), VT_CS_MAX_AVG_CURR_DRIFT)) /
+             2.0f;
+    cs_object->template_tolerance.avg_curr_drift =
+        cs_tolerance_from_spread(spread, VT_CS_MIN_AVG_CURR_DRIFT, VT_CS_MAX_AVG_CURR_DRIFT);
+
+    return spread;
+}
+
+VT_VOID cs_calibration_statistics_finalize(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_FLOAT spread;
+
+    if (cs_object->fingerprintdb.template_type == VT_CS_NON_REPEATING_SIGNATURE)
+    {
+        spread = cs_calibration_statistics_non_repeating_finalize(cs_object);
+    }
+    else
+    {
+        spread = cs_calibration_statistics_repeating_finalize(cs_object);
+    }
+
+    /* A template whose features did not move between captures is fully trusted */
+    cs_object->template_confidence_metric = (VT_UINT8)(100.0f - cs_tolerance_from_spread(spread, 0, 100.0f));
+    cs_object->db_updated                 = VT_DB_UPDATED;
+    cs_template_adaptation_baseline_set(cs_object);
+    cs_precheck_calibration_finalize(cs_object);
+
+#if VT_LOG_LEVEL > 2
+    int32_t decimal  = spread;
+    float frac_float = spread - (float)decimal;
+    int32_t frac     = frac_float * 10000;
+    VTLogDebug("Calibration spread over %d captures: %d.%04d \r\n", cs_object->calibration.num_captures, decimal, frac);
+#endif /* VT_LOG_LEVEL > 2 */
+
+    cs_calibration_statistics_reset(cs_object);
+}
@@ -1,6 +1,17 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
 #include "vt_cs_database.h"
+#include "vt_cs_precheck.h"
+
+VT_VOID cs_reset_template_tolerance(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
+    {
+        cs_object->template_tolerance.repeating_signature_drift[iter] = VT_CS_MAX_SIGNATURE_DRIFT;
+    }
+    cs_object->template_tolerance.offset_current_drift = VT_CS_MAX_AVG_CURR_DRIFT;
+    cs_object->template_tolerance.avg_curr_drift       = VT_CS_MAX_AVG_CURR_DRIFT;
+}
 
 VT_VOID cs_reset_db(VT_CURRENTSENSE_OBJECT* cs_object)
 {
@@ -10,4 +21,8 @@ VT_VOID cs_reset_db(VT_CURRENTSENSE_OBJECT* cs_object)
     cs_object->fingerprintdb.template.repeating_signatures.offset_current     = VT_DATA_NOT_AVAILABLE;
     cs_object->fingerprintdb.template.non_repeating_signature.avg_curr_on     = VT_DATA_NOT_AVAILABLE;
     cs_object->fingerprintdb.template.non_repeating_signature.avg_curr_off    = VT_DATA_NOT_AVAILABLE;
+
+    cs_reset_template_tolerance(cs_object);
+
+    cs_precheck_bounds_reset(&(cs_object->precheck.bounds));
 }
\ No newline at end of file
@@ -254,65 +254,91 @@ VT_VOID cs_fft_dc_removal(COMPLEX* Y, VT_UINT N)
     }
 }
 
+static VT_FLOAT cs_fft_window_weight(VT_UINT i, VT_UINT N, VT_UINT8 windowType)
+{
+    VT_FLOAT samplesMinusOne = ((VT_FLOAT)N - 1.0f);
+    VT_FLOAT indexMinusOne   = (VT_FLOAT)i;
+    VT_FLOAT ratio           = (indexMinusOne / samplesMinusOne);
+    VT_FLOAT weighingFactor  = 1.0f;
+    // Compute and record weighting factor
+    switch (windowType)
+    {
+        case FFT_WIN_TYP_RECTANGLE: // rectangle (box car)
+            weighingFactor = 1.0f;
+            break;
+        case FFT_WIN_TYP_HAMMING: // hamming
+            weighingFactor = 0.54f - (0.46f * (VT_FLOAT)cos(twoPi * ratio));
+            break;
+        case FFT_WIN_TYP_HANN: // hann
+            weighingFactor = 0.54f * (1.0f - (VT_FLOAT)cos(twoPi * ratio));
+            break;
+        case FFT_WIN_TYP_TRIANGLE: // triangle (Bartlett)
+            weighingFactor = 1.0f - ((2.0f * (VT_FLOAT)fabs(indexMinusOne - (samplesMinusOne / 2.0f))) / samplesMinusOne);
+            break;
+        case FFT_WIN_TYP_NUTTALL: // nuttall
+            weighingFactor = 0.355768f - (0.487396f * ((VT_FLOAT)cos(twoPi * ratio))) +
+                             (0.144232f * ((VT_FLOAT)cos(fourPi * ratio))) - (0.012604f * ((VT_FLOAT)cos(sixPi * ratio)));
+            break;
+        case FFT_WIN_TYP_BLACKMAN: // blackman
+            weighingFactor =
+                0.42323f - (0.49755f * ((VT_FLOAT)cos(twoPi * ratio))) + (0.07922f * ((VT_FLOAT)cos(fourPi * ratio)));
+            break;
+        case FFT_WIN_TYP_BLACKMAN_NUTTALL: // blackman nuttall
+            weighingFactor = 0.3635819f - (0.4891775f * ((VT_FLOAT)cos(twoPi * ratio))) +
+                             (0.1365995f * ((VT_FLOAT)cos(fourPi * ratio))) - (0.0106411f * ((VT_FLOAT)cos(sixPi * ratio)));
+            break;
+        case FFT_WIN_TYP_BLACKMAN_HARRIS: // blackman harris
+            weighingFactor = 0.35875f - (0.48829f * ((VT_FLOAT)cos(twoPi * ratio))) +
+                             (0.14128f * ((VT_FLOAT)cos(fourPi * ratio))) - (0.01168f * ((VT_FLOAT)cos(sixPi * ratio)));
+            break;
+        case FFT_WIN_TYP_FLT_TOP: // flat top
+            weighingFactor =
+                0.2810639f - (0.5208972f * (VT_FLOAT)cos(twoPi * ratio)) + (0.1980399f * (VT_FLOAT)cos(fourPi * ratio));
+            break;
+        case FFT_WIN_TYP_WELCH: // welch
+            weighingFactor = 1.0f - sq((indexMinusOne - samplesMinusOne / 2.0f) / (samplesMinusOne / 2.0f));
+            break;
+    }
+    return weighingFactor;
+}
+
+static VT_VOID cs_fft_window_weight_apply(COMPLEX* Y, VT_UINT N, VT_UINT i, VT_FLOAT weighingFactor, VT_UINT8 dir)
+{
+    if (dir == FFT_FORWARD)
+    {
+        Y[i].real *= weighingFactor;
+        Y[N - (i + 1)].real *= weighingFactor;
+    }
+    else
+    {
+        Y[i].real /= weighingFactor;
+        Y[N - (i + 1)].real /= weighingFactor;
+    }
+}
+
 VT_VOID cs_fft_windowing(COMPLEX* Y, VT_UINT N, VT_UINT8 windowType, VT_UINT8 dir)
+{
+    // The weighing function is symetric; half the weighs are computed
+    for (VT_UINT i = 0; i < (N >> 1); i++)
+    {
+        cs_fft_window_weight_apply(Y, N, i, cs_fft_window_weight(i, N, windowType), dir);
+    }
+}
+
+VT_VOID cs_fft_window_weights_compute(VT_FLOAT* weights, VT_UINT N, VT_UINT8 windowType)
 {
     // Weighing factors are computed once before multiple use of FFT
-    // The weighing function is symetric; half the weighs are recorded
-    VT_FLOAT samplesMinusOne = ((VT_FLOAT)N - 1.0f);
     for (VT_UINT i = 0; i < (N >> 1); i++)
     {
-        VT_FLOAT indexMinusOne  = (VT_FLOAT)i;
-        VT_FLOAT ratio          = (indexMinusOne / samplesMinusOne);
-        VT_FLOAT weighingFactor = 1.0f;
-        // Compute and record weighting factor
-        switch (windowType)
-        {
-            case FFT_WIN_TYP_RECTANGLE: // rectangle (box car)
-                weighingFactor = 1.0f;
-                break;
-            case FFT_WIN_TYP_HAMMING: // hamming
-                weighingFactor = 0.54f - (0.46f * (VT_FLOAT)cos(twoPi * ratio));
-                break;
-            case FFT_WIN_TYP_HANN: // hann
-                weighingFactor = 0.54f * (1.0f - (VT_FLOAT)cos(twoPi * ratio));
-                break;
-            case FFT_WIN_TYP_TRIANGLE: // triangle (Bartlett)
-                weighingFactor = 1.0f - ((2.0f * (VT_FLOAT)fabs(indexMinusOne - (samplesMinusOne / 2.0f))) / samplesMinusOne);
-                break;
-            case FFT_WIN_TYP_NUTTALL: // nuttall
-                weighingFactor = 0.355768f - (0.487396f * ((VT_FLOAT)cos(twoPi * ratio))) +
-                                 (0.144232f * ((VT_FLOAT)cos(fourPi * ratio))) - (0.012604f * ((VT_FLOAT)cos(sixPi * ratio)));
-                break;
-            case FFT_WIN_TYP_BLACKMAN: // blackman
-                weighingFactor =
-                    0.42323f - (0.49755f * ((VT_FLOAT)cos(twoPi * ratio))) + (0.07922f * ((VT_FLOAT)cos(fourPi * ratio)));
-                break;
-            case FFT_WIN_TYP_BLACKMAN_NUTTALL: // blackman nuttall
-                weighingFactor = 0.3635819f - (0.4891775f * ((VT_FLOAT)cos(twoPi * ratio))) +
-                                 (0.1365995f * ((VT_FLOAT)cos(fourPi * ratio))) - (0.0106411f * ((VT_FLOAT)cos(sixPi * ratio)));
-                break;
-            case FFT_WIN_TYP_BLACKMAN_HARRIS: // blackman harris
-                weighingFactor = 0.35875f - (0.48829f * ((VT_FLOAT)cos(twoPi * ratio))) +
-                                 (0.14128f * ((VT_FLOAT)cos(fourPi * ratio))) - (0.01168f * ((VT_FLOAT)cos(sixPi * ratio)));
-                break;
-            case FFT_WIN_TYP_FLT_TOP: // flat top
-                weighingFactor =
-                    0.2810639f - (0.5208972f * (VT_FLOAT)cos(twoPi * ratio)) + (0.1980399f * (VT_FLOAT)cos(fourPi * ratio));
-                break;
-            case FFT_WIN_TYP_WELCH: // welch
-                weighingFactor = 1.0f - sq((indexMinusOne - samplesMinusOne / 2.0f) / (samplesMinusOne / 2.0f));
-                break;
-        }
-        if (dir == FFT_FORWARD)
-        {
-            Y[i].real *= weighingFactor;
-            Y[N - (i + 1)].real *= weighingFactor;
-        }
-        else
-        {
-            Y[i].real /= weighingFactor;
-            Y[N - (i + 1)].real /= weighingFactor;
-        }
+        weights[i] = cs_fft_window_weight(i, N, windowType);
+    }
+}
+
+VT_VOID cs_fft_windowing_precomputed(COMPLEX* Y, VT_UINT N, const VT_FLOAT* weights, VT_UINT8 dir)
+{
+    for (VT_UINT i = 0; i < (N >> 1); i++)
+    {
+        cs_fft_window_weight_apply(Y, N, i, weights[i], dir);
     }
 }
 
@@ -0,0 +1,88 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_cs_plan.h"
+#include "vt_cs_fft.h"
+#include "vt_debug.h"
+
+static VT_VOID cs_plan_calibration_ranges_compute(VT_CURRENTSENSE_PLAN* plan)
+{
+    VT_FLOAT f_low         = (VT_CS_ADC_MAX_SAMPLING_FREQ / 2) / plan->sample_length;
+    VT_FLOAT range_divisor = 1;
+    VT_FLOAT sampling_freq = 0;
+    VT_UINT num_ranges     = 1;
+
+    /* Each range lowers the sampling frequency by fft_length until the lowest bin reaches VT_CS_FMIN */
+    while (f_low >= VT_CS_FMIN)
+    {
+        f_low /= (((VT_FLOAT)plan->sample_length) / 2.0f);
+        num_ranges++;
+    }
+    if (num_ranges > VT_CS_MAX_CALIBRATION_RANGES)
+    {
+        num_ranges = VT_CS_MAX_CALIBRATION_RANGES;
+    }
+
+    for (VT_UINT iter = 0; iter < num_ranges; iter++)
+    {
+        sampling_freq = VT_CS_ADC_MAX_SAMPLING_FREQ / range_divisor;
+        if ((sampling_freq / plan->sample_length) < VT_CS_FMIN)
+        {
+            sampling_freq = VT_CS_FMIN * plan->sample_length;
+        }
+        plan->calibration_ranges[iter].sampling_freq = sampling_freq;
+        plan->calibration_ranges[iter].bin_width     = sampling_freq / (VT_FLOAT)plan->sample_length;
+        range_divisor *= plan->fft_length;
+    }
+    plan->num_calibration_ranges = num_ranges;
+
+    plan->signature_sampling_factor = plan->sample_length / VT_CS_CALIB_MINIMUM_CYCLES;
+}
+
+VT_UINT cs_plan_create(VT_CURRENTSENSE_PLAN* plan, VT_UINT sample_length, VT_UINT auto_correlation_lag)
+{
+    /* FFT needs a power of two number of points that fits the raw signature buffers */
+    if (sample_length < VT_CS_MIN_SAMPLE_LENGTH || sample_length > VT_CS_SAMPLE_LENGTH ||
+        (sample_length & (sample_length - 1)) != 0)
+    {
+        VTLogError("Currentsense plan sample length %d not supported \r\n", sample_length);
+        return VT_ERROR;
+    }
+
+    if (auto_correlation_lag == 0 || auto_correlation_lag >= sample_length)
+    {
+        VTLogError("Currentsense plan autocorrelation lag %d not supported \r\n", auto_correlation_lag);
+        return VT_ERROR;
+    }
+
+    plan->sample_length        = sample_length;
+    plan->fft_length           = sample_length / 2;
+    plan->auto_correlation_lag = auto_correlation_lag;
+    cs_fft_window_weights_compute(plan->hamming_window, sample_length, FFT_WIN_TYP_HAMMING);
+    cs_plan_calibration_ranges_compute(plan);
+
+    return VT_SUCCESS;
+}
+
+VT_VOID cs_plan_dump(const VT_CURRENTSENSE_PLAN* plan)
+{
+#if VT_LOG_LEVEL > 1
+    int32_t freq_decimal;
+    int32_t freq_frac;
+    int32_t bin_decimal;
+    int32_t bin_frac;
+
+    VTLogInfo("Currentsense plan: sample length %d, FFT length %d, autocorrelation lag %d \r\n",
+        plan->sample_length,
+        plan->fft_length,
+        plan->auto_correlation_lag);
+    VTLogInfo("Calibration range\t:\tSampling Frequency\t:\tBin Width \r\n");
+    for (VT_UINT iter = 0; iter < plan->num_calibration_ranges; iter++)
+    {
+        freq_decimal = plan->calibration_ranges[iter].sampling_freq;
+        freq_frac    = (plan->calibration_ranges[iter].sampling_freq - (VT_FLOAT)freq_decimal) * 10000;
+        bin_decimal  = plan->calibration_ranges[iter].bin_width;
+        bin_frac     = (plan->calibration_ranges[iter].bin_width - (VT_FLOAT)bin_decimal) * 10000;
+        VTLogInfo("%d\t:\t%d.%04d\t:\t%d.%04d \r\n", iter, freq_decimal, freq_frac, bin_decimal, bin_frac);
+    }
+#endif /* VT_LOG_LEVEL > 1 */
+}
@@ -0,0 +1,198 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_cs_precheck.h"
+#include "vt_debug.h"
+#include <math.h>
+
+#define VOLT_TO_MILLIVOLT 1000.0f
+
+static VT_BOOL cs_precheck_within(VT_FLOAT value, VT_FLOAT min, VT_FLOAT max)
+{
+    return (value >= (min - ((fabsf(min) * VT_CS_PRECHECK_TOLERANCE) / 100.0f)) &&
+            value <= (max + ((fabsf(max) * VT_CS_PRECHECK_TOLERANCE) / 100.0f)));
+}
+
+static VT_FLOAT cs_precheck_deviation(const VT_CURRENTSENSE_PRECHECK_STATISTICS* statistics)
+{
+    if (statistics->count < 2)
+    {
+        return 0;
+    }
+    return sqrtf(statistics->m2 / (VT_FLOAT)(statistics->count - 1));
+}
+
+VT_VOID cs_precheck_bounds_reset(VT_CURRENTSENSE_PRECHECK_BOUNDS* bounds)
+{
+    bounds->num_captures  = 0;
+    bounds->on_threshold  = 0;
+    bounds->mean_min      = 0;
+    bounds->mean_max      = 0;
+    bounds->deviation_min = 0;
+    bounds->deviation_max = 0;
+
+    /* An empty range leaves the on ratio unchecked */
+    bounds->on_ratio_min = 1;
+    bounds->on_ratio_max = 0;
+}
+
+VT_VOID cs_precheck_statistics_reset(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_CURRENTSENSE_PRECHECK_STATISTICS* statistics = &(cs_object->raw_signatures_reader->precheck_statistics);
+
+    statistics->count  = 0;
+    statistics->mean   = 0;
+    statistics->m2     = 0;
+    statistics->num_on = 0;
+
+    /* Calibration captures after the first measure their on ratio against the threshold that calibration chose */
+    if (cs_object->mode != VT_MODE_RUNTIME_EVALUATE && cs_object->calibration.num_captures)
+    {
+        statistics->on_threshold = cs_object->calibration.precheck.on_threshold;
+    }
+    else
+    {
+        statistics->on_threshold = cs_object->precheck.bounds.on_threshold;
+    }
+}
+
+VT_VOID cs_precheck_statistics_accumulate(VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* adc_samples, VT_UINT num_samples)
+{
+    VT_CURRENTSENSE_PRECHECK_STATISTICS* statistics = &(cs_object->raw_signatures_reader->precheck_statistics);
+    VT_FLOAT adc_to_current = ((*(cs_object->sensor_handle->adc_ref_volt) * VOLT_TO_MILLIVOLT) /
+                                  (VT_FLOAT)pow(2, *(cs_object->sensor_handle->adc_resolution))) *
+                              (*(cs_object->sensor_handle->currentsense_mV_to_mA));
+    VT_FLOAT sum            = 0;
+    VT_FLOAT batch_m2       = 0;
+    VT_FLOAT current        = 0;
+    VT_FLOAT batch_mean     = 0;
+    VT_FLOAT delta          = 0;
+    VT_ULONG total_count    = 0;
+
+    if (num_samples == 0)
+    {
+        return;
+    }
+
+    for (VT_UINT iter = 0; iter < num_samples; iter++)
+    {
+        current = adc_samples[iter] * adc_to_current;
+        sum += current;
+        if (current > statistics->on_threshold)
+        {
+            statistics->num_on++;
+        }
+    }
+    batch_mean = sum / num_samples;
+    for (VT_UINT iter = 0; iter < num_samples; iter++)
+    {
+        current = (adc_samples[iter] * adc_to_current) - batch_mean;
+        batch_m2 += current * current;
+    }
+
+    /* Merge the batch into the running statistics, one division per half buffer keeps the ADC callback short */
+    delta       = batch_mean - statistics->mean;
+    total_count = statistics->count + num_samples;
+    statistics->m2 +=
+        batch_m2 + ((delta * delta * (VT_FLOAT)statistics->count * (VT_FLOAT)num_samples) / (VT_FLOAT)total_count);
+    statistics->mean += (delta * num_samples) / (VT_FLOAT)total_count;
+    statistics->count = total_count;
+}
+
+VT_VOID cs_precheck_calibration_accumulate(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_CURRENTSENSE_PRECHECK_STATISTICS* statistics = &(cs_object->raw_signatures_reader->precheck_statistics);
+    VT_CURRENTSENSE_PRECHECK_BOUNDS* bounds         = &(cs_object->calibration.precheck);
+    VT_FLOAT deviation                              = cs_precheck_deviation(statistics);
+    VT_FLOAT on_ratio                               = 0;
+
+    if (statistics->count < 2)
+    {
+        return;
+    }
+
+    if (bounds->num_captures == 0)
+    {
+        bounds->on_threshold  = statistics->mean;
+        bounds->mean_min      = statistics->mean;
+        bounds->mean_max      = statistics->mean;
+        bounds->deviation_min = deviation;
+        bounds->deviation_max = deviation;
+        bounds->num_captures++;
+        return;
+    }
+
+    bounds->mean_min      = (statistics->mean < bounds->mean_min) ? statistics->mean : bounds->mean_min;
+    bounds->mean_max      = (statistics->mean > bounds->mean_max) ? statistics->mean : bounds->mean_max;
+    bounds->deviation_min = (deviation < bounds->deviation_min) ? deviation : bounds->deviation_min;
+    bounds->deviation_max = (deviation > bounds->deviation_max) ? deviation : bounds->deviation_max;
+
+    on_ratio = (VT_FLOAT)statistics->num_on / (VT_FLOAT)statistics->count;
+    if (bounds->on_ratio_min > bounds->on_ratio_max)
+    {
+        bounds->on_ratio_min = on_ratio;
+        bounds->on_ratio_max = on_ratio;
+    }
+    else
+    {
+        bounds->on_ratio_min = (on_ratio < bounds->on_ratio_min) ? on_ratio : bounds->on_ratio_min;
+        bounds->on_ratio_max = (on_ratio > bounds->on_ratio_max) ? on_ratio : bounds->on_ratio_max;
+    }
+    bounds->num_captures++;
+}
+
+VT_VOID cs_precheck_calibration_finalize(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    if (cs_object->calibration.precheck.num_captures == 0)
+    {
+        return;
+    }
+    cs_object->precheck.bounds = cs_object->calibration.precheck;
+}
+
+VT_UINT cs_precheck_sensor_status(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_CURRENTSENSE_PRECHECK_STATISTICS* statistics = &(cs_object->raw_signatures_reader->precheck_statistics);
+    VT_CURRENTSENSE_PRECHECK_BOUNDS* bounds         = &(cs_object->precheck.bounds);
+    VT_FLOAT calibrated_mean                        = (bounds->mean_min + bounds->mean_max) / 2.0f;
+    VT_FLOAT mean_drift                             = 0;
+    VT_FLOAT on_ratio                               = 0;
+
+    if (statistics->count < 2 || bounds->num_captures == 0 || cs_object->precheck.enabled == false)
+    {
+        return VT_ERROR;
+    }
+
+    if (calibrated_mean != 0)
+    {
+        mean_drift = (fabsf(statistics->mean - calibrated_mean) * 100.0f) / fabsf(calibrated_mean);
+    }
+    if (mean_drift > 100.0f)
+    {
+        mean_drift = 100.0f;
+    }
+
+    if (mean_drift > VT_CS_PRECHECK_REJECT_DRIFT)
+    {
+        VTLogDebug("Pre-check: mean current far from calibration \r\n");
+        cs_object->sensor_status = VT_SIGNATURE_NOT_MATCHING;
+        cs_object->sensor_drift  = (VT_UINT8)mean_drift;
+        cs_object->precheck.num_tier0_not_matching++;
+        return VT_SUCCESS;
+    }
+
+    on_ratio = (VT_FLOAT)statistics->num_on / (VT_FLOAT)statistics->count;
+    if (cs_precheck_within(statistics->mean, bounds->mean_min, bounds->mean_max) &&
+        cs_precheck_within(cs_precheck_deviation(statistics), bounds->deviation_min, bounds->deviation_max) &&
+        (bounds->on_ratio_min > bounds->on_ratio_max ||
+            (on_ratio >= (bounds->on_ratio_min - VT_CS_PRECHECK_ON_RATIO_TOLERANCE) &&
+                on_ratio <= (bounds->on_ratio_max + VT_CS_PRECHECK_ON_RATIO_TOLERANCE))))
+    {
+        VTLogDebug("Pre-check: capture statistics within calibration \r\n");
+        cs_object->sensor_status = VT_SIGNATURE_MATCHING;
+        cs_object->sensor_drift  = (VT_UINT8)mean_drift;
+        cs_object->precheck.num_tier0_matching++;
+        return VT_SUCCESS;
+    }
+
+    return VT_ERROR;
+}
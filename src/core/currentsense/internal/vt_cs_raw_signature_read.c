@@ -1,6 +1,8 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
+#include "vt_cs_precheck.h"
 #include "vt_cs_raw_signature_read.h"
+#include "vt_debug.h"
 #include <math.h>
 
 #define RAW_SIGNATURE_BUFFER_NOT_FILLED false
@@ -23,7 +25,9 @@ static VT_BOOL cs_downsample_half_adc_buffer(
 
     VT_UINT adc_buffer_next_datapoint_to_read_index = 0;
 
-    for (VT_UINT iter = adc_read_buffer_start_index; iter < adc_read_buffer_start_index + VT_CS_SAMPLE_LENGTH / 2; iter++)
+    VT_UINT adc_read_buffer_half_length = cs_object_reference->plan.sample_length / 2;
+
+    for (VT_UINT iter = adc_read_buffer_start_index; iter < adc_read_buffer_start_index + adc_read_buffer_half_length; iter++)
     {
         adc_buffer_next_datapoint_to_read_index = downsample_factor * (VT_FLOAT)samples_stored;
 
@@ -41,6 +45,7 @@ static VT_BOOL cs_downsample_half_adc_buffer(
             (*(cs_object_reference->sensor_handle->currentsense_mV_to_mA));
 
         samples_stored++;
+        raw_signature_buffer->num_datapoints = samples_stored;
         if (samples_stored == raw_signature_buffer->sample_length)
         {
             return RAW_SIGNATURE_BUFFER_FILLED;
@@ -129,6 +134,10 @@ static VT_VOID cs_raw_signature_read_half_complete_callback()
         return;
     }
 
+    cs_precheck_statistics_accumulate(cs_object_reference,
+        cs_object_reference->raw_signatures_reader->adc_read_buffer,
+        cs_object_reference->plan.sample_length / 2);
+
     /* Transfer data from adc buffer to non repeating signature buffer */
     cs_adc_buffer_to_non_repeating_raw_signature_buffer(0);
 
@@ -161,13 +170,17 @@ static VT_VOID cs_raw_signature_read_full_complete_callback()
         cs_object_reference->sensor_handle->adc_controller,
         cs_object_reference->sensor_handle->adc_channel,
         cs_object_reference->raw_signatures_reader->adc_read_buffer,
-        VT_CS_SAMPLE_LENGTH,
+        cs_object_reference->plan.sample_length,
         cs_object_reference->raw_signatures_reader->adc_read_sampling_frequency,
         &cs_raw_signature_read_half_complete_callback,
         &cs_raw_signature_read_full_complete_callback);
 
+    cs_precheck_statistics_accumulate(cs_object_reference,
+        cs_object_reference->raw_signatures_reader->adc_read_buffer + (cs_object_reference->plan.sample_length / 2),
+        cs_object_reference->plan.sample_length / 2);
+
     /* Transfer data from adc buffer to non repeating signature buffer */
-    cs_adc_buffer_to_non_repeating_raw_signature_buffer(VT_CS_SAMPLE_LENGTH / 2);
+    cs_adc_buffer_to_non_repeating_raw_signature_buffer(cs_object_reference->plan.sample_length / 2);
 
     if (cs_object_reference->raw_signatures_reader->repeating_raw_signature_buffers_filled)
     {
@@ -175,7 +188,8 @@ static VT_VOID cs_raw_signature_read_full_complete_callback()
     }
 
     /* Transfer data from adc buffer to repeating signature buffers */
-    repeating_raw_signature_buffers_filled = cs_adc_buffer_to_repeating_raw_signature_buffers(VT_CS_SAMPLE_LENGTH / 2);
+    repeating_raw_signature_buffers_filled =
+        cs_adc_buffer_to_repeating_raw_signature_buffers(cs_object_reference->plan.sample_length / 2);
     if (repeating_raw_signature_buffers_filled)
     {
         cs_object_reference->raw_signatures_reader->repeating_raw_signature_ongoing_collection = false;
@@ -198,6 +212,13 @@ static VT_UINT find_closest_floor_stored_sampling_frequency(
     VT_FLOAT min_diff = 65535;
     for (VT_UINT iter = 0; iter < cs_object->raw_signatures_reader->num_repeating_raw_signatures; iter++)
     {
+        /* Provisional calibration runs while slower ranges are still being collected */
+        if (cs_object->raw_signatures_reader->repeating_raw_signature_buffers_filled == false &&
+            cs_object->raw_signatures_reader->repeating_raw_signatures[iter].num_datapoints !=
+                cs_object->raw_signatures_reader->repeating_raw_signatures[iter].sample_length)
+        {
+            continue;
+        }
         if (desired_sampling_frequency >= cs_object->raw_signatures_reader->repeating_raw_signatures[iter].sampling_frequency)
         {
             if (min_diff > (desired_sampling_frequency -
@@ -269,12 +290,36 @@ VT_UINT cs_raw_signature_read(VT_CURRENTSENSE_OBJECT* cs_object,
     /* Set flag for stopping non-repeating signature current collection to false*/
     cs_object_reference->raw_signatures_reader->non_repeating_raw_signature_stop_collection = false;
 
+    /* Reset incremental evaluation of repeating signatures */
+    cs_object_reference->raw_signatures_reader->repeating_signatures_evaluated_mask = 0;
+    cs_object_reference->raw_signatures_reader->num_repeating_signatures_evaluated  = 0;
+    cs_object_reference->raw_signatures_reader->repeating_signatures_drift_sum      = 0;
+    cs_object_reference->raw_signatures_reader->repeating_signatures_tolerance_sum  = 0;
+    cs_object_reference->raw_signatures_reader->repeating_signatures_compute_fail   = false;
+    cs_object_reference->raw_signatures_reader->repeating_signatures_computed_mask  = 0;
+    cs_object_reference->raw_signatures_reader->offset_current_under_test           = VT_DATA_NOT_AVAILABLE;
+    cs_object_reference->raw_signatures_reader->calibration_ranges_processed        = 0;
+
+    /* Reset statistics gathered for the tier-0 pre-check */
+    cs_precheck_statistics_reset(cs_object_reference);
+
     /* sample length should not be greater than the defined macro */
     if (sample_length > VT_CS_SAMPLE_LENGTH)
     {
         sample_length = VT_CS_SAMPLE_LENGTH;
     }
 
+    /* Number of repeating signatures should not be greater than the buffers available to the reader */
+    if (num_repeating_signature_sampling_frequencies >
+        cs_object_reference->raw_signatures_reader->repeating_raw_signatures_capacity)
+    {
+        VTLogError("Raw Signatures Buffer too small, reading %d of %d repeating signatures \r\n",
+            cs_object_reference->raw_signatures_reader->repeating_raw_signatures_capacity,
+            num_repeating_signature_sampling_frequencies);
+        num_repeating_signature_sampling_frequencies =
+            cs_object_reference->raw_signatures_reader->repeating_raw_signatures_capacity;
+    }
+
     /* Init number of repeating signature sampling frequencies*/
     cs_object_reference->raw_signatures_reader->num_repeating_raw_signatures = num_repeating_signature_sampling_frequencies;
 
@@ -299,7 +344,7 @@ VT_UINT cs_raw_signature_read(VT_CURRENTSENSE_OBJECT* cs_object,
         cs_object_reference->sensor_handle->adc_controller,
         cs_object_reference->sensor_handle->adc_channel,
         cs_object_reference->raw_signatures_reader->adc_read_buffer,
-        VT_CS_SAMPLE_LENGTH,
+        sample_length,
         cs_object_reference->raw_signatures_reader->adc_read_sampling_frequency,
         &cs_raw_signature_read_half_complete_callback,
         &cs_raw_signature_read_full_complete_callback);
@@ -307,35 +352,80 @@ VT_UINT cs_raw_signature_read(VT_CURRENTSENSE_OBJECT* cs_object,
     return VT_SUCCESS;
 }
 
-VT_UINT cs_repeating_raw_signature_fetch_stored_current_measurement(
-    VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* repeating_raw_signature, VT_FLOAT sampling_frequency, VT_UINT sample_length)
+static VT_CURRENTSENSE_RAW_SIGNATURE_BUFFER* cs_repeating_raw_signature_buffer_find(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT slot, VT_FLOAT sampling_frequency)
+{
+    VT_CURRENTSENSE_RAW_SIGNATURES_READER* reader = cs_object->raw_signatures_reader;
+
+    /* Buffers are read in template order, so the slot normally points straight at the buffer */
+    if (slot < reader->num_repeating_raw_signatures &&
+        reader->repeating_raw_signatures[slot].sampling_frequency == sampling_frequency)
+    {
+        return &reader->repeating_raw_signatures[slot];
+    }
+
+    for (VT_UINT iter = 0; iter < reader->num_repeating_raw_signatures; iter++)
+    {
+        if (reader->repeating_raw_signatures[iter].sampling_frequency == sampling_frequency)
+        {
+            return &reader->repeating_raw_signatures[iter];
+        }
+    }
+    return NULL;
+}
+
+VT_BOOL cs_repeating_raw_signature_buffer_filled(VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT slot, VT_FLOAT sampling_frequency)
+{
+    VT_CURRENTSENSE_RAW_SIGNATURE_BUFFER* raw_signature_buffer;
+
+    if (cs_object->raw_signatures_reader_initialized == false)
+    {
+        return false;
+    }
+
+    if (cs_object->raw_signatures_reader->repeating_raw_signature_buffers_filled)
+    {
+        return true;
+    }
+
+    raw_signature_buffer = cs_repeating_raw_signature_buffer_find(cs_object, slot, sampling_frequency);
+    if (raw_signature_buffer == NULL)
+    {
+        return false;
+    }
+    return (raw_signature_buffer->num_datapoints == raw_signature_buffer->sample_length);
+}
+
+VT_UINT cs_repeating_raw_signature_view(VT_CURRENTSENSE_OBJECT* cs_object,
+    VT_UINT slot,
+    VT_FLOAT sampling_frequency,
+    VT_CURRENTSENSE_RAW_SIGNATURE_VIEW* raw_signature_view)
 {
+    VT_CURRENTSENSE_RAW_SIGNATURE_BUFFER* raw_signature_buffer;
+
     /* Check whether the shared buffer size is sufficent and has been initialized correctly */
     if (cs_object->raw_signatures_reader_initialized == false)
     {
         return VT_ERROR;
     }
 
-    /* Check whether the buffers have been stored with new current data */
-    if (cs_object->raw_signatures_reader->repeating_raw_signature_buffers_filled == false)
+    raw_signature_buffer = cs_repeating_raw_signature_buffer_find(cs_object, slot, sampling_frequency);
+    if (raw_signature_buffer == NULL)
     {
         return VT_ERROR;
     }
 
-    for (VT_UINT iter1 = 0; iter1 < cs_object->raw_signatures_reader->num_repeating_raw_signatures; iter1++)
+    /* Check whether this buffer has been stored with new current data */
+    if (cs_object->raw_signatures_reader->repeating_raw_signature_buffers_filled == false &&
+        raw_signature_buffer->num_datapoints != raw_signature_buffer->sample_length)
     {
-        if (sampling_frequency == cs_object->raw_signatures_reader->repeating_raw_signatures[iter1].sampling_frequency &&
-            sample_length == cs_object->raw_signatures_reader->repeating_raw_signatures[iter1].sample_length)
-        {
-            for (VT_UINT iter2 = 0; iter2 < sample_length; iter2++)
-            {
-                repeating_raw_signature[iter2] =
-                    cs_object->raw_signatures_reader->repeating_raw_signatures[iter1].current_measured[iter2];
-            }
-            return VT_SUCCESS;
-        }
+        return VT_ERROR;
     }
-    return VT_ERROR;
+
+    raw_signature_view->current_measured   = raw_signature_buffer->current_measured;
+    raw_signature_view->sample_length      = raw_signature_buffer->sample_length;
+    raw_signature_view->sampling_frequency = raw_signature_buffer->sampling_frequency;
+    return VT_SUCCESS;
 }
 
 VT_UINT cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_calibration(VT_CURRENTSENSE_OBJECT* cs_object,
@@ -363,10 +453,8 @@ VT_UINT cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_ca
     return VT_ERROR;
 }
 
-VT_UINT cs_non_repeating_raw_signature_fetch_stored_current_measurement(VT_CURRENTSENSE_OBJECT* cs_object,
-    VT_FLOAT* non_repeating_raw_signature,
-    VT_FLOAT* sampling_frequency,
-    VT_UINT* num_datapoints)
+VT_UINT cs_non_repeating_raw_signature_view(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_CURRENTSENSE_RAW_SIGNATURE_VIEW* raw_signature_view)
 {
     /* Check whether the shared buffer size is sufficent and has been initialized correctly */
     if (cs_object->raw_signatures_reader_initialized == false)
@@ -380,13 +468,8 @@ VT_UINT cs_non_repeating_raw_signature_fetch_stored_current_measurement(VT_CURRE
         return VT_ERROR;
     }
 
-    *sampling_frequency = cs_object->raw_signatures_reader->non_repeating_raw_signature.sampling_frequency;
-
-    *num_datapoints = cs_object->raw_signatures_reader->non_repeating_raw_signature.num_datapoints;
-
-    for (VT_UINT iter = 0; iter < cs_object->raw_signatures_reader->non_repeating_raw_signature.num_datapoints; iter++)
-    {
-        non_repeating_raw_signature[iter] = cs_object->raw_signatures_reader->non_repeating_raw_signature.current_measured[iter];
-    }
+    raw_signature_view->current_measured   = cs_object->raw_signatures_reader->non_repeating_raw_signature.current_measured;
+    raw_signature_view->sample_length      = cs_object->raw_signatures_reader->non_repeating_raw_signature.num_datapoints;
+    raw_signature_view->sampling_frequency = cs_object->raw_signatures_reader->non_repeating_raw_signature.sampling_frequency;
     return VT_SUCCESS;
 }
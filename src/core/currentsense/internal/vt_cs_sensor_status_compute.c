@@ -1,16 +1,17 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
 #include "vt_cs_api.h"
+#include "vt_cs_arena.h"
 #include "vt_cs_database.h"
+#include "vt_cs_precheck.h"
 #include "vt_cs_raw_signature_read.h"
 #include "vt_cs_sensor_status.h"
 #include "vt_cs_signature_features.h"
+#include "vt_cs_template_adapt.h"
 
 static VT_VOID cs_sensor_status_with_non_repeating_signature_template(VT_CURRENTSENSE_OBJECT* cs_object)
 {
-    VT_FLOAT raw_signature[VT_CS_SAMPLE_LENGTH] = {0};
-    VT_FLOAT sampling_frequency                 = 0;
-    VT_UINT num_datapoints                      = 0;
+    VT_CURRENTSENSE_RAW_SIGNATURE_VIEW raw_signature;
     VT_FLOAT avg_curr_on;
     VT_FLOAT avg_curr_on_saved;
     VT_FLOAT avg_curr_off;
@@ -21,17 +22,19 @@ static VT_VOID cs_sensor_status_with_non_repeating_signature_template(VT_CURRENT
     if (cs_fetch_template_non_repeating_signature_average_current(cs_object, &avg_curr_on_saved, &avg_curr_off_saved) ==
         VT_SUCCESS)
     {
-        if (cs_non_repeating_raw_signature_fetch_stored_current_measurement(
-                cs_object, raw_signature, &sampling_frequency, &num_datapoints) == VT_SUCCESS)
+        if (cs_non_repeating_raw_signature_view(cs_object, &raw_signature) == VT_SUCCESS)
         {
 
-            if (cs_non_repeating_signature_average_current_compute(
-                    cs_object, raw_signature, num_datapoints, &avg_curr_on, &avg_curr_off) == VT_SUCCESS)
+            if (cs_non_repeating_signature_average_current_compute(cs_object,
+                    raw_signature.current_measured,
+                    raw_signature.sample_length,
+                    &avg_curr_on,
+                    &avg_curr_off) == VT_SUCCESS)
             {
                 avg_curr_drift = cs_non_repeating_signature_average_current_evaluate(
                     avg_curr_on, avg_curr_on_saved, avg_curr_off, avg_curr_off_saved);
 
-                if (avg_curr_drift > VT_CS_MAX_AVG_CURR_DRIFT)
+                if (avg_curr_drift > cs_object->template_tolerance.avg_curr_drift)
                 {
                     cs_object->sensor_status = VT_SIGNATURE_NOT_MATCHING;
                     cs_object->sensor_drift  = avg_curr_drift;
@@ -41,6 +44,7 @@ static VT_VOID cs_sensor_status_with_non_repeating_signature_template(VT_CURRENT
                     cs_object->sensor_status = VT_SIGNATURE_MATCHING;
                     cs_object->sensor_drift  = avg_curr_drift;
                 }
+                cs_template_adapt_non_repeating_signature(cs_object, avg_curr_on, avg_curr_off);
                 return;
             }
             cs_object->sensor_status = VT_SIGNATURE_COMPUTE_FAIL;
@@ -54,13 +58,22 @@ static VT_VOID cs_sensor_status_with_non_repeating_signature_template(VT_CURRENT
     cs_object->sensor_drift  = 100;
 }
 
-static VT_VOID cs_sensor_status_with_repeating_signature_template(VT_CURRENTSENSE_OBJECT* cs_object)
+static VT_VOID cs_repeating_signatures_evaluation_reset(VT_CURRENTSENSE_OBJECT* cs_object)
 {
-    VT_FLOAT raw_signature[VT_CS_SAMPLE_LENGTH] = {0};
+    cs_object->raw_signatures_reader->repeating_signatures_evaluated_mask = 0;
+    cs_object->raw_signatures_reader->num_repeating_signatures_evaluated  = 0;
+    cs_object->raw_signatures_reader->repeating_signatures_drift_sum      = 0;
+    cs_object->raw_signatures_reader->repeating_signatures_tolerance_sum  = 0;
+    cs_object->raw_signatures_reader->repeating_signatures_compute_fail   = false;
+    cs_object->raw_signatures_reader->repeating_signatures_computed_mask  = 0;
+    cs_object->raw_signatures_reader->offset_current_under_test           = VT_DATA_NOT_AVAILABLE;
+}
 
-    VT_FLOAT lowest_sample_freq_saved;
-    VT_FLOAT offset_current;
-    VT_FLOAT offset_current_saved;
+/* Signatures are read from their own buffers, or extrapolated into extrapolated_signature from the calibration ranges */
+static VT_UINT cs_repeating_signatures_evaluate(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* extrapolated_signature, VT_BOOL evaluate_filled_only)
+{
+    VT_CURRENTSENSE_RAW_SIGNATURE_VIEW raw_signature;
 
     VT_FLOAT sampling_frequency_saved;
     VT_FLOAT signature_frequency;
@@ -70,39 +83,9 @@ static VT_VOID cs_sensor_status_with_repeating_signature_template(VT_CURRENTSENS
     VT_FLOAT duty_cycle_saved;
     VT_FLOAT relative_current_draw_saved;
 
-    VT_FLOAT offset_current_drift = 0;
-    VT_FLOAT feature_vector_drift = 0;
-
-    VT_BOOL offset_current_unavailable = false;
-
-    VT_UINT signatures_evaluated                  = 0;
-    VT_BOOL signature_feature_vector_compute_fail = false;
-    VT_BOOL signature_offset_current_compute_fail = false;
+    VT_UINT signatures_pending = 0;
 
-    if (cs_fetch_template_repeating_signature_offset_current(cs_object, &lowest_sample_freq_saved, &offset_current_saved))
-    {
-        offset_current_unavailable = true;
-    }
-    if (!offset_current_unavailable)
-    {
-        if (cs_repeating_raw_signature_fetch_stored_current_measurement(
-                cs_object, raw_signature, lowest_sample_freq_saved, VT_CS_SAMPLE_LENGTH) == VT_SUCCESS)
-        {
-            if (cs_repeating_signature_offset_current_compute(cs_object, raw_signature, VT_CS_SAMPLE_LENGTH, &offset_current) ==
-                VT_SUCCESS)
-            {
-                offset_current_drift = cs_repeating_signature_offset_current_evaluate(offset_current, offset_current_saved);
-            }
-            else
-            {
-                signature_offset_current_compute_fail = true;
-            }
-        }
-        else
-        {
-            signature_offset_current_compute_fail = true;
-        }
-    }
+    VT_CURRENTSENSE_RAW_SIGNATURES_READER* reader = cs_object->raw_signatures_reader;
 
     for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
     {
@@ -116,84 +99,291 @@ static VT_VOID cs_sensor_status_with_repeating_signature_template(VT_CURRENTSENS
             break;
         }
 
-        if (cs_repeating_raw_signature_fetch_stored_current_measurement(
-                cs_object, raw_signature, sampling_frequency_saved, VT_CS_SAMPLE_LENGTH))
+        if (reader->repeating_signatures_evaluated_mask & (1U << iter))
         {
-            signature_feature_vector_compute_fail = true;
-            break;
+            continue;
+        }
+
+        if (extrapolated_signature)
+        {
+            /* Extrapolation fails until the calibration range below the sampling frequency has filled */
+            if (cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_calibration(
+                    cs_object, extrapolated_signature, sampling_frequency_saved, cs_object->plan.sample_length))
+            {
+                if (evaluate_filled_only)
+                {
+                    signatures_pending++;
+                    continue;
+                }
+                reader->repeating_signatures_evaluated_mask |= (1U << iter);
+                reader->repeating_signatures_compute_fail = true;
+                continue;
+            }
+            reader->repeating_signatures_evaluated_mask |= (1U << iter);
+            raw_signature.current_measured = extrapolated_signature;
+            raw_signature.sample_length    = cs_object->plan.sample_length;
+        }
+        else
+        {
+            /* Slower signatures keep accumulating while the faster ones are evaluated */
+            if (evaluate_filled_only && !cs_repeating_raw_signature_buffer_filled(cs_object, iter, sampling_frequency_saved))
+            {
+                signatures_pending++;
+                continue;
+            }
+
+            reader->repeating_signatures_evaluated_mask |= (1U << iter);
+
+            if (cs_repeating_raw_signature_view(cs_object, iter, sampling_frequency_saved, &raw_signature) ||
+                raw_signature.sample_length != cs_object->plan.sample_length)
+            {
+                reader->repeating_signatures_compute_fail = true;
+                continue;
+            }
         }
 
         if (cs_repeating_signature_feature_vector_compute(cs_object,
-                raw_signature,
-                VT_CS_SAMPLE_LENGTH,
+                raw_signature.current_measured,
+                raw_signature.sample_length,
                 sampling_frequency_saved,
                 &signature_frequency,
                 &duty_cycle,
                 &relative_current_draw))
         {
-            signature_feature_vector_compute_fail = true;
-            break;
+            reader->repeating_signatures_compute_fail = true;
+            continue;
         }
-        feature_vector_drift += cs_repeating_signature_feature_vector_evaluate(signature_frequency,
+        reader->repeating_signatures_drift_sum += cs_repeating_signature_feature_vector_evaluate(signature_frequency,
             signature_frequency_saved,
             duty_cycle,
             duty_cycle_saved,
             relative_current_draw,
             relative_current_draw_saved);
-        signatures_evaluated++;
+        reader->repeating_signatures_tolerance_sum += cs_object->template_tolerance.repeating_signature_drift[iter];
+        reader->num_repeating_signatures_evaluated++;
+
+        reader->repeating_signatures_computed_mask |= (1U << iter);
+        reader->repeating_signatures_under_test[iter].sampling_freq      = sampling_frequency_saved;
+        reader->repeating_signatures_under_test[iter].signature_freq     = signature_frequency;
+        reader->repeating_signatures_under_test[iter].duty_cycle         = duty_cycle;
+        reader->repeating_signatures_under_test[iter].relative_curr_draw = relative_current_draw;
     }
+    return signatures_pending;
+}
+
+static VT_VOID cs_sensor_status_from_repeating_signatures_drift(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT offset_current_drift, VT_BOOL offset_current_unavailable)
+{
+    VT_UINT signatures_evaluated      = cs_object->raw_signatures_reader->num_repeating_signatures_evaluated;
+    VT_FLOAT feature_vector_drift     = 0;
+    VT_FLOAT feature_vector_tolerance = VT_CS_MAX_SIGNATURE_DRIFT;
+
     if (signatures_evaluated)
     {
-        feature_vector_drift /= signatures_evaluated;
+        feature_vector_drift     = cs_object->raw_signatures_reader->repeating_signatures_drift_sum / signatures_evaluated;
+        feature_vector_tolerance = cs_object->raw_signatures_reader->repeating_signatures_tolerance_sum / signatures_evaluated;
     }
 
-    if (signature_feature_vector_compute_fail || signature_offset_current_compute_fail)
+    if (cs_object->raw_signatures_reader->repeating_signatures_compute_fail)
     {
         cs_object->sensor_status = VT_SIGNATURE_COMPUTE_FAIL;
         cs_object->sensor_drift  = 100;
+        return;
     }
     else if ((signatures_evaluated == 0) && offset_current_unavailable)
     {
         cs_object->sensor_status = VT_SIGNATURE_DB_EMPTY;
         cs_object->sensor_drift  = 100;
+        return;
     }
-    else if ((offset_current_drift > VT_CS_MAX_AVG_CURR_DRIFT) || (feature_vector_drift > VT_CS_MAX_SIGNATURE_DRIFT))
+    else if ((offset_current_drift > cs_object->template_tolerance.offset_current_drift) ||
+             (feature_vector_drift > feature_vector_tolerance))
     {
         cs_object->sensor_status = VT_SIGNATURE_NOT_MATCHING;
-        if (signatures_evaluated && (!offset_current_unavailable))
-        {
-            cs_object->sensor_drift = (offset_current_drift + feature_vector_drift) / 2;
-        }
-        else if (signatures_evaluated)
+    }
+    else
+    {
+        cs_object->sensor_status = VT_SIGNATURE_MATCHING;
+    }
+
+    if (signatures_evaluated && (!offset_current_unavailable))
+    {
+        cs_object->sensor_drift = (offset_current_drift + feature_vector_drift) / 2;
+    }
+    else if (signatures_evaluated)
+    {
+        cs_object->sensor_drift = feature_vector_drift;
+    }
+    else
+    {
+        cs_object->sensor_drift = offset_current_drift;
+    }
+}
+
+static VT_VOID cs_sensor_status_with_repeating_signature_template(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_CURRENTSENSE_RAW_SIGNATURE_VIEW raw_signature;
+
+    VT_FLOAT lowest_sample_freq_saved;
+    VT_FLOAT offset_current;
+    VT_FLOAT offset_current_saved;
+
+    VT_FLOAT offset_current_drift = 0;
+
+    VT_BOOL offset_current_unavailable = false;
+
+    if (cs_fetch_template_repeating_signature_offset_current(cs_object, &lowest_sample_freq_saved, &offset_current_saved))
+    {
+        offset_current_unavailable = true;
+    }
+    if (!offset_current_unavailable)
+    {
+        /* Offset current is not tied to a template slot, the buffer is looked up by its sampling frequency */
+        if (cs_repeating_raw_signature_view(cs_object, VT_CS_MAX_SIGNATURES, lowest_sample_freq_saved, &raw_signature) ==
+                VT_SUCCESS &&
+            raw_signature.sample_length == cs_object->plan.sample_length)
         {
-            cs_object->sensor_drift = feature_vector_drift;
+            if (cs_repeating_signature_offset_current_compute(
+                    cs_object, raw_signature.current_measured, raw_signature.sample_length, &offset_current) == VT_SUCCESS)
+            {
+                offset_current_drift = cs_repeating_signature_offset_current_evaluate(offset_current, offset_current_saved);
+                cs_object->raw_signatures_reader->offset_current_under_test = offset_current;
+            }
+            else
+            {
+                cs_object->raw_signatures_reader->repeating_signatures_compute_fail = true;
+            }
         }
         else
         {
-            cs_object->sensor_drift = offset_current_drift;
+            cs_object->raw_signatures_reader->repeating_signatures_compute_fail = true;
         }
     }
-    else
+
+    /* Signatures already evaluated by cs_sensor_status_partial are not computed again */
+    cs_repeating_signatures_evaluate(cs_object, NULL, false);
+
+    cs_sensor_status_from_repeating_signatures_drift(cs_object, offset_current_drift, offset_current_unavailable);
+
+    cs_template_adapt_repeating_signatures(cs_object);
+
+    cs_repeating_signatures_evaluation_reset(cs_object);
+}
+
+VT_UINT cs_sensor_status_partial(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_UINT signatures_pending = 0;
+
+    if (cs_object->fingerprintdb.template_type == VT_CS_NON_REPEATING_SIGNATURE)
     {
-        cs_object->sensor_status = VT_SIGNATURE_MATCHING;
-        if (signatures_evaluated && (!offset_current_unavailable))
+        return 0;
+    }
+
+    signatures_pending = cs_repeating_signatures_evaluate(cs_object, NULL, true);
+
+    /* Report partial status once at least one signature has been evaluated, offset current needs the slowest buffer */
+    if (cs_object->raw_signatures_reader->num_repeating_signatures_evaluated ||
+        cs_object->raw_signatures_reader->repeating_signatures_compute_fail)
+    {
+        cs_sensor_status_from_repeating_signatures_drift(cs_object, 0, true);
+        cs_object->sensor_status_updated = true;
+    }
+
+    return signatures_pending;
+}
+
+VT_UINT cs_sensor_status_provisional(VT_CURRENTSENSE_OBJECT* cs_object, VT_BOOL evaluate_filled_only)
+{
+    VT_CURRENTSENSE_RAW_SIGNATURES_READER* reader = cs_object->raw_signatures_reader;
+    VT_CURRENTSENSE_SCRATCH_ARENA* arena          = &reader->scratch_arena;
+    VT_ULONG arena_mark                           = cs_arena_mark(arena);
+    VT_FLOAT* raw_signature                       = NULL;
+
+    VT_FLOAT lowest_sample_freq_saved;
+    VT_FLOAT offset_current;
+    VT_FLOAT offset_current_saved;
+
+    VT_FLOAT offset_current_drift      = 0;
+    VT_BOOL offset_current_unavailable = true;
+    VT_UINT signatures_pending         = 0;
+
+    /* The first calibration capture builds the template it would be checked against, it has no reference yet */
+    if (cs_object->mode == VT_MODE_CALIBRATE && cs_object->calibration.num_captures == 0)
+    {
+        return 0;
+    }
+
+    /* Template of the earlier captures only stands for some of the captures calibration will average */
+    if (cs_object->calibration.num_captures)
+    {
+        cs_object->template_confidence_metric =
+            (VT_CS_PROVISIONAL_TEMPLATE_CONFIDENCE * cs_object->calibration.num_captures) /
+            cs_object->calibration.num_captures_required;
+    }
+
+    if (cs_object->fingerprintdb.template_type == VT_CS_NON_REPEATING_SIGNATURE)
+    {
+        if (!evaluate_filled_only)
         {
-            cs_object->sensor_drift = (offset_current_drift + feature_vector_drift) / 2;
+            cs_sensor_status_with_non_repeating_signature_template(cs_object);
+            cs_object->sensor_status_updated = true;
         }
-        else if (signatures_evaluated)
+        return 0;
+    }
+
+    raw_signature = (VT_FLOAT*)cs_arena_alloc(arena, cs_object->plan.sample_length * sizeof(VT_FLOAT));
+    if (raw_signature == NULL)
+    {
+        return 0;
+    }
+
+    signatures_pending = cs_repeating_signatures_evaluate(cs_object, raw_signature, evaluate_filled_only);
+
+    if (!evaluate_filled_only &&
+        cs_fetch_template_repeating_signature_offset_current(cs_object, &lowest_sample_freq_saved, &offset_current_saved) ==
+            VT_SUCCESS)
+    {
+        offset_current_unavailable = false;
+        if (cs_repeating_raw_signature_fetch_extrapolated_current_measurement_for_calibration(
+                cs_object, raw_signature, lowest_sample_freq_saved, cs_object->plan.sample_length) == VT_SUCCESS &&
+            cs_repeating_signature_offset_current_compute(
+                cs_object, raw_signature, cs_object->plan.sample_length, &offset_current) == VT_SUCCESS)
         {
-            cs_object->sensor_drift = feature_vector_drift;
+            offset_current_drift = cs_repeating_signature_offset_current_evaluate(offset_current, offset_current_saved);
         }
         else
         {
-            cs_object->sensor_drift = offset_current_drift;
+            reader->repeating_signatures_compute_fail = true;
         }
     }
-    return;
+    cs_arena_release(arena, arena_mark);
+
+    if (!evaluate_filled_only)
+    {
+        cs_sensor_status_from_repeating_signatures_drift(cs_object, offset_current_drift, offset_current_unavailable);
+        cs_object->sensor_status_updated = true;
+        cs_repeating_signatures_evaluation_reset(cs_object);
+    }
+    else if (reader->num_repeating_signatures_evaluated || reader->repeating_signatures_compute_fail)
+    {
+        cs_sensor_status_from_repeating_signatures_drift(cs_object, 0, true);
+        cs_object->sensor_status_updated = true;
+    }
+
+    return signatures_pending;
 }
 
 VT_VOID cs_sensor_status(VT_CURRENTSENSE_OBJECT* cs_object)
 {
+    /* Capture statistics settle clear matches and gross failures without feature extraction */
+    cs_object->sensor_status_updated = true;
+    if (cs_precheck_sensor_status(cs_object) == VT_SUCCESS)
+    {
+        cs_repeating_signatures_evaluation_reset(cs_object);
+        return;
+    }
+    cs_object->precheck.num_full++;
+
     if (cs_object->fingerprintdb.template_type == VT_CS_NON_REPEATING_SIGNATURE)
     {
         cs_sensor_status_with_non_repeating_signature_template(cs_object);
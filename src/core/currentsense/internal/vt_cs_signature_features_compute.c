@@ -1,5 +1,6 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
+#include "vt_cs_arena.h"
 #include "vt_cs_signature_features.h"
 #include "vt_debug.h"
 #include <math.h>
@@ -11,44 +12,40 @@
 #define VT_CS_LOW_STD_DEVIATION_THRESHOLD 1.0f
 #define VT_CS_PEAK_DETECTOR_SEED_POINTS   2
 
-static VT_VOID autocorrelation(VT_FLOAT* raw_signature, VT_FLOAT* lag_array, VT_INT sample_length, VT_INT lag_length)
+static VT_VOID autocorrelation(
+    const VT_FLOAT* raw_signature, VT_FLOAT* autocorrelation_array, VT_INT sample_length, VT_INT lag_length)
 {
-    VT_FLOAT var_sum_average = 0;
-    for (VT_INT iter1 = 0; iter1 < sample_length; iter1++)
-    {
-        var_sum_average += raw_signature[iter1];
-    }
-    var_sum_average /= sample_length;
+    VT_FLOAT mean           = 0;
+    VT_FLOAT correlation    = 0;
+    VT_INT correlation_size = sample_length - lag_length;
+
     for (VT_INT iter1 = 0; iter1 < sample_length; iter1++)
     {
-        raw_signature[iter1] -= var_sum_average;
+        mean += raw_signature[iter1];
     }
-    for (VT_INT iter1 = 0; iter1 < lag_length; iter1++)
-    {
-        lag_array[iter1] = raw_signature[iter1];
-    }
-    VT_INT iter2 = 0;
-    VT_INT iter3 = 0;
-    for (iter3 = 0; iter3 < (sample_length - lag_length); iter3++)
+    mean /= sample_length;
+
+    /* The input is left untouched, the mean is removed on the fly */
+    for (VT_INT iter1 = 0; iter1 < correlation_size; iter1++)
     {
-        var_sum_average = 0;
-        for (iter2 = 0; iter2 < lag_length; iter2++)
+        correlation = 0;
+        for (VT_INT iter2 = 0; iter2 < lag_length; iter2++)
         {
-            var_sum_average += (raw_signature[(iter3 + iter2)] * lag_array[iter2]);
+            correlation += (raw_signature[iter1 + iter2] - mean) * (raw_signature[iter2] - mean);
         }
-        raw_signature[iter3] = var_sum_average;
+        autocorrelation_array[iter1] = correlation;
     }
-    for (VT_INT iter1 = 1; iter1 < sample_length - lag_length; iter1++)
+    for (VT_INT iter1 = 1; iter1 < correlation_size; iter1++)
     {
-        if (raw_signature[0])
+        if (autocorrelation_array[0])
         {
-            raw_signature[iter1] /= raw_signature[0];
+            autocorrelation_array[iter1] /= autocorrelation_array[0];
         }
     }
-    raw_signature[0] = 1;
+    autocorrelation_array[0] = 1;
 }
 
-static VT_UINT check_acr_peak_present(VT_FLOAT* raw_signature,
+static VT_UINT check_acr_peak_present(const VT_FLOAT* raw_signature,
     VT_UINT* index,
     VT_UINT period,
     VT_UINT* period_total,
@@ -82,46 +79,61 @@ static VT_UINT check_acr_peak_present(VT_FLOAT* raw_signature,
     }
 }
 
-static VT_UINT period_calculate(VT_FLOAT* raw_signature, VT_FLOAT* period)
+static VT_UINT period_calculate(VT_CURRENTSENSE_SCRATCH_ARENA* arena,
+    const VT_FLOAT* raw_signature,
+    VT_UINT sample_length,
+    VT_UINT auto_correlation_lag,
+    VT_FLOAT* period)
 {
-    VT_FLOAT raw_signature_copy[VT_CS_SAMPLE_LENGTH] = {0};
-    VT_FLOAT lag_array[VT_CS_AUTO_CORRELATION_LAG]   = {0};
-    VT_UINT peaks                                    = 0;
-    VT_UINT index                                    = 0;
-    VT_UINT period_total                             = 0;
-    *period                                          = 0;
-
-    for (VT_UINT iter = 0; iter < VT_CS_SAMPLE_LENGTH; iter++)
+    VT_ULONG arena_mark  = cs_arena_mark(arena);
+    VT_FLOAT* acr        = NULL;
+    VT_UINT acr_length   = 0;
+    VT_UINT peaks        = 0;
+    VT_UINT index        = 0;
+    VT_UINT period_total = 0;
+    *period              = 0;
+
+    if (sample_length <= auto_correlation_lag)
     {
-        raw_signature_copy[iter] = raw_signature[iter];
+        return VT_ERROR;
     }
-    autocorrelation(raw_signature_copy, lag_array, VT_CS_SAMPLE_LENGTH, VT_CS_AUTO_CORRELATION_LAG);
+    acr_length = sample_length - auto_correlation_lag;
 
-    for (VT_UINT iter = 2; iter < VT_CS_SAMPLE_LENGTH - VT_CS_AUTO_CORRELATION_LAG - 2; iter++)
+    /* One extra zeroed entry since peak detection looks one lag past the end */
+    acr = (VT_FLOAT*)cs_arena_alloc(arena, (acr_length + 1) * sizeof(VT_FLOAT));
+    if (acr == NULL)
+    {
+        return VT_ERROR;
+    }
+    acr[acr_length] = 0;
+
+    autocorrelation(raw_signature, acr, sample_length, auto_correlation_lag);
+
+    for (VT_UINT iter = 2; iter + 2 < acr_length; iter++)
     {
         index = iter;
-        if (((raw_signature_copy[iter] > raw_signature_copy[iter - 1]) ||
-                (raw_signature_copy[iter] > raw_signature_copy[iter - 2])) &&
-            ((raw_signature_copy[iter] > raw_signature_copy[iter + 1]) ||
-                (raw_signature_copy[iter] > raw_signature_copy[iter + 2])))
+        if (((acr[iter] > acr[iter - 1]) || (acr[iter] > acr[iter - 2])) &&
+            ((acr[iter] > acr[iter + 1]) || (acr[iter] > acr[iter + 2])))
         {
             period_total = 0;
             peaks        = 0;
-            while (index < VT_CS_SAMPLE_LENGTH - VT_CS_AUTO_CORRELATION_LAG)
+            while (index < acr_length)
             {
-                if (check_acr_peak_present(raw_signature_copy, &index, iter, &period_total, &peaks, VT_CS_MIN_CORRELATION) ==
-                    VT_ERROR)
+                if (check_acr_peak_present(acr, &index, iter, &period_total, &peaks, VT_CS_MIN_CORRELATION) == VT_ERROR)
                 {
                     break;
                 }
             }
-            if (index > VT_CS_SAMPLE_LENGTH - VT_CS_AUTO_CORRELATION_LAG)
+            if (index > acr_length)
             {
                 *period = iter;
                 break;
             }
         }
     }
+
+    cs_arena_release(arena, arena_mark);
+
     if (peaks < 2)
     {
         *period = 0;
@@ -135,7 +147,7 @@ static VT_UINT period_calculate(VT_FLOAT* raw_signature, VT_FLOAT* period)
 }
 
 static VT_FLOAT average_calculate(
-    VT_FLOAT* raw_signature, VT_UINT sample_length, VT_UINT start_point, VT_UINT count_up_count_down)
+    const VT_FLOAT* raw_signature, VT_UINT sample_length, VT_UINT start_point, VT_UINT count_up_count_down)
 {
     VT_FLOAT avg_curr = 0;
     if (count_up_count_down == VT_CS_BUFFER_COUNT_UP)
@@ -160,7 +172,7 @@ static VT_FLOAT average_calculate(
     return avg_curr;
 }
 
-static VT_FLOAT std_dev(VT_FLOAT* raw_signature, VT_UINT sample_length, VT_UINT start_point, VT_UINT count_up_count_down)
+static VT_FLOAT std_dev(const VT_FLOAT* raw_signature, VT_UINT sample_length, VT_UINT start_point, VT_UINT count_up_count_down)
 {
     VT_FLOAT mean               = average_calculate(raw_signature, sample_length, start_point, count_up_count_down);
     VT_FLOAT standard_deviation = 0.0f;
@@ -182,7 +194,7 @@ static VT_FLOAT std_dev(VT_FLOAT* raw_signature, VT_UINT sample_length, VT_UINT
     return (float)sqrt(standard_deviation / sample_length);
 }
 
-static VT_VOID min_value(VT_FLOAT* raw_signature, VT_UINT sample_length, VT_FLOAT* min_value, VT_BOOL* datapoint_visited)
+static VT_VOID min_value(const VT_FLOAT* raw_signature, VT_UINT sample_length, VT_FLOAT* min_value, VT_BOOL* datapoint_visited)
 {
     VT_FLOAT current_min_value     = VT_CS_FIND_MINMAX_SEED_MIN_VALUE;
     VT_UINT current_min_value_iter = 0;
@@ -203,7 +215,7 @@ static VT_VOID min_value(VT_FLOAT* raw_signature, VT_UINT sample_length, VT_FLOA
     *min_value                                = current_min_value;
 }
 
-static VT_VOID max_value(VT_FLOAT* raw_signature, VT_UINT sample_length, VT_FLOAT* max_value, VT_BOOL* datapoint_visited)
+static VT_VOID max_value(const VT_FLOAT* raw_signature, VT_UINT sample_length, VT_FLOAT* max_value, VT_BOOL* datapoint_visited)
 {
     VT_FLOAT current_max_value     = VT_CS_FIND_MINMAX_SEED_MAX_VALUE;
     VT_UINT current_max_value_iter = 0;
@@ -224,22 +236,24 @@ static VT_VOID max_value(VT_FLOAT* raw_signature, VT_UINT sample_length, VT_FLOA
     *max_value                                = current_max_value;
 }
 
-static VT_VOID binary_state_current_compute(VT_FLOAT* raw_signature,
+static VT_UINT binary_state_current_compute(VT_CURRENTSENSE_SCRATCH_ARENA* arena,
+    const VT_FLOAT* raw_signature,
     VT_UINT sample_length,
     VT_FLOAT* curr_draw_active,
     VT_FLOAT* curr_draw_standby,
     VT_UINT* datapoints_active,
     VT_UINT* datapoints_standby)
 {
-    VT_FLOAT state_array[VT_CS_SAMPLE_LENGTH]   = {0};
-    bool datapoint_visited[VT_CS_SAMPLE_LENGTH] = {0};
-    VT_UINT low_state_count                     = 0;
-    VT_UINT high_state_count                    = 0;
-    VT_FLOAT z_score_low                        = 0;
-    VT_FLOAT z_score_high                       = 0;
-    VT_FLOAT average_low_diff_increase          = 0;
-    VT_FLOAT average_high_diff_increase         = 0;
-    VT_FLOAT min_max_value                      = 0;
+    VT_ULONG arena_mark                 = cs_arena_mark(arena);
+    VT_FLOAT* state_array               = NULL;
+    VT_BOOL* datapoint_visited          = NULL;
+    VT_UINT low_state_count             = 0;
+    VT_UINT high_state_count            = 0;
+    VT_FLOAT z_score_low                = 0;
+    VT_FLOAT z_score_high               = 0;
+    VT_FLOAT average_low_diff_increase  = 0;
+    VT_FLOAT average_high_diff_increase = 0;
+    VT_FLOAT min_max_value              = 0;
     VT_UINT num_seedpoints =
         sample_length > (2 * VT_CS_PEAK_DETECTOR_SEED_POINTS) ? VT_CS_PEAK_DETECTOR_SEED_POINTS : (sample_length / 2);
     VT_UINT num_seedpoints_added = 0;
@@ -251,6 +265,19 @@ static VT_VOID binary_state_current_compute(VT_FLOAT* raw_signature,
     *curr_draw_standby  = 0;
     *datapoints_standby = 0;
 
+    state_array       = (VT_FLOAT*)cs_arena_alloc(arena, sample_length * sizeof(VT_FLOAT));
+    datapoint_visited = (VT_BOOL*)cs_arena_alloc(arena, sample_length * sizeof(VT_BOOL));
+    if (state_array == NULL || datapoint_visited == NULL)
+    {
+        cs_arena_release(arena, arena_mark);
+        return VT_ERROR;
+    }
+    for (VT_UINT iter = 0; iter < sample_length; iter++)
+    {
+        state_array[iter]       = 0;
+        datapoint_visited[iter] = false;
+    }
+
     while (num_seedpoints_added < num_seedpoints)
     {
         min_value(raw_signature, sample_length, &state_array[low_state_count], datapoint_visited);
@@ -362,16 +389,20 @@ static VT_VOID binary_state_current_compute(VT_FLOAT* raw_signature,
         *curr_draw_standby = average_calculate(state_array, low_state_count, 0, VT_CS_BUFFER_COUNT_UP);
     }
     *datapoints_standby = low_state_count;
+
+    cs_arena_release(arena, arena_mark);
+    return VT_SUCCESS;
 }
 
 VT_UINT cs_repeating_signature_feature_vector_compute(VT_CURRENTSENSE_OBJECT* cs_object,
-    VT_FLOAT* raw_signature,
+    const VT_FLOAT* raw_signature,
     VT_UINT raw_signature_length,
     VT_FLOAT sampling_frequency,
     VT_FLOAT* signature_frequency,
     VT_FLOAT* duty_cycle,
     VT_FLOAT* relative_current_draw)
 {
+    VT_CURRENTSENSE_SCRATCH_ARENA* arena = &cs_object->raw_signatures_reader->scratch_arena;
     VT_FLOAT signature_period_datapoints = 1;
     VT_FLOAT curr_draw_active            = 0;
     VT_FLOAT curr_draw_standby           = 0;
@@ -384,15 +415,28 @@ VT_UINT cs_repeating_signature_feature_vector_compute(VT_CURRENTSENSE_OBJECT* cs
     VT_INT frac;
 #endif /* VT_LOG_LEVEL > 2 */
 
-    if (period_calculate(raw_signature, &signature_period_datapoints) == VT_SUCCESS)
+    if (period_calculate(arena,
+            raw_signature,
+            raw_signature_length,
+            cs_object->plan.auto_correlation_lag,
+            &signature_period_datapoints) == VT_SUCCESS)
     {
         if (signature_period_datapoints)
         {
             *signature_frequency = sampling_frequency / signature_period_datapoints;
         }
 
-        binary_state_current_compute(
-            raw_signature, raw_signature_length, &curr_draw_active, &curr_draw_standby, &datapoints_active, &datapoints_standby);
+        if (binary_state_current_compute(arena,
+                raw_signature,
+                raw_signature_length,
+                &curr_draw_active,
+                &curr_draw_standby,
+                &datapoints_active,
+                &datapoints_standby))
+        {
+            VTLogDebug("Error in computing feature vectors for repeating signature\r\n");
+            return VT_ERROR;
+        }
 
         if (datapoints_standby || datapoints_active)
         {
@@ -430,8 +474,9 @@ VT_UINT cs_repeating_signature_feature_vector_compute(VT_CURRENTSENSE_OBJECT* cs
 }
 
 VT_UINT cs_repeating_signature_offset_current_compute(
-    VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT* raw_signature, VT_UINT raw_signature_length, VT_FLOAT* offset_current)
+    VT_CURRENTSENSE_OBJECT* cs_object, const VT_FLOAT* raw_signature, VT_UINT raw_signature_length, VT_FLOAT* offset_current)
 {
+    VT_CURRENTSENSE_SCRATCH_ARENA* arena = &cs_object->raw_signatures_reader->scratch_arena;
     VT_FLOAT curr_draw_active  = 0;
     VT_FLOAT curr_draw_standby = 0;
     VT_UINT datapoints_active  = 1;
@@ -443,8 +488,16 @@ VT_UINT cs_repeating_signature_offset_current_compute(
     VT_INT frac;
 #endif /* VT_LOG_LEVEL > 2 */
 
-    binary_state_current_compute(
-        raw_signature, raw_signature_length, &curr_draw_active, &curr_draw_standby, &datapoints_active, &datapoints_standby);
+    if (binary_state_current_compute(arena,
+            raw_signature,
+            raw_signature_length,
+            &curr_draw_active,
+            &curr_draw_standby,
+            &datapoints_active,
+            &datapoints_standby))
+    {
+        return VT_ERROR;
+    }
 
     *offset_current = curr_draw_standby;
 
@@ -473,11 +526,12 @@ VT_UINT cs_repeating_signature_offset_current_compute(
 }
 
 VT_UINT cs_non_repeating_signature_average_current_compute(VT_CURRENTSENSE_OBJECT* cs_object,
-    VT_FLOAT* raw_signature,
+    const VT_FLOAT* raw_signature,
     VT_UINT raw_signature_length,
     VT_FLOAT* avg_curr_on,
     VT_FLOAT* avg_curr_off)
 {
+    VT_CURRENTSENSE_SCRATCH_ARENA* arena = &cs_object->raw_signatures_reader->scratch_arena;
     VT_FLOAT curr_draw_active  = 0;
     VT_FLOAT curr_draw_standby = 0;
     VT_UINT datapoints_active  = 1;
@@ -489,8 +543,16 @@ VT_UINT cs_non_repeating_signature_average_current_compute(VT_CURRENTSENSE_OBJEC
     VT_INT frac;
 #endif /* VT_LOG_LEVEL > 2 */
 
-    binary_state_current_compute(
-        raw_signature, raw_signature_length, &curr_draw_active, &curr_draw_standby, &datapoints_active, &datapoints_standby);
+    if (binary_state_current_compute(arena,
+            raw_signature,
+            raw_signature_length,
+            &curr_draw_active,
+            &curr_draw_standby,
+            &datapoints_active,
+            &datapoints_standby))
+    {
+        return VT_ERROR;
+    }
 
     *avg_curr_on  = curr_draw_active;
     *avg_curr_off = curr_draw_standby;
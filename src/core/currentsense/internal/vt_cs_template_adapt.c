@@ -0,0 +1,254 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_cs_signature_features.h"
+#include "vt_cs_template_adapt.h"
+#include "vt_debug.h"
+#include <math.h>
+
+static VT_FLOAT cs_template_adapt_feature(VT_FLOAT saved, VT_FLOAT under_test, VT_FLOAT alpha)
+{
+    return saved + (alpha * (under_test - saved));
+}
+
+static VT_BOOL cs_template_adaptation_allowed(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    /* Checks against a template still being calibrated do not move it */
+    if (!cs_object->adaptation.enabled || cs_object->mode != VT_MODE_RUNTIME_EVALUATE ||
+        cs_object->sensor_status != VT_SIGNATURE_MATCHING || cs_object->sensor_drift > VT_CS_ADAPTATION_MAX_DRIFT)
+    {
+        return false;
+    }
+
+    /* Adaptation only tracks the template it was calibrated against */
+    if (cs_object->adaptation.baseline.template_type != cs_object->fingerprintdb.template_type)
+    {
+        return false;
+    }
+    return true;
+}
+
+static VT_VOID cs_template_adaptation_log(VT_FLOAT cumulative_drift, VT_BOOL rejected)
+{
+#if VT_LOG_LEVEL > 2
+    int32_t decimal  = cumulative_drift;
+    float frac_float = cumulative_drift - (float)decimal;
+    int32_t frac     = frac_float * 10000;
+    VTLogDebug("Template adaptation %s, drift from baseline: %d.%04d \r\n", rejected ? "rejected" : "applied", decimal, frac);
+#else
+    (VT_VOID)cumulative_drift;
+    (VT_VOID)rejected;
+#endif /* VT_LOG_LEVEL > 2 */
+}
+
+/* Sampling frequencies survive a round trip through the reported template up to its printed precision */
+static VT_BOOL cs_template_adaptation_same_frequency(VT_FLOAT frequency, VT_FLOAT baseline_frequency)
+{
+    return fabsf(frequency - baseline_frequency) <= (fabsf(baseline_frequency) * 1e-3f);
+}
+
+/* Drift (%) of the whole template from the baseline, VT_CS_ADAPTATION_MAX_CUMULATIVE_DRIFT + 1 when it was calibrated
+ * at other sampling frequencies and cannot have been adapted from it */
+static VT_FLOAT cs_template_adaptation_baseline_drift(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    const VT_CURRENTSENSE_DATABASE* saved    = &(cs_object->fingerprintdb);
+    const VT_CURRENTSENSE_DATABASE* baseline = &(cs_object->adaptation.baseline);
+    VT_FLOAT unrelated                       = VT_CS_ADAPTATION_MAX_CUMULATIVE_DRIFT + 1;
+    VT_FLOAT feature_vector_drift            = 0;
+    VT_FLOAT drift;
+
+    if (saved->template_type != baseline->template_type)
+    {
+        return unrelated;
+    }
+
+    if (saved->template_type == VT_CS_NON_REPEATING_SIGNATURE)
+    {
+        return cs_non_repeating_signature_average_current_evaluate(saved->template.non_repeating_signature.avg_curr_on,
+            baseline->template.non_repeating_signature.avg_curr_on,
+            saved->template.non_repeating_signature.avg_curr_off,
+            baseline->template.non_repeating_signature.avg_curr_off);
+    }
+
+    if (saved->template.repeating_signatures.num_signatures != baseline->template.repeating_signatures.num_signatures ||
+        saved->template.repeating_signatures.num_signatures == 0 ||
+        (saved->template.repeating_signatures.offset_current == VT_DATA_NOT_AVAILABLE) !=
+            (baseline->template.repeating_signatures.offset_current == VT_DATA_NOT_AVAILABLE))
+    {
+        return unrelated;
+    }
+
+    for (VT_UINT iter = 0; iter < saved->template.repeating_signatures.num_signatures; iter++)
+    {
+        const VT_CURRENTSENSE_REPEATING_SIGNATURE_FEATURE_VECTOR* signature =
+            &(saved->template.repeating_signatures.signatures[iter]);
+        const VT_CURRENTSENSE_REPEATING_SIGNATURE_FEATURE_VECTOR* baseline_signature =
+            &(baseline->template.repeating_signatures.signatures[iter]);
+
+        if (!cs_template_adaptation_same_frequency(signature->sampling_freq, baseline_signature->sampling_freq))
+        {
+            return unrelated;
+        }
+        feature_vector_drift += cs_repeating_signature_feature_vector_evaluate(signature->signature_freq,
+            baseline_signature->signature_freq,
+            signature->duty_cycle,
+            baseline_signature->duty_cycle,
+            signature->relative_curr_draw,
+            baseline_signature->relative_curr_draw);
+    }
+
+    /* Weighed as the cumulative drift of an adaptation step */
+    drift = feature_vector_drift / saved->template.repeating_signatures.num_signatures;
+    if (saved->template.repeating_signatures.offset_current != VT_DATA_NOT_AVAILABLE)
+    {
+        drift = (drift + cs_repeating_signature_offset_current_evaluate(saved->template.repeating_signatures.offset_current,
+                             baseline->template.repeating_signatures.offset_current)) /
+                2;
+    }
+    return drift;
+}
+
+/* Every matching evaluation nudges the template, it is only reported once it moved VT_CS_ADAPTATION_REPORT_DRIFT (%)
+ * from the baseline since the last report */
+static VT_VOID cs_template_adaptation_report(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    if (fabsf(cs_object->adaptation.cumulative_drift - cs_object->adaptation.reported_drift) < VT_CS_ADAPTATION_REPORT_DRIFT)
+    {
+        return;
+    }
+    cs_object->adaptation.reported_drift = cs_object->adaptation.cumulative_drift;
+    cs_object->db_updated                = VT_DB_UPDATED;
+}
+
+VT_VOID cs_template_adaptation_baseline_set(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    cs_object->adaptation.baseline         = cs_object->fingerprintdb;
+    cs_object->adaptation.num_updates      = 0;
+    cs_object->adaptation.num_rejected     = 0;
+    cs_object->adaptation.cumulative_drift = 0;
+    cs_object->adaptation.reported_drift   = 0;
+}
+
+VT_UINT cs_template_adaptation_template_synced(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_FLOAT drift = cs_template_adaptation_baseline_drift(cs_object);
+
+    /* A template reported after adapting comes back within the cap and keeps the baseline it drifted from, so the cap
+     * still bounds the drift since calibration. Anything else was calibrated elsewhere and becomes the baseline */
+    if (drift > VT_CS_ADAPTATION_MAX_CUMULATIVE_DRIFT)
+    {
+        cs_template_adaptation_baseline_set(cs_object);
+        return VT_ERROR;
+    }
+    cs_object->adaptation.cumulative_drift = drift;
+    cs_object->adaptation.reported_drift   = drift;
+    return VT_SUCCESS;
+}
+
+VT_VOID cs_template_adapt_repeating_signatures(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    VT_CURRENTSENSE_RAW_SIGNATURES_READER* reader        = cs_object->raw_signatures_reader;
+    VT_CURRENTSENSE_REPEATING_SIGNATURES_TEMPLATE* saved = &(cs_object->fingerprintdb.template.repeating_signatures);
+    const VT_CURRENTSENSE_REPEATING_SIGNATURES_TEMPLATE* baseline =
+        &(cs_object->adaptation.baseline.template.repeating_signatures);
+    VT_CURRENTSENSE_REPEATING_SIGNATURES_TEMPLATE adapted;
+    VT_FLOAT alpha                = cs_object->adaptation.alpha;
+    VT_FLOAT feature_vector_drift = 0;
+    VT_FLOAT offset_current_drift = 0;
+    VT_FLOAT cumulative_drift     = 0;
+    VT_UINT signatures_adapted    = 0;
+
+    if (!cs_template_adaptation_allowed(cs_object) || saved->num_signatures != baseline->num_signatures)
+    {
+        return;
+    }
+
+    adapted = *saved;
+    for (VT_UINT iter = 0; iter < adapted.num_signatures; iter++)
+    {
+        if (!(reader->repeating_signatures_computed_mask & (1U << iter)))
+        {
+            continue;
+        }
+        adapted.signatures[iter].signature_freq = cs_template_adapt_feature(
+            adapted.signatures[iter].signature_freq, reader->repeating_signatures_under_test[iter].signature_freq, alpha);
+        adapted.signatures[iter].duty_cycle = cs_template_adapt_feature(
+            adapted.signatures[iter].duty_cycle, reader->repeating_signatures_under_test[iter].duty_cycle, alpha);
+        adapted.signatures[iter].relative_curr_draw = cs_template_adapt_feature(adapted.signatures[iter].relative_curr_draw,
+            reader->repeating_signatures_under_test[iter].relative_curr_draw,
+            alpha);
+
+        feature_vector_drift += cs_repeating_signature_feature_vector_evaluate(adapted.signatures[iter].signature_freq,
+            baseline->signatures[iter].signature_freq,
+            adapted.signatures[iter].duty_cycle,
+            baseline->signatures[iter].duty_cycle,
+            adapted.signatures[iter].relative_curr_draw,
+            baseline->signatures[iter].relative_curr_draw);
+        signatures_adapted++;
+    }
+
+    if (adapted.offset_current != VT_DATA_NOT_AVAILABLE && reader->offset_current_under_test != VT_DATA_NOT_AVAILABLE)
+    {
+        adapted.offset_current = cs_template_adapt_feature(adapted.offset_current, reader->offset_current_under_test, alpha);
+        offset_current_drift   = cs_repeating_signature_offset_current_evaluate(adapted.offset_current, baseline->offset_current);
+    }
+
+    if (signatures_adapted == 0)
+    {
+        return;
+    }
+
+    /* Same weighting as the sensor drift reported by cs_sensor_status */
+    cumulative_drift = feature_vector_drift / signatures_adapted;
+    if (adapted.offset_current != VT_DATA_NOT_AVAILABLE && reader->offset_current_under_test != VT_DATA_NOT_AVAILABLE)
+    {
+        cumulative_drift = (cumulative_drift + offset_current_drift) / 2;
+    }
+
+    if (cumulative_drift > VT_CS_ADAPTATION_MAX_CUMULATIVE_DRIFT)
+    {
+        cs_object->adaptation.num_rejected++;
+        cs_template_adaptation_log(cumulative_drift, true);
+        return;
+    }
+
+    *saved                                 = adapted;
+    cs_object->adaptation.cumulative_drift = cumulative_drift;
+    cs_object->adaptation.num_updates++;
+    cs_template_adaptation_report(cs_object);
+    cs_template_adaptation_log(cumulative_drift, false);
+}
+
+VT_VOID cs_template_adapt_non_repeating_signature(VT_CURRENTSENSE_OBJECT* cs_object, VT_FLOAT avg_curr_on, VT_FLOAT avg_curr_off)
+{
+    VT_CURRENTSENSE_NON_REPEATING_SIGNATURE_TEMPLATE* saved = &(cs_object->fingerprintdb.template.non_repeating_signature);
+    const VT_CURRENTSENSE_NON_REPEATING_SIGNATURE_TEMPLATE* baseline =
+        &(cs_object->adaptation.baseline.template.non_repeating_signature);
+    VT_FLOAT alpha = cs_object->adaptation.alpha;
+    VT_FLOAT adapted_avg_curr_on;
+    VT_FLOAT adapted_avg_curr_off;
+    VT_FLOAT cumulative_drift;
+
+    if (!cs_template_adaptation_allowed(cs_object))
+    {
+        return;
+    }
+
+    adapted_avg_curr_on  = cs_template_adapt_feature(saved->avg_curr_on, avg_curr_on, alpha);
+    adapted_avg_curr_off = cs_template_adapt_feature(saved->avg_curr_off, avg_curr_off, alpha);
+    cumulative_drift     = cs_non_repeating_signature_average_current_evaluate(
+        adapted_avg_curr_on, baseline->avg_curr_on, adapted_avg_curr_off, baseline->avg_curr_off);
+
+    if (cumulative_drift > VT_CS_ADAPTATION_MAX_CUMULATIVE_DRIFT)
+    {
+        cs_object->adaptation.num_rejected++;
+        cs_template_adaptation_log(cumulative_drift, true);
+        return;
+    }
+
+    saved->avg_curr_on                     = adapted_avg_curr_on;
+    saved->avg_curr_off                    = adapted_avg_curr_off;
+    cs_object->adaptation.cumulative_drift = cumulative_drift;
+    cs_object->adaptation.num_updates++;
+    cs_template_adaptation_report(cs_object);
+    cs_template_adaptation_log(cumulative_drift, false);
+}
@@ -0,0 +1,22 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_cs_api.h"
+#include "vt_cs_buffer_pool.h"
+
+VT_UINT vt_currentsense_buffer_pool_initialize(VT_CURRENTSENSE_BUFFER_POOL* buffer_pool, VT_CHAR* buffer, VT_ULONG buffer_size)
+{
+    buffer_pool->buffer      = buffer;
+    buffer_pool->buffer_size = buffer_size;
+    buffer_pool->num_objects = 0;
+
+    if (buffer == NULL || buffer_size < VT_CS_RAW_SIGNATURES_BUFFER_SIZE(0))
+    {
+        return VT_ERROR;
+    }
+    return VT_SUCCESS;
+}
+
+VT_ULONG vt_currentsense_object_raw_signatures_buffer_size(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    return VT_CS_RAW_SIGNATURES_BUFFER_SIZE(cs_raw_signatures_required_repeating_buffers(cs_object));
+}
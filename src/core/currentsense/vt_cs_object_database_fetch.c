@@ -1,164 +1,128 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
+#include "vt_codec_api.h"
 #include "vt_cs_api.h"
 #include "vt_cs_database.h"
+#include "vt_debug.h"
 #include <string.h>
 
+/* Appends to a field whose current length is tracked by the caller, a length of zero overwrites the field */
+static VT_VOID cs_database_fetch_field(VT_UCHAR* field, VT_ULONG field_size, VT_ULONG* field_length, VT_FLOAT value)
+{
+    if (vt_codec_csv_append_fixed((VT_CHAR*)field, field_size, field_length, value, VT_CODEC_CSV_DECIMALS))
+    {
+        VTLogError("Flattened Database Buffer Overflow! \r\n");
+    }
+}
+
+static VT_VOID cs_database_fetch_count(VT_UCHAR* field, VT_ULONG field_size, VT_ULONG value, VT_UINT min_digits)
+{
+    VT_ULONG length = 0;
+
+    if (vt_codec_csv_append_unsigned((VT_CHAR*)field, field_size, &length, value, min_digits))
+    {
+        VTLogError("Flattened Database Buffer Overflow! \r\n");
+    }
+}
+
 VT_VOID vt_currentsense_object_database_fetch(VT_CURRENTSENSE_OBJECT* cs_object,
     VT_CURRENTSENSE_DATABASE_FLATTENED* flattened_db,
     VT_BOOL* db_updated,
     VT_UINT* template_confidence_metric)
 {
-    VT_CHAR string_buffer[40];
-    VT_CHAR string_element[10];
-    VT_INT decimal;
-    VT_FLOAT frac_float;
-    VT_INT frac;
-
-    memset(string_buffer, 0, sizeof(string_buffer));
-    snprintf(string_buffer, sizeof(string_buffer), "%03d", cs_object->fingerprintdb.template_type);
-    strcpy((VT_CHAR*)flattened_db->template_type, string_buffer);
+    VT_CURRENTSENSE_REPEATING_SIGNATURES_TEMPLATE* repeating_signatures =
+        &(cs_object->fingerprintdb.template.repeating_signatures);
+    VT_CURRENTSENSE_NON_REPEATING_SIGNATURE_TEMPLATE* non_repeating_signature =
+        &(cs_object->fingerprintdb.template.non_repeating_signature);
+    VT_ULONG length                    = 0;
+    VT_ULONG sampling_freq_length      = 0;
+    VT_ULONG signature_freq_length     = 0;
+    VT_ULONG relative_curr_draw_length = 0;
+    VT_ULONG duty_cycle_length         = 0;
+
+    cs_database_fetch_count(
+        flattened_db->template_type, sizeof(flattened_db->template_type), cs_object->fingerprintdb.template_type, 3);
 
     if (cs_object->fingerprintdb.template_type == VT_CS_REPEATING_SIGNATURE)
     {
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(
-            string_buffer, sizeof(string_buffer), "%03d", cs_object->fingerprintdb.template.repeating_signatures.num_signatures);
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_num_signatures, string_buffer);
-
-        decimal    = cs_object->fingerprintdb.template.repeating_signatures.offset_current;
-        frac_float = cs_object->fingerprintdb.template.repeating_signatures.offset_current - (VT_FLOAT)decimal;
-        frac       = frac_float * 10000;
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d.%04d", decimal, frac);
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_offset_curr, string_buffer);
-
-        decimal    = cs_object->fingerprintdb.template.repeating_signatures.lowest_sample_freq;
-        frac_float = cs_object->fingerprintdb.template.repeating_signatures.lowest_sample_freq - (VT_FLOAT)decimal;
-        frac       = frac_float * 10000;
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d.%04d", decimal, frac);
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_lowest_sample_freq, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        for (VT_UINT iter = 0; iter < cs_object->fingerprintdb.template.repeating_signatures.num_signatures; iter++)
-        {
-            decimal = cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].sampling_freq;
-            frac_float =
-                cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].sampling_freq - (VT_FLOAT)decimal;
-            frac = frac_float * 10000;
-            memset(string_element, 0, sizeof(string_element));
-            snprintf(string_element, sizeof(string_element), "%d.%04d", decimal, frac);
-            if (iter > 0)
-            {
-                strcat(string_buffer, ",");
-            }
-            strcat(string_buffer, string_element);
-        }
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_sampling_freq, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        for (VT_UINT iter = 0; iter < cs_object->fingerprintdb.template.repeating_signatures.num_signatures; iter++)
+        cs_database_fetch_count(flattened_db->repeating_signature_num_signatures,
+            sizeof(flattened_db->repeating_signature_num_signatures),
+            repeating_signatures->num_signatures,
+            3);
+        cs_database_fetch_field(flattened_db->repeating_signature_offset_curr,
+            sizeof(flattened_db->repeating_signature_offset_curr),
+            &length,
+            repeating_signatures->offset_current);
+        length = 0;
+        cs_database_fetch_field(flattened_db->repeating_signature_lowest_sample_freq,
+            sizeof(flattened_db->repeating_signature_lowest_sample_freq),
+            &length,
+            repeating_signatures->lowest_sample_freq);
+
+        // Each list is appended in place at its tracked length, a single pass over the signatures
+        flattened_db->repeating_signature_sampling_freq[0]      = '\0';
+        flattened_db->repeating_signature_freq[0]               = '\0';
+        flattened_db->repeating_signature_relative_curr_draw[0] = '\0';
+        flattened_db->repeating_signature_duty_cycle[0]         = '\0';
+        for (VT_UINT iter = 0; iter < repeating_signatures->num_signatures && iter < VT_CS_MAX_SIGNATURES; iter++)
         {
-            decimal = cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].signature_freq;
-            frac_float =
-                cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].signature_freq - (VT_FLOAT)decimal;
-            frac = frac_float * 10000;
-            memset(string_element, 0, sizeof(string_element));
-            snprintf(string_element, sizeof(string_element), "%d.%04d", decimal, frac);
-            if (iter > 0)
-            {
-                strcat(string_buffer, ",");
-            }
-            strcat(string_buffer, string_element);
+            cs_database_fetch_field(flattened_db->repeating_signature_sampling_freq,
+                sizeof(flattened_db->repeating_signature_sampling_freq),
+                &sampling_freq_length,
+                repeating_signatures->signatures[iter].sampling_freq);
+            cs_database_fetch_field(flattened_db->repeating_signature_freq,
+                sizeof(flattened_db->repeating_signature_freq),
+                &signature_freq_length,
+                repeating_signatures->signatures[iter].signature_freq);
+            cs_database_fetch_field(flattened_db->repeating_signature_relative_curr_draw,
+                sizeof(flattened_db->repeating_signature_relative_curr_draw),
+                &relative_curr_draw_length,
+                repeating_signatures->signatures[iter].relative_curr_draw);
+            cs_database_fetch_field(flattened_db->repeating_signature_duty_cycle,
+                sizeof(flattened_db->repeating_signature_duty_cycle),
+                &duty_cycle_length,
+                repeating_signatures->signatures[iter].duty_cycle);
         }
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_freq, string_buffer);
 
-        memset(string_buffer, 0, sizeof(string_buffer));
-        for (VT_UINT iter = 0; iter < cs_object->fingerprintdb.template.repeating_signatures.num_signatures; iter++)
-        {
-            decimal = cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].relative_curr_draw;
-            frac_float =
-                cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].relative_curr_draw - (VT_FLOAT)decimal;
-            frac = frac_float * 10000;
-            memset(string_element, 0, sizeof(string_element));
-            snprintf(string_element, sizeof(string_element), "%d.%04d", decimal, frac);
-            if (iter > 0)
-            {
-                strcat(string_buffer, ",");
-            }
-            strcat(string_buffer, string_element);
-        }
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_relative_curr_draw, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        for (VT_UINT iter = 0; iter < cs_object->fingerprintdb.template.repeating_signatures.num_signatures; iter++)
-        {
-            decimal    = cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].duty_cycle;
-            frac_float = cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].duty_cycle - (VT_FLOAT)decimal;
-            frac       = frac_float * 10000;
-            memset(string_element, 0, sizeof(string_element));
-            snprintf(string_element, sizeof(string_element), "%d.%04d", decimal, frac);
-            if (iter > 0)
-            {
-                strcat(string_buffer, ",");
-            }
-            strcat(string_buffer, string_element);
-        }
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_duty_cycle, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d", 0);
-        strcpy((VT_CHAR*)flattened_db->non_repeating_signature_avg_curr_off, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d", 0);
-        strcpy((VT_CHAR*)flattened_db->non_repeating_signature_avg_curr_on, string_buffer);
+        cs_database_fetch_count(flattened_db->non_repeating_signature_avg_curr_off,
+            sizeof(flattened_db->non_repeating_signature_avg_curr_off),
+            0,
+            1);
+        cs_database_fetch_count(
+            flattened_db->non_repeating_signature_avg_curr_on, sizeof(flattened_db->non_repeating_signature_avg_curr_on), 0, 1);
     }
 
     else if (cs_object->fingerprintdb.template_type == VT_CS_NON_REPEATING_SIGNATURE)
     {
-        decimal    = cs_object->fingerprintdb.template.non_repeating_signature.avg_curr_off;
-        frac_float = cs_object->fingerprintdb.template.non_repeating_signature.avg_curr_off - (VT_FLOAT)decimal;
-        frac       = frac_float * 10000;
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d.%04d", decimal, frac);
-        strcpy((VT_CHAR*)flattened_db->non_repeating_signature_avg_curr_off, string_buffer);
-
-        decimal    = cs_object->fingerprintdb.template.non_repeating_signature.avg_curr_on;
-        frac_float = cs_object->fingerprintdb.template.non_repeating_signature.avg_curr_on - (VT_FLOAT)decimal;
-        frac       = frac_float * 10000;
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d.%04d", decimal, frac);
-        strcpy((VT_CHAR*)flattened_db->non_repeating_signature_avg_curr_on, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d", 0);
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_num_signatures, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d", 0);
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_offset_curr, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d", 0);
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_lowest_sample_freq, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d", 0);
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_sampling_freq, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d", 0);
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_freq, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d", 0);
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_relative_curr_draw, string_buffer);
-
-        memset(string_buffer, 0, sizeof(string_buffer));
-        snprintf(string_buffer, sizeof(string_buffer), "%d", 0);
-        strcpy((VT_CHAR*)flattened_db->repeating_signature_duty_cycle, string_buffer);
+        cs_database_fetch_field(flattened_db->non_repeating_signature_avg_curr_off,
+            sizeof(flattened_db->non_repeating_signature_avg_curr_off),
+            &length,
+            non_repeating_signature->avg_curr_off);
+        length = 0;
+        cs_database_fetch_field(flattened_db->non_repeating_signature_avg_curr_on,
+            sizeof(flattened_db->non_repeating_signature_avg_curr_on),
+            &length,
+            non_repeating_signature->avg_curr_on);
+
+        cs_database_fetch_count(flattened_db->repeating_signature_num_signatures,
+            sizeof(flattened_db->repeating_signature_num_signatures),
+            0,
+            1);
+        cs_database_fetch_count(
+            flattened_db->repeating_signature_offset_curr, sizeof(flattened_db->repeating_signature_offset_curr), 0, 1);
+        cs_database_fetch_count(flattened_db->repeating_signature_lowest_sample_freq,
+            sizeof(flattened_db->repeating_signature_lowest_sample_freq),
+            0,
+            1);
+        cs_database_fetch_count(
+            flattened_db->repeating_signature_sampling_freq, sizeof(flattened_db->repeating_signature_sampling_freq), 0, 1);
+        cs_database_fetch_count(flattened_db->repeating_signature_freq, sizeof(flattened_db->repeating_signature_freq), 0, 1);
+        cs_database_fetch_count(flattened_db->repeating_signature_relative_curr_draw,
+            sizeof(flattened_db->repeating_signature_relative_curr_draw),
+            0,
+            1);
+        cs_database_fetch_count(
+            flattened_db->repeating_signature_duty_cycle, sizeof(flattened_db->repeating_signature_duty_cycle), 0, 1);
     }
 
     *template_confidence_metric = cs_object->template_confidence_metric;
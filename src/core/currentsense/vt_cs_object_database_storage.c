@@ -0,0 +1,77 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include <string.h>
+
+#include "vt_codec_api.h"
+#include "vt_cs_api.h"
+#include "vt_debug.h"
+
+/* Stored blob is the binary template followed by its calibration record */
+#define CS_STORAGE_MAX_SIZE (VT_CODEC_CURRENTSENSE_MAX_SIZE + VT_CODEC_CURRENTSENSE_CALIBRATION_MAX_SIZE)
+
+VT_UINT vt_currentsense_object_database_store(VT_CURRENTSENSE_OBJECT* cs_object, VT_CHAR* key)
+{
+    VT_UCHAR buffer[CS_STORAGE_MAX_SIZE];
+    VT_UCHAR stored_buffer[CS_STORAGE_MAX_SIZE];
+    VT_ULONG encoded_size     = 0;
+    VT_ULONG calibration_size = 0;
+    VT_ULONG stored_size      = 0;
+
+    if (!vt_device_driver_hook_enabled(cs_object->device_driver, VT_DEVICE_DRIVER_HOOK_STORAGE))
+    {
+        return VT_ERROR;
+    }
+    if (vt_codec_currentsense_database_encode(&(cs_object->fingerprintdb), buffer, sizeof(buffer), &encoded_size))
+    {
+        return VT_ERROR;
+    }
+
+    // Without a calibration record the template is restored with the configured tolerances, as a synced one is
+    if (vt_codec_currentsense_calibration_encode(
+            cs_object, buffer + encoded_size, sizeof(buffer) - encoded_size, &calibration_size) == VT_SUCCESS)
+    {
+        encoded_size += calibration_size;
+    }
+
+    // Every sync and fetch stores the template, flash is only written when it actually changed
+    if (cs_object->device_driver->storage_load(key, stored_buffer, sizeof(stored_buffer), &stored_size) == VT_SUCCESS &&
+        stored_size == encoded_size && memcmp(stored_buffer, buffer, encoded_size) == 0)
+    {
+        return VT_SUCCESS;
+    }
+
+    return cs_object->device_driver->storage_store(key, buffer, encoded_size);
+}
+
+VT_UINT vt_currentsense_object_database_load(VT_CURRENTSENSE_OBJECT* cs_object, VT_CHAR* key)
+{
+    VT_UCHAR buffer[CS_STORAGE_MAX_SIZE];
+    VT_CURRENTSENSE_DATABASE stored_db;
+    VT_ULONG stored_size   = 0;
+    VT_ULONG template_size = 0;
+
+    if (!vt_device_driver_hook_enabled(cs_object->device_driver, VT_DEVICE_DRIVER_HOOK_STORAGE) ||
+        cs_object->device_driver->storage_load(key, buffer, sizeof(buffer), &stored_size))
+    {
+        return VT_ERROR;
+    }
+
+    // Version and CRC are checked by the codec, a stale or corrupted template is never restored
+    if (vt_codec_encoded_size(buffer, stored_size, &template_size) ||
+        vt_codec_currentsense_database_decode(&stored_db, buffer, template_size))
+    {
+        VTLogError("Stored currentsense template %s is not valid \r\n", key);
+        return VT_ERROR;
+    }
+
+    // Blobs stored before the calibration record hold the template alone. A restored baseline lets the sync below keep
+    // the restored tolerances and bounds with it, as for any template adapted from that calibration
+    if (stored_size > template_size &&
+        vt_codec_currentsense_calibration_decode(cs_object, buffer + template_size, stored_size - template_size))
+    {
+        VTLogError("Stored currentsense calibration %s is not valid \r\n", key);
+    }
+
+    return vt_currentsense_object_database_sync_binary(cs_object, buffer, template_size);
+}
@@ -1,81 +1,136 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
+#include "vt_codec_api.h"
 #include "vt_cs_api.h"
 #include "vt_cs_database.h"
-#include <math.h>
-#include <stdlib.h>
-#include <string.h>
+#include "vt_cs_precheck.h"
+#include "vt_cs_template_adapt.h"
+
+static VT_VOID cs_database_synced(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    /* A template adapted from the calibration in use keeps what that calibration learnt */
+    if (cs_template_adaptation_template_synced(cs_object) == VT_SUCCESS)
+    {
+        return;
+    }
+
+    /* Templates calibrated elsewhere carry no calibration spread, fall back to the configured tolerances */
+    cs_reset_template_tolerance(cs_object);
+
+    /* Nor pre-check bounds, every evaluation runs the full check until the next calibration */
+    cs_precheck_bounds_reset(&(cs_object->precheck.bounds));
+}
+
+/* Single valued fields read as zero when missing or malformed */
+static VT_ULONG cs_database_sync_unsigned(VT_UCHAR* field, VT_ULONG field_size)
+{
+    VT_ULONG position = 0;
+    VT_ULONG value    = 0;
+
+    vt_codec_csv_parse_unsigned((VT_CHAR*)field, field_size, &position, &value);
+    return value;
+}
+
+static VT_FLOAT cs_database_sync_float(VT_UCHAR* field, VT_ULONG field_size)
+{
+    VT_ULONG position = 0;
+    VT_FLOAT value    = 0;
+
+    vt_codec_csv_parse_float((VT_CHAR*)field, field_size, &position, &value);
+    return value;
+}
 
 VT_VOID vt_currentsense_object_database_sync(VT_CURRENTSENSE_OBJECT* cs_object, VT_CURRENTSENSE_DATABASE_FLATTENED* flattened_db)
 {
-    VT_CHAR* token;
-    VT_CHAR* csvString;
-    VT_UINT iter;
+    VT_CURRENTSENSE_REPEATING_SIGNATURES_TEMPLATE* repeating_signatures =
+        &(cs_object->fingerprintdb.template.repeating_signatures);
+    VT_CURRENTSENSE_NON_REPEATING_SIGNATURE_TEMPLATE* non_repeating_signature =
+        &(cs_object->fingerprintdb.template.non_repeating_signature);
+    VT_ULONG position;
 
-    cs_object->fingerprintdb.template_type = atof((VT_CHAR*)flattened_db->template_type);
+    cs_object->fingerprintdb.template_type =
+        cs_database_sync_unsigned(flattened_db->template_type, sizeof(flattened_db->template_type));
 
     if (cs_object->fingerprintdb.template_type == VT_CS_REPEATING_SIGNATURE)
     {
-        cs_object->fingerprintdb.template.repeating_signatures.num_signatures =
-            atof((VT_CHAR*)flattened_db->repeating_signature_num_signatures);
-        cs_object->fingerprintdb.template.repeating_signatures.offset_current =
-            (VT_FLOAT)atof((VT_CHAR*)flattened_db->repeating_signature_offset_curr);
-        cs_object->fingerprintdb.template.repeating_signatures.lowest_sample_freq =
-            (VT_FLOAT)atof((VT_CHAR*)flattened_db->repeating_signature_lowest_sample_freq);
-
-        iter = 0;
-        for (csvString = (VT_CHAR*)flattened_db->repeating_signature_sampling_freq;; csvString = NULL)
+        repeating_signatures->num_signatures = cs_database_sync_unsigned(
+            flattened_db->repeating_signature_num_signatures, sizeof(flattened_db->repeating_signature_num_signatures));
+        if (repeating_signatures->num_signatures > VT_CS_MAX_SIGNATURES)
         {
-            token = strtok(csvString, ",");
-            if (token == NULL)
+            repeating_signatures->num_signatures = VT_CS_MAX_SIGNATURES;
+        }
+        repeating_signatures->offset_current = cs_database_sync_float(
+            flattened_db->repeating_signature_offset_curr, sizeof(flattened_db->repeating_signature_offset_curr));
+        repeating_signatures->lowest_sample_freq = cs_database_sync_float(
+            flattened_db->repeating_signature_lowest_sample_freq, sizeof(flattened_db->repeating_signature_lowest_sample_freq));
+
+        // Lists are parsed in place without modifying the flattened template, at most one entry per signature slot
+        position = 0;
+        for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
+        {
+            if (vt_codec_csv_parse_float((VT_CHAR*)flattened_db->repeating_signature_sampling_freq,
+                    sizeof(flattened_db->repeating_signature_sampling_freq),
+                    &position,
+                    &(repeating_signatures->signatures[iter].sampling_freq)))
             {
                 break;
             }
-            cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].sampling_freq = atof((VT_CHAR*)token);
-            iter++;
         }
 
-        iter = 0;
-        for (csvString = (VT_CHAR*)flattened_db->repeating_signature_freq;; csvString = NULL)
+        position = 0;
+        for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
         {
-            token = strtok(csvString, ",");
-            if (token == NULL)
+            if (vt_codec_csv_parse_float((VT_CHAR*)flattened_db->repeating_signature_freq,
+                    sizeof(flattened_db->repeating_signature_freq),
+                    &position,
+                    &(repeating_signatures->signatures[iter].signature_freq)))
             {
                 break;
             }
-            cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].signature_freq = atof((VT_CHAR*)token);
-            iter++;
         }
 
-        iter = 0;
-        for (csvString = (VT_CHAR*)flattened_db->repeating_signature_relative_curr_draw;; csvString = NULL)
+        position = 0;
+        for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
         {
-            token = strtok(csvString, ",");
-            if (token == NULL)
+            if (vt_codec_csv_parse_float((VT_CHAR*)flattened_db->repeating_signature_relative_curr_draw,
+                    sizeof(flattened_db->repeating_signature_relative_curr_draw),
+                    &position,
+                    &(repeating_signatures->signatures[iter].relative_curr_draw)))
             {
                 break;
             }
-            cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].relative_curr_draw = atof((VT_CHAR*)token);
-            iter++;
         }
 
-        iter = 0;
-        for (csvString = (VT_CHAR*)flattened_db->repeating_signature_duty_cycle;; csvString = NULL)
+        position = 0;
+        for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
         {
-            token = strtok(csvString, ",");
-            if (token == NULL)
+            if (vt_codec_csv_parse_float((VT_CHAR*)flattened_db->repeating_signature_duty_cycle,
+                    sizeof(flattened_db->repeating_signature_duty_cycle),
+                    &position,
+                    &(repeating_signatures->signatures[iter].duty_cycle)))
             {
                 break;
             }
-            cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].duty_cycle = atof((VT_CHAR*)token);
-            iter++;
         }
     }
     else if (cs_object->fingerprintdb.template_type == VT_CS_NON_REPEATING_SIGNATURE)
     {
-        cs_object->fingerprintdb.template.non_repeating_signature.avg_curr_off =
-            atof((VT_CHAR*)flattened_db->non_repeating_signature_avg_curr_off);
-        cs_object->fingerprintdb.template.non_repeating_signature.avg_curr_on =
-            atof((VT_CHAR*)flattened_db->non_repeating_signature_avg_curr_on);
+        non_repeating_signature->avg_curr_off = cs_database_sync_float(
+            flattened_db->non_repeating_signature_avg_curr_off, sizeof(flattened_db->non_repeating_signature_avg_curr_off));
+        non_repeating_signature->avg_curr_on = cs_database_sync_float(
+            flattened_db->non_repeating_signature_avg_curr_on, sizeof(flattened_db->non_repeating_signature_avg_curr_on));
+    }
+
+    cs_database_synced(cs_object);
+}
+
+VT_UINT vt_currentsense_object_database_sync_binary(VT_CURRENTSENSE_OBJECT* cs_object, VT_UCHAR* buffer, VT_ULONG buffer_size)
+{
+    if (vt_codec_currentsense_database_decode(&(cs_object->fingerprintdb), buffer, buffer_size))
+    {
+        return VT_ERROR;
     }
+
+    cs_database_synced(cs_object);
+    return VT_SUCCESS;
 }
\ No newline at end of file
@@ -1,13 +1,15 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
 #include "vt_cs_api.h"
+#include "vt_cs_buffer_pool.h"
+#include "vt_cs_calibrate.h"
 #include "vt_cs_database.h"
+#include "vt_cs_plan.h"
+#include "vt_cs_precheck.h"
+#include "vt_cs_template_adapt.h"
 
-VT_UINT vt_currentsense_object_initialize(VT_CURRENTSENSE_OBJECT* cs_object,
-    VT_DEVICE_DRIVER* device_driver,
-    VT_SENSOR_HANDLE* sensor_handle,
-    VT_CHAR* raw_signatures_buffer,
-    VT_UINT raw_signatures_buffer_size)
+static VT_VOID cs_object_initialize_common(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_DEVICE_DRIVER* device_driver, VT_SENSOR_HANDLE* sensor_handle)
 {
     cs_object->sensor_handle = sensor_handle;
 
@@ -23,20 +25,68 @@ VT_UINT vt_currentsense_object_initialize(VT_CURRENTSENSE_OBJECT* cs_object,
 
     cs_object->sensor_drift = VT_SIGNATURE_DRIFT_DEFAULT_VALUE;
 
+    cs_object->sensor_status_updated = false;
+
     cs_object->template_confidence_metric = VT_SIGNATURE_TEMPLATE_CONFIDENCE_DEFAULT_VALUE;
 
+    cs_object->calibration.num_captures_required = 1;
+
+    cs_calibration_statistics_reset(cs_object);
+
+    cs_object->adaptation.enabled = false;
+
+    cs_object->adaptation.alpha = VT_CS_ADAPTATION_ALPHA;
+
+    cs_template_adaptation_baseline_set(cs_object);
+
+    cs_object->precheck.enabled = true;
+
+    cs_object->precheck.num_tier0_matching = 0;
+
+    cs_object->precheck.num_tier0_not_matching = 0;
+
+    cs_object->precheck.num_full = 0;
+
     cs_object->raw_signatures_reader_initialized = false;
 
-    if (raw_signatures_buffer_size < sizeof(VT_CURRENTSENSE_RAW_SIGNATURES_READER))
+    cs_object->buffer_pool = NULL;
+
+    cs_plan_create(&(cs_object->plan), VT_CS_SAMPLE_LENGTH, VT_CS_AUTO_CORRELATION_LAG);
+}
+
+VT_UINT vt_currentsense_object_initialize(VT_CURRENTSENSE_OBJECT* cs_object,
+    VT_DEVICE_DRIVER* device_driver,
+    VT_SENSOR_HANDLE* sensor_handle,
+    VT_CHAR* raw_signatures_buffer,
+    VT_UINT raw_signatures_buffer_size)
+{
+    cs_object_initialize_common(cs_object, device_driver, sensor_handle);
+
+    return cs_raw_signatures_reader_assign(cs_object, raw_signatures_buffer, raw_signatures_buffer_size);
+}
+
+VT_UINT vt_currentsense_object_initialize_from_pool(VT_CURRENTSENSE_OBJECT* cs_object,
+    VT_DEVICE_DRIVER* device_driver,
+    VT_SENSOR_HANDLE* sensor_handle,
+    VT_CURRENTSENSE_BUFFER_POOL* buffer_pool)
+{
+    cs_object_initialize_common(cs_object, device_driver, sensor_handle);
+
+    if (cs_buffer_pool_register(buffer_pool, cs_object) != VT_SUCCESS)
     {
         return VT_ERROR;
     }
 
-    cs_object->raw_signatures_reader = (VT_CURRENTSENSE_RAW_SIGNATURES_READER*)raw_signatures_buffer;
-    cs_object->raw_signatures_reader->repeating_raw_signature_ongoing_collection  = false;
-    cs_object->raw_signatures_reader->repeating_raw_signature_buffers_filled      = false;
-    cs_object->raw_signatures_reader->non_repeating_raw_signature_stop_collection = false;
-    cs_object->raw_signatures_reader_initialized                                  = true;
+    return cs_buffer_pool_repack(buffer_pool);
+}
+
+VT_UINT vt_currentsense_object_plan_create(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT sample_length, VT_UINT auto_correlation_lag)
+{
+    return cs_plan_create(&(cs_object->plan), sample_length, auto_correlation_lag);
+}
 
-    return VT_SUCCESS;
+VT_VOID vt_currentsense_object_plan_dump(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    cs_plan_dump(&(cs_object->plan));
 }
\ No newline at end of file
@@ -0,0 +1,18 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_cs_api.h"
+
+VT_VOID vt_currentsense_object_precheck_enable(VT_CURRENTSENSE_OBJECT* cs_object, VT_BOOL enable)
+{
+    cs_object->precheck.enabled = enable;
+}
+
+VT_VOID vt_currentsense_object_precheck_fetch_status(VT_CURRENTSENSE_OBJECT* cs_object,
+    VT_ULONG* num_tier0_matching,
+    VT_ULONG* num_tier0_not_matching,
+    VT_ULONG* num_full)
+{
+    *num_tier0_matching     = cs_object->precheck.num_tier0_matching;
+    *num_tier0_not_matching = cs_object->precheck.num_tier0_not_matching;
+    *num_full               = cs_object->precheck.num_full;
+}
@@ -4,12 +4,28 @@
 
 VT_VOID vt_currentsense_object_sensor_calibrate(VT_CURRENTSENSE_OBJECT* cs_object)
 {
-    cs_object->mode = VT_MODE_CALIBRATE;
+    cs_object->mode                              = VT_MODE_CALIBRATE;
+    cs_object->calibration.num_captures_required = 1;
+    cs_object->calibration.num_captures          = 0;
 }
 
 VT_VOID vt_currentsense_object_sensor_recalibrate(VT_CURRENTSENSE_OBJECT* cs_object)
 {
-    cs_object->mode = VT_MODE_RECALIBRATE;
+    cs_object->mode                              = VT_MODE_RECALIBRATE;
+    cs_object->calibration.num_captures_required = 1;
+    cs_object->calibration.num_captures          = 0;
+}
+
+VT_UINT vt_currentsense_object_sensor_calibrate_multi_capture(VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT num_captures)
+{
+    if (num_captures == 0)
+    {
+        return VT_ERROR;
+    }
+    cs_object->mode                              = VT_MODE_CALIBRATE;
+    cs_object->calibration.num_captures_required = num_captures;
+    cs_object->calibration.num_captures          = 0;
+    return VT_SUCCESS;
 }
 
 VT_VOID vt_currentsense_object_sensor_fetch_status(
@@ -18,3 +34,15 @@ VT_VOID vt_currentsense_object_sensor_fetch_status(
     *sensor_status = cs_object->sensor_status;
     *sensor_drift  = cs_object->sensor_drift;
 }
+
+VT_UINT vt_currentsense_object_sensor_fetch_status_update(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT* sensor_status, VT_UINT* sensor_drift)
+{
+    if (!cs_object->sensor_status_updated)
+    {
+        return VT_ERROR;
+    }
+    cs_object->sensor_status_updated = false;
+    vt_currentsense_object_sensor_fetch_status(cs_object, sensor_status, sensor_drift);
+    return VT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
 #include "vt_cs_api.h"
+#include "vt_cs_buffer_pool.h"
 #include "vt_cs_calibrate.h"
 #include "vt_cs_database.h"
 #include "vt_cs_raw_signature_read.h"
@@ -8,10 +9,20 @@
 #include "vt_debug.h"
 
 
-VT_VOID vt_currentsense_object_signature_read(VT_CURRENTSENSE_OBJECT* cs_object)
+VT_UINT vt_currentsense_object_signature_read(VT_CURRENTSENSE_OBJECT* cs_object)
 {
     VT_FLOAT sampling_frequencies[VT_CS_MAX_SIGNATURES];
     VT_UINT num_sampling_frqeuencies = 0;
+    if (cs_object->buffer_pool)
+    {
+        /* Resize this object's share of the pool to what the template or calibration now needs, a capture into buffers
+           that could not be resized would be evaluated truncated so it is skipped until the repack succeeds */
+        if (cs_buffer_pool_repack(cs_object->buffer_pool))
+        {
+            VTLogInfo("Currentsense signature read skipped, raw signature buffers not resized \r\n");
+            return VT_ERROR;
+        }
+    }
     if (cs_object->mode == VT_MODE_RUNTIME_EVALUATE)
     {
         cs_fetch_template_repeating_signature_sampling_frequencies(
@@ -22,7 +33,21 @@ VT_VOID vt_currentsense_object_signature_read(VT_CURRENTSENSE_OBJECT* cs_object)
         cs_calibrate_repeating_signatures_compute_sampling_frequencies(
             cs_object, sampling_frequencies, VT_CS_MAX_SIGNATURES, &num_sampling_frqeuencies);
     }
-    cs_raw_signature_read(cs_object, sampling_frequencies, num_sampling_frqeuencies, VT_CS_SAMPLE_LENGTH);
+    cs_raw_signature_read(cs_object, sampling_frequencies, num_sampling_frqeuencies, cs_object->plan.sample_length);
+    return VT_SUCCESS;
+}
+
+VT_UINT vt_currentsense_object_signature_process_partial(VT_CURRENTSENSE_OBJECT* cs_object)
+{
+    if (cs_object->raw_signatures_reader_initialized == false)
+    {
+        return 0;
+    }
+    if (cs_object->mode == VT_MODE_RUNTIME_EVALUATE)
+    {
+        return cs_sensor_status_partial(cs_object);
+    }
+    return cs_calibrate_sensor_partial(cs_object);
 }
 
 VT_VOID vt_currentsense_object_signature_process(VT_CURRENTSENSE_OBJECT* cs_object)
@@ -42,14 +67,18 @@ VT_VOID vt_currentsense_object_signature_process(VT_CURRENTSENSE_OBJECT* cs_obje
 
         case VT_MODE_CALIBRATE:
             VTLogDebug("Calibrating Sensor Fingerprint \r\n");
-            cs_calibrate_sensor(cs_object);
-            cs_object->mode = VT_MODE_RUNTIME_EVALUATE;
+            if (cs_calibrate_sensor(cs_object) == 0)
+            {
+                cs_object->mode = VT_MODE_RUNTIME_EVALUATE;
+            }
             break;
 
         case VT_MODE_RECALIBRATE:
             VTLogDebug("Recalibrating Sensor Fingerprint \r\n");
-            cs_recalibrate_sensor(cs_object);
-            cs_object->mode = VT_MODE_RUNTIME_EVALUATE;
+            if (cs_recalibrate_sensor(cs_object) == 0)
+            {
+                cs_object->mode = VT_MODE_RUNTIME_EVALUATE;
+            }
             break;
     }
 }
\ No newline at end of file
@@ -0,0 +1,25 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+#include "vt_cs_api.h"
+
+VT_UINT vt_currentsense_object_adaptation_enable(VT_CURRENTSENSE_OBJECT* cs_object, VT_BOOL enable, VT_FLOAT alpha)
+{
+    if (enable && (alpha <= 0 || alpha > 1))
+    {
+        return VT_ERROR;
+    }
+    cs_object->adaptation.enabled = enable;
+    if (enable)
+    {
+        cs_object->adaptation.alpha = alpha;
+    }
+    return VT_SUCCESS;
+}
+
+VT_VOID vt_currentsense_object_adaptation_fetch_status(
+    VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT* num_updates, VT_UINT* num_rejected, VT_FLOAT* cumulative_drift)
+{
+    *num_updates      = cs_object->adaptation.num_updates;
+    *num_rejected     = cs_object->adaptation.num_rejected;
+    *cumulative_drift = cs_object->adaptation.cumulative_drift;
+}
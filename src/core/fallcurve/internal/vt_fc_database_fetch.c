@@ -23,3 +23,29 @@ VT_UINT fc_fetch_signature(VT_FALLCURVE_OBJECT* fc_object,
     VTLogDebug("Fetched next signature from DB \r\n");
     return VT_SUCCESS;
 }
+
+VT_UINT fc_fetch_rise_signature(
+    VT_FALLCURVE_OBJECT* fc_object, VT_UINT signature_iter, VT_ULONG* risetime, VT_FLOAT* rise_pearson_coeff)
+{
+    if (signature_iter >= fc_object->fingerprintdb.num_signatures || fc_object->fingerprintdb.db[signature_iter].risetime == 0)
+    {
+        return VT_ERROR;
+    }
+
+    *risetime           = fc_object->fingerprintdb.db[signature_iter].risetime;
+    *rise_pearson_coeff = fc_object->fingerprintdb.db[signature_iter].rise_pearson_coeff;
+    return VT_SUCCESS;
+}
+
+VT_UINT fc_fetch_sampling_intervals(VT_FALLCURVE_OBJECT* fc_object, VT_ULONG* sampling_intervals_us, VT_UINT buffer_length)
+{
+    VT_UINT num_signatures = 0;
+
+    while (num_signatures < fc_object->fingerprintdb.num_signatures && num_signatures < buffer_length)
+    {
+        sampling_intervals_us[num_signatures] = fc_object->fingerprintdb.db[num_signatures].sampling_interval_us;
+        num_signatures++;
+    }
+
+    return num_signatures;
+}
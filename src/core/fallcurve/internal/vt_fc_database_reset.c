@@ -6,4 +6,5 @@
 VT_VOID fc_reset_db(VT_FALLCURVE_OBJECT* fc_object)
 {
     fc_object->fingerprintdb.num_signatures = 0;
+    fc_object->fingerprintdb.shape_fit      = VT_FC_SHAPE_FIT_PEARSON;
 }
@@ -7,75 +7,605 @@
 #include "vt_debug.h"
 #include "vt_fc_read.h"
 
-#define MAX_TICK_VALUE      65535
-#define MIN_TICK_VALUE      1
-#define MIN_TICK_RESOLUTION 1
+#define MAX_TICK_VALUE        65535
+#define MIN_TICK_RESOLUTION   1
+#define SECOND_TO_MICROSECOND 1000000.0f
 
-static VT_VOID fc_calculate_required_tick_resolution(
-    VT_ULONG sampling_interval_us, VT_UINT* tick_resolution_us, VT_UINT max_tick_value)
+/* Object whose DMA capture owns the completion callbacks, NULL while no fallcurve DMA capture is ongoing */
+static VT_FALLCURVE_OBJECT* fc_object_reference = NULL;
+
+static VT_VOID fc_oversample_reset(FC_OVERSAMPLE* oversample)
+{
+    oversample->mean       = 0;
+    oversample->m2         = 0;
+    oversample->index_mean = 0;
+    oversample->index_m2   = 0;
+    oversample->co_moment  = 0;
+    oversample->count      = 0;
+}
+
+/* Welford update, the reads are close to each other so sums of squares would cancel in float */
+static VT_VOID fc_oversample_accumulate(FC_OVERSAMPLE* oversample, VT_FLOAT value)
+{
+    VT_FLOAT index       = (VT_FLOAT)oversample->count;
+    VT_FLOAT delta       = 0;
+    VT_FLOAT index_delta = 0;
+
+    oversample->count++;
+    delta       = value - oversample->mean;
+    index_delta = index - oversample->index_mean;
+    oversample->mean += delta / (VT_FLOAT)oversample->count;
+    oversample->index_mean += index_delta / (VT_FLOAT)oversample->count;
+    oversample->m2 += delta * (value - oversample->mean);
+    oversample->index_m2 += index_delta * (index - oversample->index_mean);
+    oversample->co_moment += index_delta * (value - oversample->mean);
+}
+
+/* Value stored for one sampling interval: the last read, or the mean of every read in the interval when oversampling.
+   Callers only accumulate while oversampling so the polling loops stay free of float divisions otherwise */
+static VT_UINT fc_oversample_take(
+    VT_FALLCURVE_OBJECT* fc_object, FC_OVERSAMPLE* oversample, VT_FLOAT last_value, FC_VARIANCE* variance)
+{
+    VT_FLOAT value = last_value;
+
+    if (fc_object->plan.oversampling && oversample->count)
+    {
+        value = oversample->mean;
+        if (oversample->count > 2)
+        {
+            // Residual variance around the least-squares line through the interval, the discharge slope is not noise
+            variance->sum += fmaxf(0,
+                (oversample->m2 - ((oversample->co_moment * oversample->co_moment) / oversample->index_m2)) /
+                    (VT_FLOAT)(oversample->count - 2));
+            variance->count++;
+        }
+        else if (oversample->count == 2)
+        {
+            // Two reads always fit a line, fall back to the plain sample variance which keeps the slope over one read
+            variance->sum += oversample->m2;
+            variance->count++;
+        }
+    }
+    fc_oversample_reset(oversample);
+
+    return round(value);
+}
+
+static VT_VOID fc_oversample_variance_store(VT_FALLCURVE_OBJECT* fc_object, FC_VARIANCE* variance)
+{
+    fc_object->sample_variance = variance->count ? (variance->sum / (VT_FLOAT)variance->count) : 0;
+}
+
+/* Decay has settled once the newest sample passed the early stop fraction of the peak and the tail is flat within noise */
+static VT_BOOL fc_capture_settled(VT_FALLCURVE_OBJECT* fc_object,
+    const VT_UINT* raw_signature,
+    VT_UINT samples_read,
+    VT_UINT peak_value,
+    const FC_VARIANCE* variance)
 {
-    VT_FLOAT sampling_period_ticks;
-    if (*tick_resolution_us < MIN_TICK_RESOLUTION)
+    VT_FLOAT flat_tolerance = VT_FC_EARLY_STOP_FLAT_TOLERANCE;
+    VT_UINT tail_min        = 0;
+    VT_UINT tail_max        = 0;
+
+    if (fc_object->plan.early_stop_fraction <= 0 || samples_read < VT_FC_EARLY_STOP_FLAT_SAMPLES ||
+        (VT_FLOAT)raw_signature[samples_read - 1] > (fc_object->plan.early_stop_fraction * (VT_FLOAT)peak_value))
     {
-        *tick_resolution_us = MIN_TICK_RESOLUTION;
+        return false;
     }
-    if (max_tick_value < MIN_TICK_VALUE)
+
+    tail_min = raw_signature[samples_read - 1];
+    tail_max = raw_signature[samples_read - 1];
+    for (VT_UINT iter = samples_read - VT_FC_EARLY_STOP_FLAT_SAMPLES; iter < samples_read; iter++)
     {
-        max_tick_value = MAX_TICK_VALUE;
+        tail_min = (raw_signature[iter] < tail_min) ? raw_signature[iter] : tail_min;
+        tail_max = (raw_signature[iter] > tail_max) ? raw_signature[iter] : tail_max;
     }
-    while (true)
+    if (fc_object->plan.oversampling && variance->count)
     {
-        sampling_period_ticks = (VT_FLOAT)sampling_interval_us / (VT_FLOAT)*tick_resolution_us;
-        if (sampling_period_ticks < (VT_FLOAT)max_tick_value)
+        flat_tolerance = fmaxf(flat_tolerance, 3.0f * sqrtf(variance->sum / (VT_FLOAT)variance->count));
+    }
+
+    return ((VT_FLOAT)(tail_max - tail_min) <= flat_tolerance);
+}
+
+static VT_VOID fc_adc_buffer_read_half_complete_callback()
+{
+    /* The discharge is only evaluated once the whole buffer has been sampled */
+}
+
+static VT_VOID fc_adc_buffer_read_full_complete_callback()
+{
+    fc_object_reference->dma_capture.ongoing_collection  = false;
+    fc_object_reference->dma_capture.collection_complete = true;
+    fc_object_reference->device_driver->gpio_on(fc_object_reference->sensor_handle->gpio_id,
+        fc_object_reference->sensor_handle->gpio_port,
+        fc_object_reference->sensor_handle->gpio_pin);
+    fc_object_reference = NULL;
+}
+
+/* Keep adc_value for every template of the capture whose sampling interval has elapsed, true once all of them are full. A
+   rising curve is stored mirrored below its template's fall peak so it decays like a discharge */
+static VT_BOOL fc_adc_capture_sample(FC_ADC_CAPTURE* capture, VT_BOOL rising, VT_UINT adc_value, VT_ULONG elapsed_time_us)
+{
+    VT_FALLCURVE_OBJECT* fc_object = capture->fc_object;
+    VT_UINT* raw_signatures        = rising ? capture->rise_signatures : capture->raw_signatures;
+    VT_UINT* samples_read          = rising ? capture->rise_samples_read : capture->samples_read;
+    VT_UINT* raw_signature         = NULL;
+    VT_UINT value                  = 0;
+    VT_UINT sample_value           = 0;
+
+    for (VT_UINT iter = 0; iter < capture->num_signatures; iter++)
+    {
+        if (capture->signature_complete[iter])
         {
-            break;
+            continue;
+        }
+        value = adc_value;
+        if (rising)
+        {
+            value = (capture->rise_reference[iter] > adc_value) ? (capture->rise_reference[iter] - adc_value) : 0;
+        }
+        if (fc_object->plan.oversampling)
+        {
+            fc_oversample_accumulate(&capture->oversample[iter], value);
+        }
+        if ((elapsed_time_us - capture->last_sample_time_us[iter]) > capture->sampling_period_us[iter])
+        {
+            sample_value  = fc_oversample_take(fc_object, &capture->oversample[iter], value, &capture->variance);
+            raw_signature = &raw_signatures[iter * capture->sample_length];
+
+            raw_signature[samples_read[iter]] = sample_value;
+            samples_read[iter]++;
+            if (sample_value > capture->peak_value[iter])
+            {
+                capture->peak_value[iter] = sample_value;
+            }
+            capture->last_sample_time_us[iter] = elapsed_time_us;
+            if (samples_read[iter] == capture->sample_length ||
+                fc_capture_settled(fc_object, raw_signature, samples_read[iter], capture->peak_value[iter], &capture->variance))
+            {
+                capture->signature_complete[iter] = true;
+                capture->signatures_complete++;
+                if (!rising)
+                {
+                    fc_object->samples_used = (samples_read[iter] > fc_object->samples_used) ? samples_read[iter]
+                                                                                             : fc_object->samples_used;
+                }
+            }
         }
-        *tick_resolution_us = *tick_resolution_us + 1;
     }
+
+    return (capture->signatures_complete == capture->num_signatures);
 }
 
-VT_VOID fc_adc_read(VT_FALLCURVE_OBJECT* fc_object, VT_UINT* raw_signature, VT_ULONG sampling_interval_us, VT_UINT sample_length)
+/* Spacing of the samples a template kept, from their timestamps, relative to that of a read of the sensor alone. A sample
+   is kept at the first read past the sampling period, alone that read comes within one read time of it while round-robin
+   reads of the other sensors can push it a whole round further */
+static VT_FLOAT fc_adc_sampling_stretch(
+    VT_ULONG sampling_period_us, VT_ULONG last_sample_time_us, VT_UINT samples_read, VT_FLOAT read_time_us)
 {
-    VT_UINT max_tick_value        = 0;
-    VT_UINT tick_resolution_usec  = 0;
-    VT_UINT adc_resolution        = 0;
-    VT_FLOAT adc_ref_volt         = 0;
-    VT_UINT start_tick_count      = 0;
-    VT_UINT sampling_period_ticks = 0;
-    VT_UINT iter                  = 0;
-    VT_UINT temp_adc_read_data    = 0;
+    VT_FLOAT sampled_spacing_us = 0;
+    VT_FLOAT alone_spacing_us   = 0;
 
-    fc_object->device_driver->tick_init(&max_tick_value, &tick_resolution_usec);
-    fc_calculate_required_tick_resolution(sampling_interval_us, &tick_resolution_usec, max_tick_value);
-    sampling_period_ticks = round((float)sampling_interval_us / (float)tick_resolution_usec);
-    VTLogDebug("Sampling Period Ticks: %d \r\n", sampling_period_ticks);
+    if (samples_read == 0 || read_time_us <= 0)
+    {
+        return 1.0f;
+    }
+    sampled_spacing_us = (VT_FLOAT)last_sample_time_us / (VT_FLOAT)samples_read;
+    alone_spacing_us   = (floorf((VT_FLOAT)sampling_period_us / read_time_us) + 1.0f) * read_time_us;
+
+    return sampled_spacing_us / alone_spacing_us;
+}
+
+/* Sample every capture round-robin from now until each template is full, the caller has already switched the sensors */
+static VT_VOID fc_adc_capture_window(FC_ADC_CAPTURE* captures,
+    VT_UINT num_captures,
+    VT_BOOL rising,
+    VT_DEVICE_DRIVER* device_driver,
+    VT_UINT tick_resolution_usec)
+{
+    VT_FALLCURVE_OBJECT* fc_object = NULL;
+    VT_UINT* samples_read          = NULL;
+    VT_FLOAT* sampling_stretch     = NULL;
+    VT_BOOL capture_complete[VT_FC_MAX_BATCH_SENSORS];
+    VT_UINT adc_value           = 0;
+    VT_UINT adc_resolution      = 0;
+    VT_FLOAT adc_ref_volt       = 0;
+    VT_UINT tick_count          = 0;
+    VT_UINT previous_tick_count = 0;
+    VT_ULONG elapsed_time_us    = 0;
+    VT_ULONG reads              = 0;
+    VT_UINT captures_complete   = 0;
+    VT_UINT previous_capture    = num_captures;
+
+    for (VT_UINT capture = 0; capture < num_captures; capture++)
+    {
+        captures[capture].signatures_complete = 0;
+        capture_complete[capture] = (captures[capture].num_signatures == 0) || (rising && !captures[capture].rise_signatures);
+        if (capture_complete[capture])
+        {
+            captures_complete++;
+            continue;
+        }
+        samples_read = rising ? captures[capture].rise_samples_read : captures[capture].samples_read;
+        for (VT_UINT iter = 0; iter < captures[capture].num_signatures; iter++)
+        {
+            if (rising)
+            {
+                captures[capture].rise_reference[iter] = captures[capture].peak_value[iter];
+            }
+            captures[capture].sampling_period_us[iter] =
+                (VT_ULONG)round((VT_FLOAT)captures[capture].sampling_intervals_us[iter] / (VT_FLOAT)tick_resolution_usec) *
+                tick_resolution_usec;
+            captures[capture].last_sample_time_us[iter] = 0;
+            captures[capture].peak_value[iter]          = 0;
+            captures[capture].signature_complete[iter]  = false;
+            samples_read[iter]                          = 0;
+            fc_oversample_reset(&captures[capture].oversample[iter]);
+            VTLogDebug("Sampling Period us: %lu \r\n", captures[capture].sampling_period_us[iter]);
+        }
+    }
+    if (captures_complete == num_captures)
+    {
+        return;
+    }
+    previous_tick_count = (VT_UINT)device_driver->tick();
+
+    while (captures_complete < num_captures)
+    {
+        for (VT_UINT capture = 0; capture < num_captures; capture++)
+        {
+            if (capture_complete[capture])
+            {
+                continue;
+            }
+            fc_object = captures[capture].fc_object;
+            if (num_captures > 1 && capture != previous_capture)
+            {
+                // Sensors sharing an ADC need its channel switched back, a single read only converts the selected one
+                fc_object->device_driver->adc_single_read_init(fc_object->sensor_handle->adc_id,
+                    fc_object->sensor_handle->adc_controller,
+                    fc_object->sensor_handle->adc_channel,
+                    &adc_resolution,
+                    &adc_ref_volt);
+                previous_capture = capture;
+            }
+            adc_value = fc_object->device_driver->adc_single_read(fc_object->sensor_handle->adc_id,
+                fc_object->sensor_handle->adc_controller,
+                fc_object->sensor_handle->adc_channel);
+            tick_count = (VT_UINT)device_driver->tick();
+            elapsed_time_us += (VT_ULONG)((VT_UINT)(tick_count - previous_tick_count)) * tick_resolution_usec;
+            previous_tick_count = tick_count;
+            reads++;
+
+            if (fc_adc_capture_sample(&captures[capture], rising, adc_value, elapsed_time_us))
+            {
+                capture_complete[capture] = true;
+                captures_complete++;
+            }
+        }
+    }
+
+    for (VT_UINT capture = 0; capture < num_captures; capture++)
+    {
+        sampling_stretch = rising ? captures[capture].rise_sampling_stretch : captures[capture].sampling_stretch;
+        samples_read     = rising ? captures[capture].rise_samples_read : captures[capture].samples_read;
+        if (sampling_stretch == NULL || (rising && !captures[capture].rise_signatures))
+        {
+            continue;
+        }
+        for (VT_UINT iter = 0; iter < captures[capture].num_signatures; iter++)
+        {
+            sampling_stretch[iter] = fc_adc_sampling_stretch(captures[capture].sampling_period_us[iter],
+                captures[capture].last_sample_time_us[iter],
+                samples_read[iter],
+                (VT_FLOAT)elapsed_time_us / (VT_FLOAT)reads);
+        }
+    }
+}
+
+VT_VOID fc_adc_read(FC_ADC_CAPTURE* captures, VT_UINT num_captures)
+{
+    VT_DEVICE_DRIVER* device_driver = captures[0].fc_object->device_driver;
+    VT_FALLCURVE_OBJECT* fc_object  = NULL;
+    VT_UINT max_tick_value          = MAX_TICK_VALUE;
+    VT_UINT tick_resolution_usec    = MIN_TICK_RESOLUTION;
+    VT_UINT adc_resolution          = 0;
+    VT_FLOAT adc_ref_volt           = 0;
+
+    if (num_captures > VT_FC_MAX_BATCH_SENSORS)
+    {
+        num_captures = VT_FC_MAX_BATCH_SENSORS;
+    }
+    for (VT_UINT capture = 0; capture < num_captures; capture++)
+    {
+        fc_object = captures[capture].fc_object;
+        if (captures[capture].num_signatures > VT_FC_MAX_SIGNATURES)
+        {
+            captures[capture].num_signatures = VT_FC_MAX_SIGNATURES;
+        }
+        captures[capture].variance.sum   = 0;
+        captures[capture].variance.count = 0;
+        fc_object->samples_used          = 0;
+        fc_object->device_driver->adc_single_read_init(fc_object->sensor_handle->adc_id,
+            fc_object->sensor_handle->adc_controller,
+            fc_object->sensor_handle->adc_channel,
+            &adc_resolution,
+            &adc_ref_volt);
+    }
+
+    // The first object's driver owns the interrupt blackout and the tick that times every channel of the window
+    device_driver->interrupt_disable();
+    device_driver->tick_init(&max_tick_value, &tick_resolution_usec);
+    if (tick_resolution_usec < MIN_TICK_RESOLUTION)
+    {
+        tick_resolution_usec = MIN_TICK_RESOLUTION;
+    }
+    for (VT_UINT capture = 0; capture < num_captures; capture++)
+    {
+        fc_object = captures[capture].fc_object;
+        fc_object->device_driver->gpio_off(
+            fc_object->sensor_handle->gpio_id, fc_object->sensor_handle->gpio_port, fc_object->sensor_handle->gpio_pin);
+    }
+
+    // One discharge of every sensor, their channels read round-robin at the full ADC rate and decimated on the fly to every
+    // requested sampling interval
+    fc_adc_capture_window(captures, num_captures, false, device_driver, tick_resolution_usec);
+
+    for (VT_UINT capture = 0; capture < num_captures; capture++)
+    {
+        fc_object = captures[capture].fc_object;
+        fc_object->device_driver->gpio_on(
+            fc_object->sensor_handle->gpio_id, fc_object->sensor_handle->gpio_port, fc_object->sensor_handle->gpio_pin);
+    }
+
+    // The blackout ends with the discharge, the recharge the sensors need anyway is sampled with interrupts enabled at the
+    // same intervals for the rise curve fingerprints, an interrupt only delays its samples
+    device_driver->interrupt_enable();
+    fc_adc_capture_window(captures, num_captures, true, device_driver, tick_resolution_usec);
+
+    for (VT_UINT capture = 0; capture < num_captures; capture++)
+    {
+        fc_oversample_variance_store(captures[capture].fc_object, &captures[capture].variance);
+    }
+
+    device_driver->tick_deinit();
+}
+
+VT_VOID fc_adc_calibration_read(VT_FALLCURVE_OBJECT* fc_object,
+    VT_UINT* raw_signature,
+    VT_UINT sample_length,
+    VT_UINT* samples_read,
+    VT_UINT* rise_signature,
+    VT_UINT* rise_samples_read,
+    VT_ULONG* sampling_interval_us,
+    VT_ULONG* time_to_fall)
+{
+    FC_ADC_CAPTURE rise_capture;
+    VT_UINT* capture_value          = fc_object->scratch.calibration.capture_value;
+    VT_ULONG* capture_time_us       = fc_object->scratch.calibration.capture_time_us;
+    VT_UINT capture_length          = 0;
+    VT_ULONG capture_stride         = 1;
+    VT_ULONG capture_reads          = 0;
+    VT_UINT max_tick_value          = MAX_TICK_VALUE;
+    VT_UINT tick_resolution_usec    = MIN_TICK_RESOLUTION;
+    VT_UINT adc_resolution          = 0;
+    VT_FLOAT adc_ref_volt           = 0;
+    VT_UINT adc_value_threshold     = 0;
+    VT_UINT adc_value               = 0;
+    VT_UINT tick_count              = 0;
+    VT_UINT previous_tick_count     = 0;
+    VT_ULONG elapsed_time_us        = 0;
+    VT_ULONG last_sample_time_us    = 0;
+    VT_ULONG sampling_period_us     = 0;
+    VT_UINT iter                    = 0;
+    VT_UINT peak_value              = 0;
+    VT_BOOL settled                 = false;
+    FC_OVERSAMPLE oversample        = {0};
+    FC_VARIANCE variance            = {0};
+    const VT_ULONG max_time_allowed = fc_object->plan.max_capture_time_us;
 
     fc_object->device_driver->adc_single_read_init(fc_object->sensor_handle->adc_id,
         fc_object->sensor_handle->adc_controller,
         fc_object->sensor_handle->adc_channel,
         &adc_resolution,
         &adc_ref_volt);
+    adc_value = fc_object->device_driver->adc_single_read(
+        fc_object->sensor_handle->adc_id, fc_object->sensor_handle->adc_controller, fc_object->sensor_handle->adc_channel);
+    VTLogDebug("FallCurve first value: %d \r\n", adc_value);
+    adc_value_threshold = round(adc_value * 0.37f);
+
     fc_object->device_driver->interrupt_disable();
     fc_object->device_driver->tick_init(&max_tick_value, &tick_resolution_usec);
+    if (tick_resolution_usec < MIN_TICK_RESOLUTION)
+    {
+        tick_resolution_usec = MIN_TICK_RESOLUTION;
+    }
     fc_object->device_driver->gpio_off(
         fc_object->sensor_handle->gpio_id, fc_object->sensor_handle->gpio_port, fc_object->sensor_handle->gpio_pin);
-    start_tick_count = (VT_UINT)fc_object->device_driver->tick();
+    previous_tick_count = (VT_UINT)fc_object->device_driver->tick();
 
-    while (iter < sample_length)
+    // Read at the full ADC rate until the 37% point, halving the kept samples whenever the capture buffer fills
+    while (true)
     {
-        temp_adc_read_data = fc_object->device_driver->adc_single_read(
+        adc_value = fc_object->device_driver->adc_single_read(
             fc_object->sensor_handle->adc_id, fc_object->sensor_handle->adc_controller, fc_object->sensor_handle->adc_channel);
+        tick_count = (VT_UINT)fc_object->device_driver->tick();
+        elapsed_time_us += (VT_ULONG)((VT_UINT)(tick_count - previous_tick_count)) * tick_resolution_usec;
+        previous_tick_count = tick_count;
 
-        if ((uint16_t)((VT_UINT)fc_object->device_driver->tick() - start_tick_count) > sampling_period_ticks)
+        if ((capture_reads % capture_stride) == 0 && capture_length == VT_FC_CALIBRATION_CAPTURE_LENGTH)
+        {
+            for (VT_UINT iter1 = 0; iter1 < (capture_length / 2); iter1++)
+            {
+                capture_value[iter1]   = capture_value[2 * iter1];
+                capture_time_us[iter1] = capture_time_us[2 * iter1];
+            }
+            capture_length /= 2;
+            capture_stride *= 2;
+        }
+        if ((capture_reads % capture_stride) == 0)
+        {
+            capture_value[capture_length]   = adc_value;
+            capture_time_us[capture_length] = elapsed_time_us;
+            capture_length++;
+        }
+        capture_reads++;
+
+        if (adc_value <= adc_value_threshold || (elapsed_time_us - capture_time_us[0]) > max_time_allowed)
+        {
+            break;
+        }
+    }
+
+    *time_to_fall         = elapsed_time_us - capture_time_us[0];
+    *sampling_interval_us = round(*time_to_fall / (VT_FLOAT)sample_length);
+    if (*sampling_interval_us < VT_FC_MIN_SAMPLING_INTERVAL_US)
+    {
+        *sampling_interval_us = VT_FC_MIN_SAMPLING_INTERVAL_US;
+    }
+    else if (*sampling_interval_us > VT_FC_MAX_SAMPLING_INTERVAL_US)
+    {
+        *sampling_interval_us = VT_FC_MAX_SAMPLING_INTERVAL_US;
+    }
+    sampling_period_us = (VT_ULONG)round((VT_FLOAT)*sampling_interval_us / (VT_FLOAT)tick_resolution_usec) * tick_resolution_usec;
+    VTLogDebug("FallCurve time to reach 0.37: %lu \r\n", *time_to_fall);
+    VTLogDebug("Sampling Interval: %lu \r\n", *sampling_interval_us);
+
+    // Decimate the capture with the same rule fc_adc_read applies, then keep reading the same discharge if it fell short
+    for (VT_UINT iter1 = 0; iter1 < capture_length && iter < sample_length && !settled; iter1++)
+    {
+        if (fc_object->plan.oversampling)
+        {
+            fc_oversample_accumulate(&oversample, capture_value[iter1]);
+        }
+        if ((capture_time_us[iter1] - last_sample_time_us) > sampling_period_us)
         {
-            raw_signature[iter] = temp_adc_read_data;
-            start_tick_count    = (VT_UINT)fc_object->device_driver->tick();
+            raw_signature[iter] = fc_oversample_take(fc_object, &oversample, capture_value[iter1], &variance);
+            peak_value          = (raw_signature[iter] > peak_value) ? raw_signature[iter] : peak_value;
+            last_sample_time_us = capture_time_us[iter1];
             iter++;
+            settled = fc_capture_settled(fc_object, raw_signature, iter, peak_value, &variance);
         }
     }
+    while (iter < sample_length && !settled)
+    {
+        adc_value = fc_object->device_driver->adc_single_read(
+            fc_object->sensor_handle->adc_id, fc_object->sensor_handle->adc_controller, fc_object->sensor_handle->adc_channel);
+        tick_count = (VT_UINT)fc_object->device_driver->tick();
+        elapsed_time_us += (VT_ULONG)((VT_UINT)(tick_count - previous_tick_count)) * tick_resolution_usec;
+        previous_tick_count = tick_count;
 
-    fc_object->device_driver->tick_deinit();
-    fc_object->device_driver->interrupt_enable();
+        if (fc_object->plan.oversampling)
+        {
+            fc_oversample_accumulate(&oversample, adc_value);
+        }
+        if ((elapsed_time_us - last_sample_time_us) > sampling_period_us)
+        {
+            raw_signature[iter] = fc_oversample_take(fc_object, &oversample, adc_value, &variance);
+            peak_value          = (raw_signature[iter] > peak_value) ? raw_signature[iter] : peak_value;
+            last_sample_time_us = elapsed_time_us;
+            iter++;
+            settled = fc_capture_settled(fc_object, raw_signature, iter, peak_value, &variance);
+        }
+    }
+    *samples_read           = iter;
+    fc_object->samples_used = iter;
     fc_object->device_driver->gpio_on(
         fc_object->sensor_handle->gpio_id, fc_object->sensor_handle->gpio_port, fc_object->sensor_handle->gpio_pin);
-}
\ No newline at end of file
+    fc_object->device_driver->interrupt_enable();
+
+    if (rise_signature != NULL)
+    {
+        // Recharge sampled with interrupts enabled at the interval just chosen, mirrored below the peak of the discharge
+        rise_capture.fc_object             = fc_object;
+        rise_capture.raw_signatures        = raw_signature;
+        rise_capture.sampling_intervals_us = sampling_interval_us;
+        rise_capture.num_signatures        = 1;
+        rise_capture.sample_length         = sample_length;
+        rise_capture.samples_read          = samples_read;
+        rise_capture.rise_signatures       = rise_signature;
+        rise_capture.rise_samples_read     = rise_samples_read;
+        rise_capture.sampling_stretch      = NULL;
+        rise_capture.rise_sampling_stretch = NULL;
+        rise_capture.peak_value[0]         = peak_value;
+        rise_capture.variance              = variance;
+        fc_adc_capture_window(&rise_capture, 1, true, fc_object->device_driver, tick_resolution_usec);
+        variance = rise_capture.variance;
+    }
+    fc_oversample_variance_store(fc_object, &variance);
+
+    fc_object->device_driver->tick_deinit();
+}
+
+VT_UINT fc_adc_buffer_read_start(VT_FALLCURVE_OBJECT* fc_object, VT_ULONG sampling_interval_us)
+{
+    if (fc_object->device_driver->adc_buffer_read == NULL || fc_object->dma_capture.adc_read_buffer == NULL ||
+        fc_object->dma_capture.ongoing_collection || sampling_interval_us == 0)
+    {
+        return VT_ERROR;
+    }
+
+    /* The completion callbacks carry no context, a second capture would take them over from the ongoing one */
+    if (fc_object_reference != NULL)
+    {
+        VTLogError("FallCurve DMA capture already ongoing \r\n");
+        return VT_ERROR;
+    }
+
+    fc_object_reference                         = fc_object;
+    fc_object->dma_capture.sampling_interval_us = sampling_interval_us;
+    fc_object->dma_capture.ongoing_collection   = true;
+    fc_object->dma_capture.collection_complete  = false;
+    VTLogDebug("FallCurve DMA Sampling Interval: %lu \r\n", sampling_interval_us);
+
+    fc_object->device_driver->gpio_off(
+        fc_object->sensor_handle->gpio_id, fc_object->sensor_handle->gpio_port, fc_object->sensor_handle->gpio_pin);
+    fc_object->device_driver->adc_buffer_read(fc_object->sensor_handle->adc_id,
+        fc_object->sensor_handle->adc_controller,
+        fc_object->sensor_handle->adc_channel,
+        fc_object->dma_capture.adc_read_buffer,
+        fc_object->dma_capture.buffer_length,
+        SECOND_TO_MICROSECOND / (VT_FLOAT)sampling_interval_us,
+        &fc_adc_buffer_read_half_complete_callback,
+        &fc_adc_buffer_read_full_complete_callback);
+
+    return VT_SUCCESS;
+}
+
+VT_VOID fc_adc_buffer_decimate(VT_FALLCURVE_OBJECT* fc_object,
+    VT_UINT* raw_signatures,
+    const VT_ULONG* sampling_intervals_us,
+    VT_UINT num_signatures,
+    VT_UINT sample_length)
+{
+    VT_FLOAT decimation_factor = 0;
+    VT_UINT buffer_index       = 0;
+    VT_UINT next_buffer_index  = 0;
+    FC_OVERSAMPLE oversample   = {0};
+    FC_VARIANCE variance       = {0};
+
+    for (VT_UINT iter = 0; iter < num_signatures; iter++)
+    {
+        decimation_factor = (VT_FLOAT)sampling_intervals_us[iter] / (VT_FLOAT)fc_object->dma_capture.sampling_interval_us;
+        next_buffer_index = 0;
+
+        // Sample iter1 of a template sits one sampling interval after the previous one, like in fc_adc_read
+        for (VT_UINT iter1 = 0; iter1 < sample_length; iter1++)
+        {
+            buffer_index = round((VT_FLOAT)(iter1 + 1) * decimation_factor);
+            buffer_index = (buffer_index > 0) ? (buffer_index - 1) : 0;
+            if (buffer_index >= fc_object->dma_capture.buffer_length)
+            {
+                buffer_index = fc_object->dma_capture.buffer_length - 1;
+            }
+            for (; fc_object->plan.oversampling && next_buffer_index <= buffer_index; next_buffer_index++)
+            {
+                fc_oversample_accumulate(&oversample, fc_object->dma_capture.adc_read_buffer[next_buffer_index]);
+            }
+            raw_signatures[(iter * sample_length) + iter1] =
+                fc_oversample_take(fc_object, &oversample, fc_object->dma_capture.adc_read_buffer[buffer_index], &variance);
+        }
+    }
+    fc_oversample_variance_store(fc_object, &variance);
+}
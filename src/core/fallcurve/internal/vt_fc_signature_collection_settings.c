@@ -1,108 +1,67 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
 
-#include <math.h>
-
 #include "vt_debug.h"
+#include "vt_fc_read.h"
 #include "vt_fc_signature.h"
 
-VT_UINT fc_signature_compute_collection_settings(
-    VT_FALLCURVE_OBJECT* fc_object, VT_ULONG* sampling_interval_us, VT_UINT8* confidence_metric)
+VT_UINT fc_signature_compute_collection_settings(VT_FALLCURVE_OBJECT* fc_object,
+    VT_ULONG* sampling_interval_us,
+    VT_ULONG* falltime,
+    VT_FLOAT* pearson_coeff,
+    VT_ULONG* risetime,
+    VT_FLOAT* rise_pearson_coeff,
+    VT_UINT8* confidence_metric)
 {
-    VTLogInfo("\tComputing FallCurve Collection Settings\n");
-
-    VT_UINT max_tick_value            = 65535;
-    VT_UINT tick_resolution_usec      = 1;
-    VT_ULONG time_to_fall             = 0;
-    VT_ULONG time_to_powerup          = 0;
-    const VT_ULONG max_time_allowed   = VT_FC_MAX_SAMPLING_INTERVAL_US * VT_FC_SAMPLE_LENGTH;
-    VT_UINT adc_value_start           = 0;
-    VT_UINT adc_value                 = 0;
-    VT_UINT start_tick_count          = 0;
-    VT_UINT adc_resolution            = 0;
-    VT_FLOAT adc_ref_volt             = 0;
-    VT_ULONG falltime_calib_test      = 0;
-    VT_FLOAT pearson_coeff_calib_test = 0;
+    VT_UINT* raw_signature          = fc_object->scratch.calibration.raw_signature;
+    VT_UINT* rise_signature         = fc_object->plan.rise_curve ? fc_object->rise_buffer : NULL;
+    VT_UINT samples_read            = 0;
+    VT_UINT rise_samples_read       = 0;
+    VT_ULONG time_to_fall           = 0;
+    const VT_ULONG max_time_allowed = fc_object->plan.max_capture_time_us;
 
-    fc_object->device_driver->adc_single_read_init(fc_object->sensor_handle->adc_id,
-        fc_object->sensor_handle->adc_controller,
-        fc_object->sensor_handle->adc_channel,
-        &adc_resolution,
-        &adc_ref_volt);
-    adc_value_start = fc_object->device_driver->adc_single_read(
-        fc_object->sensor_handle->adc_id, fc_object->sensor_handle->adc_controller, fc_object->sensor_handle->adc_channel);
-    VTLogDebug("FallCurve first value: %d \r\n", adc_value_start);
-    adc_value_start = round(adc_value_start * 0.37f);
-
-    fc_object->device_driver->interrupt_disable();
-    fc_object->device_driver->tick_init(&max_tick_value, &tick_resolution_usec);
-    fc_object->device_driver->gpio_off(
-        fc_object->sensor_handle->gpio_id, fc_object->sensor_handle->gpio_port, fc_object->sensor_handle->gpio_pin);
-    start_tick_count = (VT_UINT)fc_object->device_driver->tick();
-
-    while (time_to_fall <= max_time_allowed)
-    {
-        adc_value = fc_object->device_driver->adc_single_read(
-            fc_object->sensor_handle->adc_id, fc_object->sensor_handle->adc_controller, fc_object->sensor_handle->adc_channel);
-        if (adc_value <= adc_value_start)
-        {
-            break;
-        }
-        time_to_fall += (VT_UINT)((VT_UINT)fc_object->device_driver->tick() - start_tick_count);
-        start_tick_count = (VT_UINT)fc_object->device_driver->tick();
-    }
+    *risetime           = 0;
+    *rise_pearson_coeff = 0;
+    VTLogInfo("\tComputing FallCurve Collection Settings\n");
 
-    fc_object->device_driver->tick_deinit();
-    fc_object->device_driver->interrupt_enable();
+    // The template comes from this one discharge, so like a status capture there is no earlier one to wait on a recharge for
     fc_object->device_driver->gpio_on(
         fc_object->sensor_handle->gpio_id, fc_object->sensor_handle->gpio_port, fc_object->sensor_handle->gpio_pin);
 
-    VTLogDebug("FallCurve expected last value: %d \r\n", adc_value_start);
-    VTLogDebug("FallCurve last value: %d \r\n", adc_value);
-    VTLogDebug("FallCurve time to reach 0.37: %lu \r\n", time_to_fall);
+    // A single discharge yields both the sampling interval and the signature sampled at it
+    fc_adc_calibration_read(fc_object,
+        raw_signature,
+        fc_object->plan.sample_length,
+        &samples_read,
+        rise_signature,
+        &rise_samples_read,
+        sampling_interval_us,
+        &time_to_fall);
+
     VTLogDebug("Maximum time allowed: %lu \r\n", max_time_allowed);
 
-    if (time_to_fall > max_time_allowed)
-    {
-        *confidence_metric    = 0;
-        *sampling_interval_us = VT_FC_MAX_SAMPLING_INTERVAL_US;
-    }
-    else if (time_to_fall == 0)
+    if (time_to_fall > max_time_allowed || time_to_fall == 0)
     {
-        *confidence_metric    = 0;
-        *sampling_interval_us = VT_FC_MIN_SAMPLING_INTERVAL_US;
+        *confidence_metric = 0;
     }
     else
     {
-        *confidence_metric    = 100;
-        *sampling_interval_us = round(time_to_fall / (float)VT_FC_SAMPLE_LENGTH);
-    }
-    if (*sampling_interval_us < VT_FC_MIN_SAMPLING_INTERVAL_US)
-    {
-        *sampling_interval_us = VT_FC_MIN_SAMPLING_INTERVAL_US;
-    }
-    VTLogDebug("Sampling Interval: %lu \r\n", *sampling_interval_us);
-
-    fc_object->device_driver->interrupt_disable();
-    fc_object->device_driver->tick_init(&max_tick_value, &tick_resolution_usec);
-    start_tick_count = (VT_UINT)fc_object->device_driver->tick();
-    while (time_to_powerup < time_to_fall)
-    {
-        time_to_powerup += (VT_UINT)((VT_UINT)fc_object->device_driver->tick() - start_tick_count);
-        start_tick_count = (VT_UINT)fc_object->device_driver->tick();
+        *confidence_metric = 100;
     }
-    fc_object->device_driver->tick_deinit();
-    fc_object->device_driver->interrupt_enable();
 
-    if (fc_signature_compute(fc_object, *sampling_interval_us, &falltime_calib_test, &pearson_coeff_calib_test))
+    if (fc_signature_compute_from_raw(fc_object, raw_signature, samples_read, *sampling_interval_us, falltime, pearson_coeff))
     {
         return VT_ERROR;
     }
 
-    *sampling_interval_us = round((float)falltime_calib_test / (float)VT_FC_SAMPLE_LENGTH);
-    if (*sampling_interval_us < VT_FC_MIN_SAMPLING_INTERVAL_US)
+    // A recharge without a usable shape leaves the template fall curve only
+    if (rise_signature != NULL &&
+        fc_signature_compute_from_raw(
+            fc_object, rise_signature, rise_samples_read, *sampling_interval_us, risetime, rise_pearson_coeff))
     {
-        *sampling_interval_us = VT_FC_MIN_SAMPLING_INTERVAL_US;
+        VTLogInfo("\tFallCurve rise curve not usable, template keeps the fall curve only\n");
+        *risetime           = 0;
+        *rise_pearson_coeff = 0;
     }
 
     return VT_SUCCESS;
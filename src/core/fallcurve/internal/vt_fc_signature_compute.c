@@ -4,7 +4,6 @@
 #include <math.h>
 
 #include "vt_debug.h"
-#include "vt_fc_read.h"
 #include "vt_fc_signature.h"
 
 static VT_UINT fc_signature_calculate_maximum_index(VT_UINT* raw_signature, VT_UINT sample_length)
@@ -70,14 +69,83 @@ static VT_FLOAT fc_signature_calculate_correlation_coefficient(VT_UINT* signatur
     return corr;
 }
 
-VT_UINT fc_signature_compute(
-    VT_FALLCURVE_OBJECT* fc_object, VT_ULONG sampling_interval_us, VT_ULONG* falltime, VT_FLOAT* pearson_coeff)
+static VT_UINT fc_signature_fit_log_linear(
+    VT_UINT* raw_signature, VT_UINT sample_length, VT_ULONG sampling_interval_us, VT_FALLCURVE_FIT* fit)
 {
-    VT_UINT raw_signature[VT_FC_SAMPLE_LENGTH] = {0};
-    VT_UINT sample_length                      = VT_FC_SAMPLE_LENGTH;
-    VT_ULONG falltime_computed                 = 0;
-    VT_FLOAT pearson_coeff_computed            = 0;
-    fc_adc_read(fc_object, raw_signature, sampling_interval_us, VT_FC_SAMPLE_LENGTH);
+    VT_FLOAT sum_w   = 0;
+    VT_FLOAT sum_wt  = 0;
+    VT_FLOAT sum_wtt = 0;
+    VT_FLOAT sum_wy  = 0;
+    VT_FLOAT sum_wty = 0;
+    VT_FLOAT sum_wyy = 0;
+    VT_FLOAT ratio   = 0;
+    VT_FLOAT weight  = 0;
+    VT_FLOAT log_v   = 0;
+
+    fit->num_datapoints = 0;
+    if (raw_signature[0] == 0)
+    {
+        return VT_ERROR;
+    }
+
+    // Normalising by the peak keeps ln(v) in [ln(0.37), 0] and the weights in (0, 1], so float sums stay well conditioned
+    for (VT_UINT iter = 0; iter < sample_length; iter++)
+    {
+        if (raw_signature[iter] == 0)
+        {
+            continue;
+        }
+        ratio  = (VT_FLOAT)raw_signature[iter] / (VT_FLOAT)raw_signature[0];
+        weight = ratio * ratio;
+        log_v  = logf(ratio);
+        sum_w += weight;
+        sum_wt += weight * (VT_FLOAT)iter;
+        sum_wtt += weight * (VT_FLOAT)iter * (VT_FLOAT)iter;
+        sum_wy += weight * log_v;
+        sum_wty += weight * (VT_FLOAT)iter * log_v;
+        sum_wyy += weight * log_v * log_v;
+        fit->num_datapoints++;
+    }
+
+    VT_FLOAT determinant = (sum_w * sum_wtt) - (sum_wt * sum_wt);
+    if (fit->num_datapoints <= VT_FC_MIN_FALLTIME_DATAPOINTS || determinant <= 0)
+    {
+        return VT_ERROR;
+    }
+    VT_FLOAT slope          = ((sum_w * sum_wty) - (sum_wt * sum_wy)) / determinant;
+    VT_FLOAT intercept      = (sum_wy - (slope * sum_wt)) / sum_w;
+    VT_FLOAT sum_sq_residue = fmaxf(0, sum_wyy - (intercept * sum_wy) - (slope * sum_wty));
+    VT_FLOAT sum_sq_total   = sum_wyy - ((sum_wy * sum_wy) / sum_w);
+    if (slope >= 0 || sum_sq_total <= 0)
+    {
+        return VT_ERROR;
+    }
+
+    fit->tau_us       = (-1.0f / slope) * (VT_FLOAT)sampling_interval_us;
+    fit->r_squared    = 1.0f - (sum_sq_residue / sum_sq_total);
+    fit->residual_rms = sqrtf(sum_sq_residue / sum_w);
+
+#if VT_LOG_LEVEL > 2
+    VT_INT32 decimal = fit->tau_us;
+    VT_INT32 frac    = (fit->tau_us - (VT_FLOAT)decimal) * 10000;
+    VTLogDebug("Log-linear fit tau us: %lu.%04lu \r\n", (long unsigned int)decimal, (long unsigned int)frac);
+    decimal = fit->r_squared;
+    frac    = (fit->r_squared - (VT_FLOAT)decimal) * 10000;
+    VTLogDebug("Log-linear fit R squared: %lu.%04lu \r\n", (long unsigned int)decimal, (long unsigned int)frac);
+#endif /* VT_LOG_LEVEL > 2 */
+
+    return VT_SUCCESS;
+}
+
+VT_UINT fc_signature_compute_from_raw(VT_FALLCURVE_OBJECT* fc_object,
+    VT_UINT* raw_signature,
+    VT_UINT sample_length,
+    VT_ULONG sampling_interval_us,
+    VT_ULONG* falltime,
+    VT_FLOAT* pearson_coeff)
+{
+    VT_ULONG falltime_computed      = 0;
+    VT_FLOAT pearson_coeff_computed = 0;
 
     VTLogDebug("FallCurve Raw: \r\n");
     for (VT_UINT iter = 0; iter < sample_length; iter++)
@@ -86,8 +154,13 @@ VT_UINT fc_signature_compute(
     }
     VTLogDebugNoTag("\r\n");
 
+    if (fc_object->plan.shape_fit == VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT)
+    {
+        return fc_signature_compute_from_raw_fixed(raw_signature, sample_length, sampling_interval_us, falltime, pearson_coeff);
+    }
+
     // Find index of Maxima
-    VT_UINT index_max = fc_signature_calculate_maximum_index(raw_signature, VT_FC_SAMPLE_LENGTH);
+    VT_UINT index_max = fc_signature_calculate_maximum_index(raw_signature, sample_length);
     // Delete data BEFORE the maxima
     sample_length = sample_length - index_max;
     for (VT_UINT iter = 0; iter < sample_length; iter++)
@@ -101,6 +174,19 @@ VT_UINT fc_signature_compute(
     {
         sample_length = index_37 + 1;
     }
+    if (fc_object->plan.shape_fit == VT_FC_SHAPE_FIT_LOG_LINEAR)
+    {
+        // Sub-sample falltime and R squared shape score from one pass over the samples, no reconstructed curve needed
+        if (fc_signature_fit_log_linear(raw_signature, sample_length, sampling_interval_us, &(fc_object->fit)) ||
+            fc_object->fit.r_squared <= VT_FC_MIN_SHAPE_MATCH)
+        {
+            return VT_ERROR;
+        }
+        *falltime      = round(fc_object->fit.tau_us);
+        *pearson_coeff = fc_object->fit.r_squared;
+        return VT_SUCCESS;
+    }
+
     // Calculate FallTime
     falltime_computed = (VT_ULONG)index_37 * sampling_interval_us;
     VTLogDebug("FallTime computed: %lu\r\n", falltime_computed);
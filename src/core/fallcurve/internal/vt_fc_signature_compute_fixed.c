@@ -0,0 +1,239 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include "vt_debug.h"
+#include "vt_fc_signature.h"
+
+/* Q16 fixed point, all arithmetic below is integer so results match bit for bit on every target */
+#define FIXED_Q16_SHIFT 16
+#define FIXED_Q16_ONE   ((VT_INT64)1 << FIXED_Q16_SHIFT)
+#define FIXED_Q30_SHIFT 30
+#define FIXED_LN2_Q16   45426
+
+#define FIXED_MIN_SHAPE_MATCH_Q16        ((VT_INT64)(VT_FC_MIN_SHAPE_MATCH * FIXED_Q16_ONE))
+#define FIXED_MAX_FALLTIME_DEVIATION_Q16 ((VT_INT64)(VT_FC_MAX_FALLTIME_DEVIATION * FIXED_Q16_ONE))
+#define FIXED_MAX_SHAPE_DEVIATION_Q16    ((VT_INT64)((VT_FC_MAX_SHAPE_DEVIATION)*FIXED_Q16_ONE))
+
+/* round(2^30 / k!) for k = 0..9, Taylor terms of exp on [0, 1] */
+static const VT_UINT64 fixed_exp_coefficients_q30[] = {
+    1073741824, 1073741824, 536870912, 178956971, 44739243, 8947849, 1491308, 213044, 26631, 2959};
+
+static VT_INT32 fc_fixed_log2_q16(VT_UINT32 value)
+{
+    VT_INT32 integer_part  = 0;
+    VT_INT32 fraction_part = 0;
+    VT_UINT64 mantissa_q16 = 0;
+
+    while ((value >> (integer_part + 1)) != 0)
+    {
+        integer_part++;
+    }
+    mantissa_q16 = (integer_part > FIXED_Q16_SHIFT) ? ((VT_UINT64)value >> (integer_part - FIXED_Q16_SHIFT))
+                                                     : ((VT_UINT64)value << (FIXED_Q16_SHIFT - integer_part));
+
+    // One fractional bit per squaring of the mantissa in [1, 2)
+    for (VT_INT32 bit = FIXED_Q16_SHIFT - 1; bit >= 0; bit--)
+    {
+        mantissa_q16 = (mantissa_q16 * mantissa_q16) >> FIXED_Q16_SHIFT;
+        if (mantissa_q16 >= ((VT_UINT64)2 << FIXED_Q16_SHIFT))
+        {
+            mantissa_q16 >>= 1;
+            fraction_part |= (1 << bit);
+        }
+    }
+
+    return (integer_part << FIXED_Q16_SHIFT) + fraction_part;
+}
+
+static VT_UINT64 fc_fixed_exp_neg_q30(VT_UINT64 x_q30)
+{
+    VT_UINT64 result_q30 = fixed_exp_coefficients_q30[9];
+
+    // Alternating Horner form, every partial result stays positive for x in [0, 1]
+    for (VT_INT32 iter = 8; iter >= 0; iter--)
+    {
+        result_q30 = fixed_exp_coefficients_q30[iter] - ((x_q30 * result_q30) >> FIXED_Q30_SHIFT);
+    }
+
+    return result_q30;
+}
+
+static VT_UINT64 fc_fixed_sqrt(VT_UINT64 value)
+{
+    VT_UINT64 result = 0;
+    VT_UINT64 bit    = (VT_UINT64)1 << 62;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+static VT_UINT fc_fixed_calculate_maximum_index(VT_UINT* raw_signature, VT_UINT sample_length)
+{
+    VT_UINT index_max = 0;
+
+    for (VT_UINT iter = 0; iter < sample_length; iter++)
+    {
+        if (raw_signature[iter] > raw_signature[index_max])
+        {
+            index_max = iter;
+        }
+    }
+
+    return index_max;
+}
+
+static VT_UINT fc_fixed_calculate_37index(VT_UINT* raw_signature, VT_UINT sample_length)
+{
+    VT_INT32 log2_ratio_q16 = 0;
+    VT_INT32 ln_ratio_q16   = 0;
+
+    for (VT_UINT iter = 1; iter < sample_length; iter++)
+    {
+        if (((VT_UINT32)raw_signature[iter] * 100) <= ((VT_UINT32)raw_signature[0] * 37))
+        {
+            return iter;
+        }
+    }
+
+    // Never crossed 37%, extrapolate the time constant from the first and last samples
+    if (raw_signature[0] == 0 || raw_signature[sample_length - 1] == 0)
+    {
+        return sample_length;
+    }
+    log2_ratio_q16 = fc_fixed_log2_q16(raw_signature[0]) - fc_fixed_log2_q16(raw_signature[sample_length - 1]);
+    ln_ratio_q16   = (VT_INT32)(((VT_INT64)log2_ratio_q16 * FIXED_LN2_Q16) >> FIXED_Q16_SHIFT);
+    if (ln_ratio_q16 <= 0)
+    {
+        return sample_length;
+    }
+
+    return (VT_UINT)((((VT_INT64)sample_length << FIXED_Q16_SHIFT) / ln_ratio_q16) + 1);
+}
+
+static VT_INT32 fc_fixed_calculate_correlation_coefficient_q16(
+    VT_UINT* signature1, VT_UINT* signature2, VT_UINT sample_length)
+{
+    VT_INT64 sum_signature1            = 0;
+    VT_INT64 sum_signature2            = 0;
+    VT_INT64 sum_signature1_signature2 = 0;
+    VT_INT64 square_sum_signature1     = 0;
+    VT_INT64 square_sum_signature2     = 0;
+
+    for (VT_UINT iter = 0; iter < sample_length; iter++)
+    {
+        sum_signature1 += signature1[iter];
+        sum_signature2 += signature2[iter];
+        sum_signature1_signature2 += (VT_INT64)signature1[iter] * signature2[iter];
+        square_sum_signature1 += (VT_INT64)signature1[iter] * signature1[iter];
+        square_sum_signature2 += (VT_INT64)signature2[iter] * signature2[iter];
+    }
+
+    VT_INT64 numerator   = ((VT_INT64)sample_length * sum_signature1_signature2) - (sum_signature1 * sum_signature2);
+    VT_INT64 spread1     = ((VT_INT64)sample_length * square_sum_signature1) - (sum_signature1 * sum_signature1);
+    VT_INT64 spread2     = ((VT_INT64)sample_length * square_sum_signature2) - (sum_signature2 * sum_signature2);
+    VT_INT64 denominator = (VT_INT64)(fc_fixed_sqrt((VT_UINT64)spread1) * fc_fixed_sqrt((VT_UINT64)spread2));
+
+    if (spread1 <= 0 || spread2 <= 0 || denominator == 0)
+    {
+        return 0;
+    }
+
+    return (VT_INT32)((numerator * FIXED_Q16_ONE) / denominator);
+}
+
+static VT_INT64 fc_fixed_deviation_q16(VT_INT64 value_under_test, VT_INT64 value_saved)
+{
+    VT_INT64 difference = value_under_test - value_saved;
+
+    return ((abs_custom(difference) * 100) << FIXED_Q16_SHIFT) / value_saved;
+}
+
+VT_UINT fc_signature_compute_from_raw_fixed(
+    VT_UINT* raw_signature, VT_UINT sample_length, VT_ULONG sampling_interval_us, VT_ULONG* falltime, VT_FLOAT* pearson_coeff)
+{
+    VT_UINT perfect_exponential_raw_siganture[VT_FC_SAMPLE_LENGTH];
+    VT_INT32 pearson_coeff_q16 = 0;
+    VT_UINT64 exponent_q30     = 0;
+
+    if (sample_length == 0)
+    {
+        return VT_ERROR;
+    }
+
+    VT_UINT index_max = fc_fixed_calculate_maximum_index(raw_signature, sample_length);
+    sample_length     = sample_length - index_max;
+    for (VT_UINT iter = 0; iter < sample_length; iter++)
+    {
+        raw_signature[iter] = raw_signature[iter + index_max];
+    }
+    VT_UINT index_37 = fc_fixed_calculate_37index(raw_signature, sample_length);
+    if (index_37 < sample_length)
+    {
+        sample_length = index_37 + 1;
+    }
+    if (sample_length <= VT_FC_MIN_FALLTIME_DATAPOINTS)
+    {
+        return VT_ERROR;
+    }
+
+    // v0 * exp(-iter / (sample_length - 1)), rounded to the nearest ADC count
+    for (VT_UINT iter = 0; iter < sample_length; iter++)
+    {
+        exponent_q30 = ((VT_UINT64)iter << FIXED_Q30_SHIFT) / (VT_UINT64)(sample_length - 1);
+        perfect_exponential_raw_siganture[iter] = (VT_UINT)(
+            (((VT_UINT64)raw_signature[0] * fc_fixed_exp_neg_q30(exponent_q30)) + ((VT_UINT64)1 << (FIXED_Q30_SHIFT - 1))) >>
+            FIXED_Q30_SHIFT);
+    }
+    pearson_coeff_q16 =
+        fc_fixed_calculate_correlation_coefficient_q16(perfect_exponential_raw_siganture, raw_signature, sample_length);
+    VTLogDebug("FallTime computed: %lu, Pearson Coeff Q16: %ld \r\n",
+        (long unsigned int)((VT_ULONG)index_37 * sampling_interval_us),
+        (long int)pearson_coeff_q16);
+
+    if (pearson_coeff_q16 > FIXED_MIN_SHAPE_MATCH_Q16)
+    {
+        *falltime      = (VT_ULONG)index_37 * sampling_interval_us;
+        *pearson_coeff = (VT_FLOAT)pearson_coeff_q16 / (VT_FLOAT)FIXED_Q16_ONE;
+        return VT_SUCCESS;
+    }
+
+    return VT_ERROR;
+}
+
+VT_UINT fc_signature_evaluate_fixed(
+    VT_ULONG falltime_under_test, VT_ULONG falltime_saved, VT_FLOAT pearson_coeff_under_test, VT_FLOAT pearson_coeff_saved)
+{
+    // Shape scores produced by the fixed point path are exact multiples of 2^-16, so this conversion is lossless for them
+    VT_INT64 pearson_coeff_under_test_q16 = (VT_INT64)((pearson_coeff_under_test * (VT_FLOAT)FIXED_Q16_ONE) + 0.5f);
+    VT_INT64 pearson_coeff_saved_q16      = (VT_INT64)((pearson_coeff_saved * (VT_FLOAT)FIXED_Q16_ONE) + 0.5f);
+
+    if (falltime_saved == 0 || pearson_coeff_saved_q16 <= 0)
+    {
+        return VT_ERROR;
+    }
+
+    if (fc_fixed_deviation_q16((VT_INT64)falltime_under_test, (VT_INT64)falltime_saved) < FIXED_MAX_FALLTIME_DEVIATION_Q16 &&
+        fc_fixed_deviation_q16(pearson_coeff_under_test_q16, pearson_coeff_saved_q16) < FIXED_MAX_SHAPE_DEVIATION_Q16)
+    {
+        return VT_SUCCESS;
+    }
+
+    return VT_ERROR;
+}
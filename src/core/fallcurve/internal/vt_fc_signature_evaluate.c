@@ -2,6 +2,7 @@
    Licensed under the MIT License. */
 
 #include "vt_debug.h"
+#include "vt_fc_database.h"
 #include "vt_fc_signature.h"
 #include <math.h>
 
@@ -46,3 +47,112 @@ VT_UINT fc_signature_evaluate(
     }
     return VT_ERROR;
 }
+
+static VT_UINT fc_signature_evaluate_shape_fit(VT_FALLCURVE_OBJECT* fc_object,
+    VT_ULONG falltime_under_test,
+    VT_ULONG falltime_saved,
+    VT_FLOAT pearson_coeff_under_test,
+    VT_FLOAT pearson_coeff_saved)
+{
+    if (fc_object->plan.shape_fit == VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT)
+    {
+        return fc_signature_evaluate_fixed(falltime_under_test, falltime_saved, pearson_coeff_under_test, pearson_coeff_saved);
+    }
+
+    return fc_signature_evaluate(falltime_under_test, falltime_saved, pearson_coeff_under_test, pearson_coeff_saved);
+}
+
+VT_VOID fc_signature_status_compute(VT_FALLCURVE_OBJECT* fc_object,
+    VT_UINT* raw_signatures,
+    const VT_UINT* samples_read,
+    VT_UINT* rise_signatures,
+    const VT_UINT* rise_samples_read,
+    const VT_FLOAT* sampling_stretch,
+    const VT_FLOAT* rise_sampling_stretch,
+    VT_UINT num_signatures,
+    VT_UINT* sensor_status,
+    VT_UINT* sensor_drift)
+{
+    VT_UINT sample_length               = fc_object->plan.sample_length;
+    VT_ULONG falltime                   = 0;
+    VT_FLOAT pearson_coeff              = 0;
+    VT_ULONG sampling_interval_us_saved = 0;
+    VT_ULONG falltime_saved             = 0;
+    VT_FLOAT pearson_coeff_saved        = 0;
+    VT_ULONG risetime_saved             = 0;
+    VT_FLOAT rise_pearson_coeff_saved   = 0;
+
+    VT_BOOL signature_compute_fail  = false;
+    VT_BOOL signature_evaluate_fail = false;
+
+    for (VT_UINT iter = 0; iter < num_signatures; iter++)
+    {
+        if (fc_fetch_signature(fc_object, iter, &sampling_interval_us_saved, &falltime_saved, &pearson_coeff_saved))
+        {
+            break;
+        }
+        if (fc_signature_compute_from_raw(fc_object,
+                &raw_signatures[iter * sample_length],
+                samples_read[iter],
+                sampling_interval_us_saved,
+                &falltime,
+                &pearson_coeff))
+        {
+            signature_compute_fail = true;
+            continue;
+        }
+        if (sampling_stretch != NULL)
+        {
+            falltime = (VT_ULONG)roundf((VT_FLOAT)falltime * sampling_stretch[iter]);
+        }
+        if (fc_signature_evaluate_shape_fit(fc_object, falltime, falltime_saved, pearson_coeff, pearson_coeff_saved))
+        {
+            signature_evaluate_fail = true;
+            continue;
+        }
+
+        // Templates with a rise curve must also match on the recharge captured after the discharge
+        if (rise_signatures != NULL && !fc_fetch_rise_signature(fc_object, iter, &risetime_saved, &rise_pearson_coeff_saved))
+        {
+            if (fc_signature_compute_from_raw(fc_object,
+                    &rise_signatures[iter * sample_length],
+                    rise_samples_read[iter],
+                    sampling_interval_us_saved,
+                    &falltime,
+                    &pearson_coeff))
+            {
+                signature_compute_fail = true;
+                continue;
+            }
+            if (rise_sampling_stretch != NULL)
+            {
+                falltime = (VT_ULONG)roundf((VT_FLOAT)falltime * rise_sampling_stretch[iter]);
+            }
+            if (fc_signature_evaluate_shape_fit(fc_object, falltime, risetime_saved, pearson_coeff, rise_pearson_coeff_saved))
+            {
+                signature_evaluate_fail = true;
+                continue;
+            }
+        }
+
+        *sensor_status = VT_SIGNATURE_MATCHING;
+        *sensor_drift  = 0;
+        return;
+    }
+
+    if (signature_evaluate_fail)
+    {
+        *sensor_status = VT_SIGNATURE_NOT_MATCHING;
+        *sensor_drift  = 100;
+    }
+    else if (signature_compute_fail)
+    {
+        *sensor_status = VT_SIGNATURE_COMPUTE_FAIL;
+        *sensor_drift  = 100;
+    }
+    else
+    {
+        *sensor_status = VT_SIGNATURE_DB_EMPTY;
+        *sensor_drift  = 100;
+    }
+}
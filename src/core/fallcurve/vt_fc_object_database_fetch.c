@@ -1,88 +1,50 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
 
-#include <string.h>
-
+#include "vt_codec_api.h"
 #include "vt_debug.h"
 #include "vt_fc_api.h"
 #include "vt_fc_database.h"
 
-
 VT_VOID vt_fallcurve_object_database_fetch(VT_FALLCURVE_OBJECT* fc_object, VT_FALLCURVE_DATABASE_FLATTENED* flattened_db)
 {
-    VT_CHAR string_buffer[40];
-    VT_CHAR string_element[10];
-    VT_INT decimal;
-    VT_FLOAT frac_float;
-    VT_INT frac;
-    VT_INT str_manipulation_return;
-    VT_INT str_buffer_space_available;
-
-    memset(string_buffer, 0, sizeof(string_buffer));
-    str_manipulation_return = snprintf(string_buffer, sizeof(string_buffer), "%03d", fc_object->fingerprintdb.num_signatures);
-    if (str_manipulation_return < 0 || (VT_UINT)str_manipulation_return > sizeof(string_buffer))
+    VT_ULONG num_signatures_length       = 0;
+    VT_ULONG sampling_interval_us_length = 0;
+    VT_ULONG falltime_length             = 0;
+    VT_ULONG pearson_coeff_length        = 0;
+    VT_UINT status                       = VT_SUCCESS;
+
+    status |= vt_codec_csv_append_unsigned((VT_CHAR*)flattened_db->num_signatures,
+        sizeof(flattened_db->num_signatures),
+        &num_signatures_length,
+        fc_object->fingerprintdb.num_signatures,
+        3);
+
+    // Each list is appended in place at its tracked length, a single pass over the signatures
+    flattened_db->sampling_interval_us[0] = '\0';
+    flattened_db->falltime[0]             = '\0';
+    flattened_db->pearson_coeff[0]        = '\0';
+    for (VT_UINT iter = 0; iter < fc_object->fingerprintdb.num_signatures && iter < VT_FC_MAX_SIGNATURES; iter++)
     {
-        VTLogError("Flattened Database Buffer Overflow! \r\n");
+        status |= vt_codec_csv_append_unsigned((VT_CHAR*)flattened_db->sampling_interval_us,
+            sizeof(flattened_db->sampling_interval_us),
+            &sampling_interval_us_length,
+            fc_object->fingerprintdb.db[iter].sampling_interval_us,
+            1);
+        status |= vt_codec_csv_append_unsigned((VT_CHAR*)flattened_db->falltime,
+            sizeof(flattened_db->falltime),
+            &falltime_length,
+            fc_object->fingerprintdb.db[iter].falltime,
+            1);
+        status |= vt_codec_csv_append_fixed((VT_CHAR*)flattened_db->pearson_coeff,
+            sizeof(flattened_db->pearson_coeff),
+            &pearson_coeff_length,
+            fc_object->fingerprintdb.db[iter].pearson_coeff,
+            VT_CODEC_CSV_DECIMALS);
     }
-    strncpy((VT_CHAR*)flattened_db->num_signatures, string_buffer, sizeof(flattened_db->num_signatures) - 1);
 
-    memset(string_buffer, 0, sizeof(string_buffer));
-    for (VT_UINT iter = 0; iter < fc_object->fingerprintdb.num_signatures; iter++)
+    if (status != VT_SUCCESS)
     {
-        str_manipulation_return =
-            snprintf(string_element, sizeof(string_element), "%lu", fc_object->fingerprintdb.db[iter].sampling_interval_us);
-        if (str_manipulation_return < 0 || (VT_UINT)str_manipulation_return > sizeof(string_element))
-        {
-            VTLogError("Flattened Database Buffer Overflow! \r\n");
-        }
-        if (iter > 0)
-        {
-            str_buffer_space_available = sizeof(string_buffer) - strlen(string_buffer);
-            strncat(string_buffer, ",", str_buffer_space_available);
-        }
-        str_buffer_space_available = sizeof(string_buffer) - strlen(string_buffer);
-        strncat(string_buffer, string_element, str_buffer_space_available);
-    }
-    strncpy((VT_CHAR*)flattened_db->sampling_interval_us, string_buffer, sizeof(flattened_db->sampling_interval_us) - 1);
-
-    memset(string_buffer, 0, sizeof(string_buffer));
-    for (VT_UINT iter = 0; iter < fc_object->fingerprintdb.num_signatures; iter++)
-    {
-        str_manipulation_return =
-            snprintf(string_element, sizeof(string_element), "%lu", fc_object->fingerprintdb.db[iter].falltime);
-        if (str_manipulation_return < 0 || (VT_UINT)str_manipulation_return > sizeof(string_element))
-        {
-            VTLogError("Flattened Database Buffer Overflow! \r\n");
-        }
-        if (iter > 0)
-        {
-            str_buffer_space_available = sizeof(string_buffer) - strlen(string_buffer);
-            strncat(string_buffer, ",", str_buffer_space_available);
-        }
-        str_buffer_space_available = sizeof(string_buffer) - strlen(string_buffer);
-        strncat(string_buffer, string_element, str_buffer_space_available);
-    }
-    strncpy((VT_CHAR*)flattened_db->falltime, string_buffer, sizeof(flattened_db->falltime) - 1);
-
-    memset(string_buffer, 0, sizeof(string_buffer));
-    for (VT_UINT iter = 0; iter < fc_object->fingerprintdb.num_signatures; iter++)
-    {
-        decimal    = fc_object->fingerprintdb.db[iter].pearson_coeff;
-        frac_float = fc_object->fingerprintdb.db[iter].pearson_coeff - (VT_FLOAT)decimal;
-        frac       = frac_float * 10000;
-        memset(string_element, 0, sizeof(string_element));
-        str_manipulation_return = snprintf(string_element, sizeof(string_element), "%d.%04d", decimal, frac);
-        if (str_manipulation_return < 0 || (VT_UINT)str_manipulation_return > sizeof(string_element))
-        {
-            VTLogError("Flattened Database Buffer Overflow! \r\n");
-        }
-        if (iter > 0)
-        {
-            str_buffer_space_available = sizeof(string_buffer) - strlen(string_buffer);
-            strncat(string_buffer, ",", str_buffer_space_available);
-        }
-        str_buffer_space_available = sizeof(string_buffer) - strlen(string_buffer);
-        strncat(string_buffer, string_element, str_buffer_space_available);
+        VTLogError("Flattened Database Buffer Overflow! \r\n");
     }
-    strncpy((VT_CHAR*)flattened_db->pearson_coeff, string_buffer, sizeof(flattened_db->pearson_coeff) - 1);
-}
\ No newline at end of file
+}
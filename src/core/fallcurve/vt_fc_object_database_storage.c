@@ -0,0 +1,55 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include <string.h>
+
+#include "vt_codec_api.h"
+#include "vt_debug.h"
+#include "vt_fc_api.h"
+
+VT_UINT vt_fallcurve_object_database_store(VT_FALLCURVE_OBJECT* fc_object, VT_CHAR* key)
+{
+    VT_UCHAR buffer[VT_CODEC_FALLCURVE_MAX_SIZE];
+    VT_UCHAR stored_buffer[VT_CODEC_FALLCURVE_MAX_SIZE];
+    VT_ULONG encoded_size = 0;
+    VT_ULONG stored_size  = 0;
+
+    if (!vt_device_driver_hook_enabled(fc_object->device_driver, VT_DEVICE_DRIVER_HOOK_STORAGE))
+    {
+        return VT_ERROR;
+    }
+    if (vt_codec_fallcurve_database_encode(&(fc_object->fingerprintdb), buffer, sizeof(buffer), &encoded_size))
+    {
+        return VT_ERROR;
+    }
+
+    // Every sync and fetch stores the template, flash is only written when it actually changed
+    if (fc_object->device_driver->storage_load(key, stored_buffer, sizeof(stored_buffer), &stored_size) == VT_SUCCESS &&
+        stored_size == encoded_size && memcmp(stored_buffer, buffer, encoded_size) == 0)
+    {
+        return VT_SUCCESS;
+    }
+
+    return fc_object->device_driver->storage_store(key, buffer, encoded_size);
+}
+
+VT_UINT vt_fallcurve_object_database_load(VT_FALLCURVE_OBJECT* fc_object, VT_CHAR* key)
+{
+    VT_UCHAR buffer[VT_CODEC_FALLCURVE_MAX_SIZE];
+    VT_ULONG stored_size = 0;
+
+    if (!vt_device_driver_hook_enabled(fc_object->device_driver, VT_DEVICE_DRIVER_HOOK_STORAGE) ||
+        fc_object->device_driver->storage_load(key, buffer, sizeof(buffer), &stored_size))
+    {
+        return VT_ERROR;
+    }
+
+    // Version and CRC are checked by the codec, a stale or corrupted template is never restored
+    if (vt_fallcurve_object_database_sync_binary(fc_object, buffer, stored_size))
+    {
+        VTLogError("Stored fallcurve template %s is not valid \r\n", key);
+        return VT_ERROR;
+    }
+
+    return VT_SUCCESS;
+}
@@ -1,54 +1,85 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
 
-#include <math.h>
-#include <stdlib.h>
-#include <string.h>
-
+#include "vt_codec_api.h"
+#include "vt_debug.h"
 #include "vt_fc_api.h"
 #include "vt_fc_database.h"
 
 VT_VOID vt_fallcurve_object_database_sync(VT_FALLCURVE_OBJECT* fc_object, VT_FALLCURVE_DATABASE_FLATTENED* flattened_db)
 {
-    VT_CHAR* token;
-    VT_CHAR* csvString;
+    VT_ULONG num_signatures                = 0;
+    VT_ULONG num_signatures_position       = 0;
+    VT_ULONG sampling_interval_us_position = 0;
+    VT_ULONG falltime_position             = 0;
+    VT_ULONG pearson_coeff_position        = 0;
     VT_UINT iter;
 
-    fc_object->fingerprintdb.num_signatures = atof((VT_CHAR*)flattened_db->num_signatures);
+    vt_codec_csv_parse_unsigned(
+        (VT_CHAR*)flattened_db->num_signatures, sizeof(flattened_db->num_signatures), &num_signatures_position, &num_signatures);
+    fc_object->fingerprintdb.num_signatures = (num_signatures > VT_FC_MAX_SIGNATURES) ? VT_FC_MAX_SIGNATURES : num_signatures;
 
-    iter = 0;
-    for (csvString = (VT_CHAR*)flattened_db->sampling_interval_us;; csvString = NULL)
+    // Lists are parsed in place without modifying the flattened template, at most one entry per signature slot
+    for (iter = 0; iter < VT_FC_MAX_SIGNATURES; iter++)
     {
-        token = strtok(csvString, ",");
-        if (token == NULL)
+        if (vt_codec_csv_parse_unsigned((VT_CHAR*)flattened_db->sampling_interval_us,
+                sizeof(flattened_db->sampling_interval_us),
+                &sampling_interval_us_position,
+                &(fc_object->fingerprintdb.db[iter].sampling_interval_us)))
         {
             break;
         }
-        fc_object->fingerprintdb.db[iter].sampling_interval_us = atof((VT_CHAR*)token);
-        iter++;
     }
 
-    iter = 0;
-    for (csvString = (VT_CHAR*)flattened_db->falltime;; csvString = NULL)
+    for (iter = 0; iter < VT_FC_MAX_SIGNATURES; iter++)
     {
-        token = strtok(csvString, ",");
-        if (token == NULL)
+        if (vt_codec_csv_parse_unsigned((VT_CHAR*)flattened_db->falltime,
+                sizeof(flattened_db->falltime),
+                &falltime_position,
+                &(fc_object->fingerprintdb.db[iter].falltime)))
         {
             break;
         }
-        fc_object->fingerprintdb.db[iter].falltime = atof((VT_CHAR*)token);
-        iter++;
     }
 
-    iter = 0;
-    for (csvString = (VT_CHAR*)flattened_db->pearson_coeff;; csvString = NULL)
+    for (iter = 0; iter < VT_FC_MAX_SIGNATURES; iter++)
     {
-        token = strtok(csvString, ",");
-        if (token == NULL)
+        if (vt_codec_csv_parse_float((VT_CHAR*)flattened_db->pearson_coeff,
+                sizeof(flattened_db->pearson_coeff),
+                &pearson_coeff_position,
+                &(fc_object->fingerprintdb.db[iter].pearson_coeff)))
         {
             break;
         }
-        fc_object->fingerprintdb.db[iter].pearson_coeff = atof((VT_CHAR*)token);
-        iter++;
     }
-}
\ No newline at end of file
+
+    // Rise curves are not part of the twin template, synced templates are evaluated on the fall curve only
+    for (iter = 0; iter < VT_FC_MAX_SIGNATURES; iter++)
+    {
+        fc_object->fingerprintdb.db[iter].risetime           = 0;
+        fc_object->fingerprintdb.db[iter].rise_pearson_coeff = 0;
+    }
+
+    // Nor is the shape fit, synced templates are taken to be scored with the one in use
+    fc_object->fingerprintdb.shape_fit = fc_object->plan.shape_fit;
+}
+
+VT_UINT vt_fallcurve_object_database_sync_binary(VT_FALLCURVE_OBJECT* fc_object, VT_UCHAR* buffer, VT_ULONG buffer_size)
+{
+    VT_FALLCURVE_DATABASE decoded;
+
+    if (vt_codec_fallcurve_database_decode(&decoded, buffer, buffer_size))
+    {
+        return VT_ERROR;
+    }
+
+    // Scores of one fit mean nothing to another, such a template must be recalibrated rather than evaluated
+    if (decoded.shape_fit != fc_object->plan.shape_fit)
+    {
+        VTLogError("Fallcurve template shape fit %d does not match %d in use \r\n", decoded.shape_fit, fc_object->plan.shape_fit);
+        return VT_ERROR;
+    }
+
+    fc_object->fingerprintdb = decoded;
+    return VT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 /* Copyright (c) Microsoft Corporation.
    Licensed under the MIT License. */
 
+#include "vt_debug.h"
 #include "vt_fc_api.h"
 #include "vt_fc_database.h"
 
@@ -12,4 +13,118 @@ VT_VOID vt_fallcurve_object_initialize(
     fc_object->device_driver = device_driver;
 
     fc_reset_db(fc_object);
+
+    fc_object->dma_capture.adc_read_buffer      = NULL;
+    fc_object->dma_capture.buffer_length        = 0;
+    fc_object->dma_capture.sampling_interval_us = 0;
+    fc_object->dma_capture.ongoing_collection   = false;
+    fc_object->dma_capture.collection_complete  = false;
+    fc_object->rise_buffer                      = NULL;
+    fc_object->sample_variance                  = 0;
+    fc_object->samples_used                     = 0;
+    fc_object->fit.tau_us                       = 0;
+    fc_object->fit.r_squared                    = 0;
+    fc_object->fit.residual_rms                 = 0;
+    fc_object->fit.num_datapoints               = 0;
+
+    vt_fallcurve_object_plan_create(fc_object, VT_FC_SAMPLE_LENGTH);
+}
+
+VT_UINT vt_fallcurve_object_plan_create(VT_FALLCURVE_OBJECT* fc_object, VT_UINT sample_length)
+{
+    if (sample_length < VT_FC_MIN_SAMPLE_LENGTH || sample_length > VT_FC_SAMPLE_LENGTH)
+    {
+        VTLogError("Fallcurve plan sample length %d not supported \r\n", sample_length);
+        return VT_ERROR;
+    }
+
+    fc_object->plan.sample_length       = sample_length;
+    fc_object->plan.max_capture_time_us = (VT_ULONG)VT_FC_MAX_SAMPLING_INTERVAL_US * sample_length;
+    fc_object->plan.oversampling        = false;
+    fc_object->plan.early_stop_fraction = VT_FC_EARLY_STOP_FRACTION;
+    fc_object->plan.shape_fit           = VT_FC_SHAPE_FIT_PEARSON;
+    fc_object->plan.rise_curve          = false;
+
+    return VT_SUCCESS;
+}
+
+VT_VOID vt_fallcurve_object_oversampling_enable(VT_FALLCURVE_OBJECT* fc_object, VT_BOOL enable)
+{
+    fc_object->plan.oversampling = enable;
+    fc_object->sample_variance   = 0;
+}
+
+VT_VOID vt_fallcurve_object_oversampling_fetch_status(VT_FALLCURVE_OBJECT* fc_object, VT_FLOAT* sample_variance)
+{
+    *sample_variance = fc_object->sample_variance;
+}
+
+VT_UINT vt_fallcurve_object_early_stop_set(VT_FALLCURVE_OBJECT* fc_object, VT_FLOAT fraction)
+{
+    // The signature is cut at the 37% point, so stopping any earlier would lose data it needs
+    if (fraction < 0 || fraction >= 0.37f)
+    {
+        VTLogError("Fallcurve early stop fraction must lie in [0, 0.37) \r\n");
+        return VT_ERROR;
+    }
+
+    fc_object->plan.early_stop_fraction = fraction;
+
+    return VT_SUCCESS;
+}
+
+VT_VOID vt_fallcurve_object_early_stop_fetch_status(VT_FALLCURVE_OBJECT* fc_object, VT_UINT* samples_used)
+{
+    *samples_used = fc_object->samples_used;
+}
+
+VT_VOID vt_fallcurve_object_capture_time_fetch_status(VT_FALLCURVE_OBJECT* fc_object, VT_ULONG* capture_time_us)
+{
+    VT_ULONG sampling_interval_us = 0;
+
+    for (VT_UINT iter = 0; iter < fc_object->fingerprintdb.num_signatures; iter++)
+    {
+        if (fc_object->fingerprintdb.db[iter].sampling_interval_us > sampling_interval_us)
+        {
+            sampling_interval_us = fc_object->fingerprintdb.db[iter].sampling_interval_us;
+        }
+    }
+    *capture_time_us = (VT_ULONG)fc_object->samples_used * sampling_interval_us;
+    if (fc_object->plan.rise_curve)
+    {
+        *capture_time_us *= 2;
+    }
+}
+
+VT_UINT vt_fallcurve_object_shape_fit_set(VT_FALLCURVE_OBJECT* fc_object, VT_UINT shape_fit)
+{
+    if (shape_fit != VT_FC_SHAPE_FIT_PEARSON && shape_fit != VT_FC_SHAPE_FIT_LOG_LINEAR &&
+        shape_fit != VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT)
+    {
+        VTLogError("Fallcurve shape fit %d not supported \r\n", shape_fit);
+        return VT_ERROR;
+    }
+
+    fc_object->plan.shape_fit = shape_fit;
+
+    return VT_SUCCESS;
+}
+
+VT_VOID vt_fallcurve_object_shape_fit_fetch_status(VT_FALLCURVE_OBJECT* fc_object, VT_FALLCURVE_FIT* fit)
+{
+    *fit = fc_object->fit;
+}
+
+VT_UINT vt_fallcurve_object_rise_curve_enable(VT_FALLCURVE_OBJECT* fc_object, VT_UINT* rise_buffer, VT_UINT rise_buffer_length)
+{
+    if (rise_buffer != NULL && rise_buffer_length < VT_FC_RISE_CURVE_BUFFER_LENGTH)
+    {
+        VTLogError("FallCurve rise curve buffer must hold at least %d samples \r\n", VT_FC_RISE_CURVE_BUFFER_LENGTH);
+        return VT_ERROR;
+    }
+
+    fc_object->rise_buffer     = rise_buffer;
+    fc_object->plan.rise_curve = (rise_buffer != NULL);
+
+    return VT_SUCCESS;
 }
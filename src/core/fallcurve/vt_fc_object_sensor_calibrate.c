@@ -10,19 +10,22 @@ VT_UINT vt_fallcurve_object_sensor_calibrate(VT_FALLCURVE_OBJECT* fc_object, VT_
     VT_ULONG sampling_interval_us = 0;
     VT_ULONG falltime             = 0;
     VT_FLOAT pearson_coeff        = 0;
-
-    if (fc_signature_compute_collection_settings(fc_object, &sampling_interval_us, confidence_metric))
-    {
-        return VT_ERROR;
-    }
-
-    if (fc_signature_compute(fc_object, sampling_interval_us, &falltime, &pearson_coeff))
+    VT_ULONG risetime             = 0;
+    VT_FLOAT rise_pearson_coeff   = 0;
+
+    if (fc_signature_compute_collection_settings(fc_object,
+            &sampling_interval_us,
+            &falltime,
+            &pearson_coeff,
+            &risetime,
+            &rise_pearson_coeff,
+            confidence_metric))
     {
         return VT_ERROR;
     }
 
     fc_reset_db(fc_object);
-    if (fc_store_signature(fc_object, sampling_interval_us, falltime, pearson_coeff))
+    if (fc_store_signature(fc_object, sampling_interval_us, falltime, pearson_coeff, risetime, rise_pearson_coeff))
     {
         return VT_ERROR;
     }
@@ -35,21 +38,24 @@ VT_UINT vt_fallcurve_object_sensor_recalibrate(VT_FALLCURVE_OBJECT* fc_object, V
     VT_ULONG sampling_interval_us = 0;
     VT_ULONG falltime             = 0;
     VT_FLOAT pearson_coeff        = 0;
-
-    if (fc_signature_compute_collection_settings(fc_object, &sampling_interval_us, confidence_metric))
+    VT_ULONG risetime             = 0;
+    VT_FLOAT rise_pearson_coeff   = 0;
+
+    if (fc_signature_compute_collection_settings(fc_object,
+            &sampling_interval_us,
+            &falltime,
+            &pearson_coeff,
+            &risetime,
+            &rise_pearson_coeff,
+            confidence_metric))
     {
         return VT_ERROR;
     }
 
-    if (fc_signature_compute(fc_object, sampling_interval_us, &falltime, &pearson_coeff))
-    {
-        return VT_ERROR;
-    }
-
-    if (fc_store_signature(fc_object, sampling_interval_us, falltime, pearson_coeff))
+    if (fc_store_signature(fc_object, sampling_interval_us, falltime, pearson_coeff, risetime, rise_pearson_coeff))
     {
         return VT_ERROR;
     }
 
     return VT_SUCCESS;
-}
\ No newline at end of file
+}
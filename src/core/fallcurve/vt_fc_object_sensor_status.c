@@ -4,54 +4,101 @@
 #include "vt_debug.h"
 #include "vt_fc_api.h"
 #include "vt_fc_database.h"
+#include "vt_fc_read.h"
 #include "vt_fc_signature.h"
 
 VT_VOID vt_fallcurve_object_sensor_status(VT_FALLCURVE_OBJECT* fc_object, VT_UINT* sensor_status, VT_UINT* sensor_drift)
 {
-    VT_ULONG falltime                   = 0;
-    VT_FLOAT pearson_coeff              = 0;
-    VT_ULONG sampling_interval_us_saved = 0;
-    VT_ULONG falltime_saved             = 0;
-    VT_FLOAT pearson_coeff_saved        = 0;
+    VT_FALLCURVE_CAPTURE_SCRATCH* scratch = &(fc_object->scratch.capture);
+    FC_ADC_CAPTURE capture;
+    VT_UINT num_signatures = fc_fetch_sampling_intervals(fc_object, scratch->sampling_intervals_us, VT_FC_MAX_SIGNATURES);
 
-    VT_BOOL signature_compute_fail  = false;
-    VT_BOOL signature_evaluate_fail = false;
+    if (num_signatures)
+    {
+        // Every stored template is evaluated against the same discharge
+        capture.fc_object             = fc_object;
+        capture.raw_signatures        = scratch->raw_signatures;
+        capture.sampling_intervals_us = scratch->sampling_intervals_us;
+        capture.num_signatures        = num_signatures;
+        capture.sample_length         = fc_object->plan.sample_length;
+        capture.samples_read          = scratch->samples_read;
+        capture.rise_signatures       = fc_object->plan.rise_curve ? fc_object->rise_buffer : NULL;
+        capture.rise_samples_read     = scratch->rise_samples_read;
+        capture.sampling_stretch      = NULL;
+        capture.rise_sampling_stretch = NULL;
+        fc_adc_read(&capture, 1);
+    }
+
+    fc_signature_status_compute(fc_object,
+        scratch->raw_signatures,
+        scratch->samples_read,
+        fc_object->plan.rise_curve ? fc_object->rise_buffer : NULL,
+        scratch->rise_samples_read,
+        NULL,
+        NULL,
+        num_signatures,
+        sensor_status,
+        sensor_drift);
+}
+
+VT_UINT vt_fallcurve_object_sensor_status_batch(
+    VT_FALLCURVE_OBJECT** fc_objects, VT_UINT num_objects, VT_UINT* sensor_status, VT_UINT* sensor_drift)
+{
+    VT_FALLCURVE_CAPTURE_SCRATCH* scratch;
+    VT_UINT num_signatures[VT_FC_MAX_BATCH_SENSORS];
+    FC_ADC_CAPTURE captures[VT_FC_MAX_BATCH_SENSORS];
+    VT_UINT num_captures = 0;
 
-    for (VT_UINT iter = 0; iter < VT_FC_MAX_SIGNATURES; iter++)
+    if (num_objects == 0 || num_objects > VT_FC_MAX_BATCH_SENSORS)
     {
-        if (fc_fetch_signature(fc_object, iter, &sampling_interval_us_saved, &falltime_saved, &pearson_coeff_saved))
-        {
-            break;
-        }
-        if (fc_signature_compute(fc_object, sampling_interval_us_saved, &falltime, &pearson_coeff))
-        {
-            signature_compute_fail = true;
-            continue;
-        }
-        if (fc_signature_evaluate(falltime, falltime_saved, pearson_coeff, pearson_coeff_saved))
+        VTLogError("Fallcurve batch of %d sensors is not supported. \r\n", num_objects);
+        return VT_ERROR;
+    }
+
+    for (VT_UINT iter = 0; iter < num_objects; iter++)
+    {
+        scratch              = &(fc_objects[iter]->scratch.capture);
+        num_signatures[iter] =
+            fc_fetch_sampling_intervals(fc_objects[iter], scratch->sampling_intervals_us, VT_FC_MAX_SIGNATURES);
+        if (num_signatures[iter] == 0)
         {
-            signature_evaluate_fail = true;
             continue;
         }
-
-        *sensor_status = VT_SIGNATURE_MATCHING;
-        *sensor_drift  = 0;
-        return;
+        captures[num_captures].fc_object             = fc_objects[iter];
+        captures[num_captures].raw_signatures        = scratch->raw_signatures;
+        captures[num_captures].sampling_intervals_us = scratch->sampling_intervals_us;
+        captures[num_captures].num_signatures        = num_signatures[iter];
+        captures[num_captures].sample_length         = fc_objects[iter]->plan.sample_length;
+        captures[num_captures].samples_read          = scratch->samples_read;
+        captures[num_captures].rise_signatures       = fc_objects[iter]->plan.rise_curve ? fc_objects[iter]->rise_buffer : NULL;
+        captures[num_captures].rise_samples_read     = scratch->rise_samples_read;
+        captures[num_captures].sampling_stretch      = scratch->sampling_stretch;
+        captures[num_captures].rise_sampling_stretch = scratch->rise_sampling_stretch;
+        num_captures++;
     }
 
-    if (signature_evaluate_fail)
+    if (num_captures)
     {
-        *sensor_status = VT_SIGNATURE_NOT_MATCHING;
-        *sensor_drift  = 100;
+        // Sensors without templates are left powered, every other one shares a single discharge window
+        fc_adc_read(captures, num_captures);
     }
-    else if (signature_compute_fail)
-    {
-        *sensor_status = VT_SIGNATURE_COMPUTE_FAIL;
-        *sensor_drift  = 100;
-    }
-    else
+
+    for (VT_UINT iter = 0; iter < num_objects; iter++)
     {
-        *sensor_status = VT_SIGNATURE_DB_EMPTY;
-        *sensor_drift  = 100;
+        // Round-robin reads stretch the spacing of templates sampled faster than the other sensors allow, a sensor read
+        // alone is evaluated like one outside a batch
+        scratch = &(fc_objects[iter]->scratch.capture);
+        fc_signature_status_compute(fc_objects[iter],
+            scratch->raw_signatures,
+            scratch->samples_read,
+            fc_objects[iter]->plan.rise_curve ? fc_objects[iter]->rise_buffer : NULL,
+            scratch->rise_samples_read,
+            (num_captures > 1) ? scratch->sampling_stretch : NULL,
+            (num_captures > 1) ? scratch->rise_sampling_stretch : NULL,
+            num_signatures[iter],
+            &sensor_status[iter],
+            &sensor_drift[iter]);
     }
+
+    return VT_SUCCESS;
 }
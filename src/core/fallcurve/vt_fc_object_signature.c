@@ -0,0 +1,102 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include "vt_debug.h"
+#include "vt_fc_api.h"
+#include "vt_fc_database.h"
+#include "vt_fc_read.h"
+#include "vt_fc_signature.h"
+
+static VT_ULONG fc_dma_capture_sampling_interval(
+    VT_FALLCURVE_OBJECT* fc_object, VT_ULONG* sampling_intervals_us, VT_UINT num_signatures)
+{
+    VT_ULONG sampling_interval_min = sampling_intervals_us[0];
+    VT_ULONG sampling_interval_max = sampling_intervals_us[0];
+    VT_ULONG capture_time_required = 0;
+
+    for (VT_UINT iter = 1; iter < num_signatures; iter++)
+    {
+        if (sampling_intervals_us[iter] < sampling_interval_min)
+        {
+            sampling_interval_min = sampling_intervals_us[iter];
+        }
+        if (sampling_intervals_us[iter] > sampling_interval_max)
+        {
+            sampling_interval_max = sampling_intervals_us[iter];
+        }
+    }
+
+    // Sample at the finest template interval unless the buffer then runs out before the slowest template is covered
+    capture_time_required = sampling_interval_max * fc_object->plan.sample_length;
+    if ((sampling_interval_min * fc_object->dma_capture.buffer_length) < capture_time_required)
+    {
+        sampling_interval_min =
+            (capture_time_required + fc_object->dma_capture.buffer_length - 1) / fc_object->dma_capture.buffer_length;
+    }
+
+    return sampling_interval_min;
+}
+
+VT_UINT vt_fallcurve_object_dma_buffer_assign(VT_FALLCURVE_OBJECT* fc_object, VT_FLOAT* adc_read_buffer, VT_UINT buffer_length)
+{
+    if (adc_read_buffer == NULL || buffer_length < fc_object->plan.sample_length || fc_object->dma_capture.ongoing_collection)
+    {
+        VTLogError("FallCurve DMA buffer must hold at least %d samples \r\n", fc_object->plan.sample_length);
+        return VT_ERROR;
+    }
+
+    fc_object->dma_capture.adc_read_buffer     = adc_read_buffer;
+    fc_object->dma_capture.buffer_length       = buffer_length;
+    fc_object->dma_capture.collection_complete = false;
+
+    return VT_SUCCESS;
+}
+
+VT_UINT vt_fallcurve_object_signature_read(VT_FALLCURVE_OBJECT* fc_object)
+{
+    VT_ULONG sampling_intervals_us[VT_FC_MAX_SIGNATURES];
+    VT_UINT num_signatures = fc_fetch_sampling_intervals(fc_object, sampling_intervals_us, VT_FC_MAX_SIGNATURES);
+
+    if (num_signatures == 0)
+    {
+        return VT_ERROR;
+    }
+
+    return fc_adc_buffer_read_start(
+        fc_object, fc_dma_capture_sampling_interval(fc_object, sampling_intervals_us, num_signatures));
+}
+
+VT_UINT vt_fallcurve_object_signature_process(VT_FALLCURVE_OBJECT* fc_object, VT_UINT* sensor_status, VT_UINT* sensor_drift)
+{
+    VT_FALLCURVE_CAPTURE_SCRATCH* scratch = &(fc_object->scratch.capture);
+    VT_UINT num_signatures                = 0;
+
+    if (!fc_object->dma_capture.collection_complete)
+    {
+        return VT_ERROR;
+    }
+    fc_object->dma_capture.collection_complete = false;
+
+    num_signatures = fc_fetch_sampling_intervals(fc_object, scratch->sampling_intervals_us, VT_FC_MAX_SIGNATURES);
+    fc_adc_buffer_decimate(
+        fc_object, scratch->raw_signatures, scratch->sampling_intervals_us, num_signatures, fc_object->plan.sample_length);
+    for (VT_UINT iter = 0; iter < num_signatures; iter++)
+    {
+        // The DMA buffer is sampled in full, so every decimated signature spans sample_length
+        scratch->samples_read[iter] = fc_object->plan.sample_length;
+    }
+
+    // The DMA callback powers the sensor back up without sampling it, so only the fall curve is evaluated
+    fc_signature_status_compute(fc_object,
+        scratch->raw_signatures,
+        scratch->samples_read,
+        NULL,
+        NULL,
+        NULL,
+        NULL,
+        num_signatures,
+        sensor_status,
+        sensor_drift);
+
+    return VT_SUCCESS;
+}
@@ -0,0 +1,36 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include "vt_platform.h"
+
+static VT_VOID device_driver_hook_update(VT_DEVICE_DRIVER* device_driver, VT_UINT hook, VT_BOOL enable)
+{
+    if (device_driver->optional_hooks_key != VT_DEVICE_DRIVER_OPTIONAL_HOOKS_KEY)
+    {
+        device_driver->optional_hooks_key = VT_DEVICE_DRIVER_OPTIONAL_HOOKS_KEY;
+        device_driver->optional_hooks     = 0;
+    }
+
+    if (enable)
+    {
+        device_driver->optional_hooks |= hook;
+    }
+    else
+    {
+        device_driver->optional_hooks &= (VT_UINT)~hook;
+    }
+}
+
+VT_VOID vt_device_driver_storage_set(
+    VT_DEVICE_DRIVER* device_driver, VT_STORAGE_STORE_FUNC storage_store, VT_STORAGE_LOAD_FUNC storage_load)
+{
+    device_driver->storage_store = storage_store;
+    device_driver->storage_load  = storage_load;
+    device_driver_hook_update(device_driver, VT_DEVICE_DRIVER_HOOK_STORAGE, (storage_store != NULL && storage_load != NULL));
+}
+
+VT_BOOL vt_device_driver_hook_enabled(VT_DEVICE_DRIVER* device_driver, VT_UINT hook)
+{
+    return (device_driver->optional_hooks_key == VT_DEVICE_DRIVER_OPTIONAL_HOOKS_KEY) &&
+           ((device_driver->optional_hooks & hook) == hook);
+}
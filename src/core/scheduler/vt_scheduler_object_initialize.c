@@ -0,0 +1,29 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include "vt_debug.h"
+#include "vt_scheduler_api.h"
+
+VT_VOID vt_scheduler_initialize(VT_SCHEDULER* scheduler, VT_UINT max_checks_per_cycle, VT_ULONG max_downtime_us_per_cycle)
+{
+    scheduler->cycle                     = 0;
+    scheduler->max_checks_per_cycle      = max_checks_per_cycle;
+    scheduler->max_downtime_us_per_cycle = max_downtime_us_per_cycle;
+    scheduler->checks_spent              = 0;
+    scheduler->downtime_spent_us         = 0;
+}
+
+VT_VOID vt_scheduler_component_initialize(VT_SCHEDULER_COMPONENT* component, VT_ULONG downtime_us)
+{
+    for (VT_UINT iter = 0; iter < VT_SCHEDULER_HISTORY_LENGTH; iter++)
+    {
+        component->status_history[iter] = VT_SIGNATURE_EVAL_DEFAULT_VALUE;
+        component->drift_history[iter]  = VT_SIGNATURE_DRIFT_DEFAULT_VALUE;
+    }
+    component->history_head  = 0;
+    component->history_count = 0;
+    component->interval      = VT_SCHEDULER_MIN_INTERVAL;
+    component->next_check    = 0;
+    component->last_check    = 0;
+    component->downtime_us   = downtime_us;
+}
@@ -0,0 +1,129 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include "vt_debug.h"
+#include "vt_scheduler_api.h"
+
+static VT_UINT scheduler_history_index(VT_SCHEDULER_COMPONENT* component, VT_UINT age)
+{
+    return (component->history_head + VT_SCHEDULER_HISTORY_LENGTH - 1 - age) % VT_SCHEDULER_HISTORY_LENGTH;
+}
+
+static VT_BOOL scheduler_drift_trending_up(VT_SCHEDULER_COMPONENT* component)
+{
+    if (component->history_count < 2)
+    {
+        return false;
+    }
+    VT_UINT newest_drift = component->drift_history[scheduler_history_index(component, 0)];
+    VT_UINT oldest_drift = component->drift_history[scheduler_history_index(component, component->history_count - 1)];
+
+    return (newest_drift > oldest_drift + VT_SCHEDULER_DRIFT_TREND_RISE);
+}
+
+static VT_BOOL scheduler_stable(VT_SCHEDULER_COMPONENT* component)
+{
+    if (component->history_count < VT_SCHEDULER_STABLE_CHECKS)
+    {
+        return false;
+    }
+    for (VT_UINT age = 0; age < VT_SCHEDULER_STABLE_CHECKS; age++)
+    {
+        if (component->status_history[scheduler_history_index(component, age)] != VT_SIGNATURE_MATCHING)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+VT_VOID vt_scheduler_cycle_start(VT_SCHEDULER* scheduler)
+{
+    scheduler->cycle++;
+    scheduler->checks_spent      = 0;
+    scheduler->downtime_spent_us = 0;
+}
+
+VT_BOOL vt_scheduler_component_due(VT_SCHEDULER* scheduler, VT_SCHEDULER_COMPONENT* component)
+{
+    if (scheduler->cycle < component->next_check)
+    {
+        return false;
+    }
+
+    // Components deferred for too long skip the budget so one unstable sensor cannot starve the others
+    if ((scheduler->cycle - component->next_check) < VT_SCHEDULER_MAX_INTERVAL)
+    {
+        if (scheduler->max_checks_per_cycle && scheduler->checks_spent >= scheduler->max_checks_per_cycle)
+        {
+            return false;
+        }
+        if (scheduler->max_downtime_us_per_cycle && scheduler->checks_spent &&
+            (scheduler->downtime_spent_us + component->downtime_us) > scheduler->max_downtime_us_per_cycle)
+        {
+            return false;
+        }
+    }
+
+    scheduler->checks_spent++;
+    scheduler->downtime_spent_us += component->downtime_us;
+    return true;
+}
+
+VT_VOID vt_scheduler_component_record(VT_SCHEDULER* scheduler,
+    VT_SCHEDULER_COMPONENT* component,
+    VT_UINT sensor_status,
+    VT_UINT sensor_drift,
+    VT_ULONG downtime_us)
+{
+    component->status_history[component->history_head] = sensor_status;
+    component->drift_history[component->history_head]  = sensor_drift;
+    component->history_head                             = (component->history_head + 1) % VT_SCHEDULER_HISTORY_LENGTH;
+    if (component->history_count < VT_SCHEDULER_HISTORY_LENGTH)
+    {
+        component->history_count++;
+    }
+
+    if (sensor_status != VT_SIGNATURE_MATCHING)
+    {
+        component->interval = VT_SCHEDULER_MIN_INTERVAL;
+    }
+    else if (scheduler_drift_trending_up(component))
+    {
+        component->interval = (component->interval / 2 > VT_SCHEDULER_MIN_INTERVAL) ? (component->interval / 2)
+                                                                                    : VT_SCHEDULER_MIN_INTERVAL;
+    }
+    else if (scheduler_stable(component))
+    {
+        component->interval = (component->interval * 2 < VT_SCHEDULER_MAX_INTERVAL) ? (component->interval * 2)
+                                                                                    : VT_SCHEDULER_MAX_INTERVAL;
+    }
+    if (downtime_us)
+    {
+        component->downtime_us = downtime_us;
+    }
+    component->last_check = scheduler->cycle;
+    component->next_check = scheduler->cycle + component->interval;
+    VTLogDebug("Sensor status %d drift %d, next check in %lu cycles \r\n",
+        sensor_status,
+        sensor_drift,
+        (long unsigned int)component->interval);
+}
+
+VT_VOID vt_scheduler_component_fetch_schedule(
+    VT_SCHEDULER* scheduler, VT_SCHEDULER_COMPONENT* component, VT_SCHEDULER_SCHEDULE* schedule)
+{
+    schedule->interval           = component->interval;
+    schedule->cycles_until_check = (component->next_check > scheduler->cycle) ? (component->next_check - scheduler->cycle) : 0;
+    if (component->history_count == 0)
+    {
+        schedule->cycles_since_check = 0;
+        schedule->last_status        = VT_SIGNATURE_EVAL_DEFAULT_VALUE;
+        schedule->last_drift         = VT_SIGNATURE_DRIFT_DEFAULT_VALUE;
+        return;
+    }
+    schedule->cycles_since_check = scheduler->cycle - component->last_check;
+    schedule->last_status        = component->status_history[scheduler_history_index(component, 0)];
+    schedule->last_drift         = component->drift_history[scheduler_history_index(component, 0)];
+}
@@ -376,6 +376,23 @@ UINT nx_vt_init(NX_VERIFIED_TELEMETRY_DB* verified_telemetry_DB,
     verified_telemetry_DB->scratch_buffer        = scratch_buffer;
     verified_telemetry_DB->scratch_buffer_length = scratch_buffer_length;
 
+    /* Message properties and currentsense raw signatures use disjoint parts of the scratch buffer */
+    verified_telemetry_DB->message_properties_length = scratch_buffer_length;
+    if (verified_telemetry_DB->message_properties_length > NX_VT_MESSAGE_PROPERTIES_BUFFER_LENGTH)
+    {
+        verified_telemetry_DB->message_properties_length = NX_VT_MESSAGE_PROPERTIES_BUFFER_LENGTH;
+    }
+    vt_currentsense_buffer_pool_initialize(&(verified_telemetry_DB->currentsense_buffer_pool),
+        scratch_buffer + verified_telemetry_DB->message_properties_length,
+        scratch_buffer_length - verified_telemetry_DB->message_properties_length);
+
+    vt_scheduler_initialize(&(verified_telemetry_DB->fallcurve_scheduler),
+        VT_SCHEDULER_DEFAULT_MAX_CHECKS_PER_CYCLE,
+        VT_SCHEDULER_DEFAULT_MAX_DOWNTIME_US_PER_CYCLE);
+    vt_scheduler_initialize(&(verified_telemetry_DB->currentsense_scheduler),
+        VT_SCHEDULER_DEFAULT_MAX_CHECKS_PER_CYCLE,
+        VT_SCHEDULER_DEFAULT_MAX_DOWNTIME_US_PER_CYCLE);
+
     return NX_AZURE_IOT_SUCCESS;
 }
 
@@ -420,8 +437,7 @@ UINT nx_vt_signature_init(NX_VERIFIED_TELEMETRY_DB* verified_telemetry_DB,
             verified_telemetry_DB->device_driver,
             sensor_handle,
             associated_telemetry,
-            verified_telemetry_DB->scratch_buffer,
-            verified_telemetry_DB->scratch_buffer_length);
+            &(verified_telemetry_DB->currentsense_buffer_pool));
     }
     return NX_AZURE_IOT_SUCCESS;
 }
@@ -446,7 +462,7 @@ UINT nx_vt_verified_telemetry_message_create_send(NX_VERIFIED_TELEMETRY_DB* veri
     UINT bytes_copied = 0;
     CHAR vt_property_name[PROPERTY_NAME_MAX_LENGTH];
     memset(vt_property_name, 0, sizeof(vt_property_name));
-    memset(verified_telemetry_DB->scratch_buffer, 0, verified_telemetry_DB->scratch_buffer_length);
+    memset(verified_telemetry_DB->scratch_buffer, 0, verified_telemetry_DB->message_properties_length);
     UINT token_found                = 0;
     UCHAR* token_pointer            = NULL;
     UINT tokens                     = 0;
@@ -471,17 +487,17 @@ UINT nx_vt_verified_telemetry_message_create_send(NX_VERIFIED_TELEMETRY_DB* veri
                     if (tokens > 0)
                     {
                         str_buffer_space_available =
-                            verified_telemetry_DB->scratch_buffer_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
+                            verified_telemetry_DB->message_properties_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
                         strncat(verified_telemetry_DB->scratch_buffer, "&", str_buffer_space_available);
                     }
                     str_buffer_space_available =
-                        verified_telemetry_DB->scratch_buffer_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
+                        verified_telemetry_DB->message_properties_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
                     strncat(verified_telemetry_DB->scratch_buffer, vt_property_name, str_buffer_space_available);
                     str_buffer_space_available =
-                        verified_telemetry_DB->scratch_buffer_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
+                        verified_telemetry_DB->message_properties_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
                     strncat(verified_telemetry_DB->scratch_buffer, "=", str_buffer_space_available);
                     str_buffer_space_available =
-                        verified_telemetry_DB->scratch_buffer_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
+                        verified_telemetry_DB->message_properties_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
                     strncat(verified_telemetry_DB->scratch_buffer,
                         (((NX_VT_OBJECT*)component_pointer)->component.fc.telemetry_status > 0) ? "true" : "false",
                         str_buffer_space_available);
@@ -499,17 +515,17 @@ UINT nx_vt_verified_telemetry_message_create_send(NX_VERIFIED_TELEMETRY_DB* veri
                     if (tokens > 0)
                     {
                         str_buffer_space_available =
-                            verified_telemetry_DB->scratch_buffer_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
+                            verified_telemetry_DB->message_properties_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
                         strncat(verified_telemetry_DB->scratch_buffer, "&", str_buffer_space_available);
                     }
                     str_buffer_space_available =
-                        verified_telemetry_DB->scratch_buffer_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
+                        verified_telemetry_DB->message_properties_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
                     strncat(verified_telemetry_DB->scratch_buffer, vt_property_name, str_buffer_space_available);
                     str_buffer_space_available =
-                        verified_telemetry_DB->scratch_buffer_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
+                        verified_telemetry_DB->message_properties_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
                     strncat(verified_telemetry_DB->scratch_buffer, "=", str_buffer_space_available);
                     str_buffer_space_available =
-                        verified_telemetry_DB->scratch_buffer_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
+                        verified_telemetry_DB->message_properties_length - (strlen(verified_telemetry_DB->scratch_buffer) + 1);
                     strncat(verified_telemetry_DB->scratch_buffer,
                         (nx_vt_currentsense_fetch_telemetry_status(
                              &(((NX_VT_OBJECT*)component_pointer)->component.cs), enable_verified_telemetry) == true)
@@ -554,15 +570,34 @@ UINT nx_vt_compute_evaluate_fingerprint_all_sensors(NX_VERIFIED_TELEMETRY_DB* ve
     UINT components_num            = verified_telemetry_DB->components_num;
     void* component_pointer        = verified_telemetry_DB->first_component;
     bool enable_verified_telemetry = verified_telemetry_DB->enable_verified_telemetry;
+    NX_VT_FALLCURVE_COMPONENT* fc_handles[VT_FC_MAX_BATCH_SENSORS];
+    UINT fc_handles_num = 0;
+
+    /* Fallcurve sensors due this cycle are evaluated in batches that each share one discharge window */
+    vt_scheduler_cycle_start(&(verified_telemetry_DB->fallcurve_scheduler));
     for (iter = 0; iter < components_num; iter++)
     {
         if (((NX_VT_OBJECT*)component_pointer)->signature_type == VT_SIGNATURE_TYPE_FALLCURVE)
         {
-            status = status || nx_vt_fallcurve_compute_sensor_status_global(
-                                   &(((NX_VT_OBJECT*)component_pointer)->component.fc), enable_verified_telemetry);
+            fc_handles[fc_handles_num++] = &(((NX_VT_OBJECT*)component_pointer)->component.fc);
+            if (fc_handles_num == VT_FC_MAX_BATCH_SENSORS)
+            {
+                status = status || nx_vt_fallcurve_compute_sensor_status_global_batch(fc_handles,
+                                       fc_handles_num,
+                                       &(verified_telemetry_DB->fallcurve_scheduler),
+                                       enable_verified_telemetry);
+                fc_handles_num = 0;
+            }
         }
         component_pointer = (((NX_VT_OBJECT*)component_pointer)->next_component);
     }
+    if (fc_handles_num)
+    {
+        status = status || nx_vt_fallcurve_compute_sensor_status_global_batch(fc_handles,
+                               fc_handles_num,
+                               &(verified_telemetry_DB->fallcurve_scheduler),
+                               enable_verified_telemetry);
+    }
     return status;
 }
 
@@ -612,11 +647,14 @@ UINT nx_vt_signature_read(
         return (NX_AZURE_IOT_FAILURE);
     }
 
+    /* Every read starts a cycle of the currentsense scheduler, nx_vt_signature_process completes it */
+    vt_scheduler_cycle_start(&(verified_telemetry_DB->currentsense_scheduler));
     for (iter = 0; iter < components_num; iter++)
     {
         if (((NX_VT_OBJECT*)component_pointer)->signature_type == VT_SIGNATURE_TYPE_CURRENTSENSE)
         {
             status = status || nx_vt_currentsense_signature_read(&(((NX_VT_OBJECT*)component_pointer)->component.cs),
+                                   &(verified_telemetry_DB->currentsense_scheduler),
                                    associated_telemetry,
                                    associated_telemetry_length,
                                    enable_verified_telemetry);
@@ -645,6 +683,36 @@ UINT nx_vt_signature_process(
         if (((NX_VT_OBJECT*)component_pointer)->signature_type == VT_SIGNATURE_TYPE_CURRENTSENSE)
         {
             status = status || nx_vt_currentsense_signature_process(&(((NX_VT_OBJECT*)component_pointer)->component.cs),
+                                   &(verified_telemetry_DB->currentsense_scheduler),
+                                   associated_telemetry,
+                                   associated_telemetry_length,
+                                   enable_verified_telemetry);
+        }
+        component_pointer = (((NX_VT_OBJECT*)component_pointer)->next_component);
+    }
+    return status;
+}
+
+UINT nx_vt_signature_process_partial(
+    NX_VERIFIED_TELEMETRY_DB* verified_telemetry_DB, UCHAR* associated_telemetry, UINT associated_telemetry_length)
+{
+    UINT status                    = 0;
+    UINT iter                      = 0;
+    UINT components_num            = verified_telemetry_DB->components_num;
+    void* component_pointer        = verified_telemetry_DB->first_component;
+    bool enable_verified_telemetry = verified_telemetry_DB->enable_verified_telemetry;
+
+    if (!enable_verified_telemetry)
+    {
+        return (NX_AZURE_IOT_FAILURE);
+    }
+
+    for (iter = 0; iter < components_num; iter++)
+    {
+        if (((NX_VT_OBJECT*)component_pointer)->signature_type == VT_SIGNATURE_TYPE_CURRENTSENSE)
+        {
+            status = status || nx_vt_currentsense_signature_process_partial(
+                                   &(((NX_VT_OBJECT*)component_pointer)->component.cs),
                                    associated_telemetry,
                                    associated_telemetry_length,
                                    enable_verified_telemetry);
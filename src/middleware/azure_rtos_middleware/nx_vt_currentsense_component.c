@@ -36,8 +36,7 @@ UINT nx_vt_currentsense_init(NX_VT_CURRENTSENSE_COMPONENT* handle,
     VT_DEVICE_DRIVER* device_driver,
     VT_SENSOR_HANDLE* sensor_handle,
     UCHAR* associated_telemetry,
-    CHAR* shared_buffer,
-    UINT shared_buffer_size)
+    VT_CURRENTSENSE_BUFFER_POOL* buffer_pool)
 {
     UINT status;
     CHAR vt_component_name[50];
@@ -49,21 +48,46 @@ UINT nx_vt_currentsense_init(NX_VT_CURRENTSENSE_COMPONENT* handle,
     memset(vt_component_name, 0, sizeof(vt_component_name));
     snprintf(vt_component_name, sizeof(vt_component_name), "vT");
     strcat(vt_component_name, (CHAR*)component_name_ptr);
-    strncpy((CHAR*)handle->component_name_ptr, vt_component_name, sizeof(handle->component_name_ptr));
+    strncpy((CHAR*)handle->component_name_ptr, vt_component_name, sizeof(handle->component_name_ptr) - 1);
     handle->component_name_length = strlen(vt_component_name);
     strncpy((CHAR*)handle->associated_telemetry, (CHAR*)associated_telemetry, sizeof(handle->associated_telemetry));
-    handle->property_sent = 0;
+    handle->property_sent          = 0;
+    handle->signature_read_pending = false;
+    handle->partial_status_pending = false;
+    vt_scheduler_component_initialize(&(handle->scheduler_component), 0);
+    vt_changepoint_detector_initialize(&(handle->drift_detector));
 
-    status =
-        vt_currentsense_object_initialize(&(handle->cs_object), device_driver, sensor_handle, shared_buffer, shared_buffer_size);
+    status = vt_currentsense_object_initialize_from_pool(&(handle->cs_object), device_driver, sensor_handle, buffer_pool);
+
+    // Verify from the first telemetry message after boot if a template was persisted on the device
+    if (status == VT_SUCCESS &&
+        vt_currentsense_object_database_load(&(handle->cs_object), (VT_CHAR*)handle->component_name_ptr) == VT_SUCCESS)
+    {
+        VTLogInfo("Restored stored fingerprint template for component %s \r\n", (CHAR*)handle->component_name_ptr);
+    }
 
     return (status);
 }
 
+/* Telemetry status follows the detector, or the partial status of the read still running until it is processed */
+static VT_VOID telemetry_status_fetch(NX_VT_CURRENTSENSE_COMPONENT* handle, VT_UINT* sensor_status, VT_UINT* sensor_drift)
+{
+    if (handle->partial_status_pending)
+    {
+        *sensor_status = handle->partial_sensor_status;
+        *sensor_drift  = handle->partial_sensor_drift;
+        return;
+    }
+    vt_changepoint_detector_fetch_status(&(handle->drift_detector), sensor_status, sensor_drift);
+}
+
 /* reset fingerprint method implementation */
 static UINT reset_reference_currentsense(NX_VT_CURRENTSENSE_COMPONENT* handle)
 {
     vt_currentsense_object_sensor_calibrate(&(handle->cs_object));
+    vt_changepoint_detector_reset(&(handle->drift_detector));
+    handle->partial_status_pending = false;
+    vt_scheduler_component_initialize(&(handle->scheduler_component), handle->scheduler_component.downtime_us);
     return (NX_AZURE_IOT_SUCCESS);
 }
 
@@ -71,6 +95,9 @@ static UINT reset_reference_currentsense(NX_VT_CURRENTSENSE_COMPONENT* handle)
 static UINT retrain_reference_currentsense(NX_VT_CURRENTSENSE_COMPONENT* handle)
 {
     vt_currentsense_object_sensor_recalibrate(&(handle->cs_object));
+    vt_changepoint_detector_reset(&(handle->drift_detector));
+    handle->partial_status_pending = false;
+    vt_scheduler_component_initialize(&(handle->scheduler_component), handle->scheduler_component.downtime_us);
     return (NX_AZURE_IOT_SUCCESS);
 }
 
@@ -272,6 +299,10 @@ static UINT sync_fingerprint_template(NX_AZURE_IOT_JSON_READER* property_value_r
     strncpy((VT_CHAR*)flattened_db.repeating_signature_duty_cycle, jsonValue, sizeof(flattened_db.repeating_signature_duty_cycle));
 
     vt_currentsense_object_database_sync(&(handle->cs_object), &flattened_db);
+    vt_currentsense_object_database_store(&(handle->cs_object), (VT_CHAR*)handle->component_name_ptr);
+    vt_changepoint_detector_reset(&(handle->drift_detector));
+    handle->partial_status_pending = false;
+    vt_scheduler_component_initialize(&(handle->scheduler_component), handle->scheduler_component.downtime_us);
 
     return NX_SUCCESS;
 }
@@ -494,6 +525,7 @@ static UINT nx_vt_currentsense_fingerprint_template_associated_properties(
 
     if (db_required_to_store)
     {
+        vt_currentsense_object_database_store(&(handle->cs_object), (VT_CHAR*)handle->component_name_ptr);
         if ((status = nx_vt_currentsense_fingerprint_template_property(handle, iotpnp_client_ptr, &flattened_db)))
         {
             VTLogError("Failed to update fingerprint template reported property: error code = 0x%08x\r\n", status);
@@ -525,7 +557,7 @@ static UINT nx_vt_currentsense_telemetry_status_property(NX_VT_CURRENTSENSE_COMP
 
     if (toggle_verified_telemetry)
     {
-        vt_currentsense_object_sensor_fetch_status(&(handle->cs_object), &sensor_status, &sensor_drift);
+        telemetry_status_fetch(handle, &sensor_status, &sensor_drift);
         telemetry_status = (sensor_status > 0) ? false : true;
     }
 
@@ -756,6 +788,7 @@ UINT nx_vt_currentsense_process_reported_property_sync(NX_VT_CURRENTSENSE_COMPON
 }
 
 UINT nx_vt_currentsense_signature_read(NX_VT_CURRENTSENSE_COMPONENT* handle,
+    VT_SCHEDULER* scheduler,
     UCHAR* associated_telemetry,
     UINT associated_telemetry_length,
     bool toggle_verified_telemetry)
@@ -769,15 +802,31 @@ UINT nx_vt_currentsense_signature_read(NX_VT_CURRENTSENSE_COMPONENT* handle,
     {
         return (NX_NOT_SUCCESSFUL);
     }
-    vt_currentsense_object_signature_read(&(handle->cs_object));
+
+    /* Calibration needs every capture, evaluation only runs in the cycles the scheduler picks */
+    if (scheduler && handle->cs_object.mode == VT_MODE_RUNTIME_EVALUATE &&
+        !vt_scheduler_component_due(scheduler, &(handle->scheduler_component)))
+    {
+        return (NX_AZURE_IOT_SUCCESS);
+    }
+    if (vt_currentsense_object_signature_read(&(handle->cs_object)))
+    {
+        /* Retried next cycle, nothing is processed until a read starts */
+        return (NX_AZURE_IOT_SUCCESS);
+    }
+    handle->signature_read_pending = true;
     return (NX_AZURE_IOT_SUCCESS);
 }
 
 UINT nx_vt_currentsense_signature_process(NX_VT_CURRENTSENSE_COMPONENT* handle,
+    VT_SCHEDULER* scheduler,
     UCHAR* associated_telemetry,
     UINT associated_telemetry_length,
     bool toggle_verified_telemetry)
 {
+    VT_UINT sensor_status = 0;
+    VT_UINT sensor_drift  = 0;
+
     if (handle->associated_telemetry != associated_telemetry ||
         strncmp((CHAR*)handle->associated_telemetry, (CHAR*)associated_telemetry, associated_telemetry_length) != 0)
     {
@@ -787,7 +836,55 @@ UINT nx_vt_currentsense_signature_process(NX_VT_CURRENTSENSE_COMPONENT* handle,
     {
         return (NX_NOT_SUCCESSFUL);
     }
+
+    /* Skipped cycles keep the sensor status of the last check */
+    if (!handle->signature_read_pending)
+    {
+        return (NX_AZURE_IOT_SUCCESS);
+    }
+    handle->signature_read_pending = false;
+    handle->partial_status_pending = false;
     vt_currentsense_object_signature_process(&(handle->cs_object));
+
+    /* Calibration captures checked against the template held so far report a status as runtime checks do */
+    if (vt_currentsense_object_sensor_fetch_status_update(&(handle->cs_object), &sensor_status, &sensor_drift) == VT_SUCCESS)
+    {
+        vt_changepoint_detector_update(&(handle->drift_detector), sensor_status, sensor_drift);
+        if (scheduler)
+        {
+            vt_scheduler_component_record(scheduler, &(handle->scheduler_component), sensor_status, sensor_drift, 0);
+        }
+    }
+    return (NX_AZURE_IOT_SUCCESS);
+}
+
+UINT nx_vt_currentsense_signature_process_partial(NX_VT_CURRENTSENSE_COMPONENT* handle,
+    UCHAR* associated_telemetry,
+    UINT associated_telemetry_length,
+    bool toggle_verified_telemetry)
+{
+    if (handle->associated_telemetry != associated_telemetry ||
+        strncmp((CHAR*)handle->associated_telemetry, (CHAR*)associated_telemetry, associated_telemetry_length) != 0)
+    {
+        return (NX_NOT_SUCCESSFUL);
+    }
+    if (!toggle_verified_telemetry)
+    {
+        return (NX_NOT_SUCCESSFUL);
+    }
+    if (!handle->signature_read_pending)
+    {
+        return (NX_AZURE_IOT_SUCCESS);
+    }
+
+    /* A provisional template is reported with the next reported properties. A partial status is reported as telemetry
+       status right away, the detector and scheduler only record the full evaluation of nx_vt_currentsense_signature_process */
+    vt_currentsense_object_signature_process_partial(&(handle->cs_object));
+    if (vt_currentsense_object_sensor_fetch_status_update(
+            &(handle->cs_object), &(handle->partial_sensor_status), &(handle->partial_sensor_drift)) == VT_SUCCESS)
+    {
+        handle->partial_status_pending = true;
+    }
     return (NX_AZURE_IOT_SUCCESS);
 }
 
@@ -799,7 +896,7 @@ bool nx_vt_currentsense_fetch_telemetry_status(NX_VT_CURRENTSENSE_COMPONENT* han
 
     if (toggle_verified_telemetry)
     {
-        vt_currentsense_object_sensor_fetch_status(&(handle->cs_object), &sensor_status, &sensor_drift);
+        telemetry_status_fetch(handle, &sensor_status, &sensor_drift);
         telemetry_status = (sensor_status > 0) ? false : true;
     }
     return telemetry_status;
@@ -51,6 +51,10 @@ AzureIoTResult_t FreeRTOS_vt_init(FreeRTOS_VERIFIED_TELEMETRY_DB* verified_telem
 
     verified_telemetry_DB->device_driver = device_driver;
 
+    vt_scheduler_initialize(&(verified_telemetry_DB->fallcurve_scheduler),
+        VT_SCHEDULER_DEFAULT_MAX_CHECKS_PER_CYCLE,
+        VT_SCHEDULER_DEFAULT_MAX_DOWNTIME_US_PER_CYCLE);
+
     return eAzureIoTSuccess;
 }
 
@@ -385,17 +389,36 @@ AzureIoTResult_t FreeRTOS_vt_compute_evaluate_fingerprint_all_sensors(FreeRTOS_V
     UINT components_num            = verified_telemetry_DB->components_num;
     void* component_pointer        = verified_telemetry_DB->first_component;
     bool enable_verified_telemetry = verified_telemetry_DB->enable_verified_telemetry;
+    FreeRTOS_VT_FALLCURVE_COMPONENT* fc_handles[VT_FC_MAX_BATCH_SENSORS];
+    UINT fc_handles_num = 0;
+
+    /* Fallcurve sensors due this cycle are evaluated in batches that each share one discharge window */
+    vt_scheduler_cycle_start(&(verified_telemetry_DB->fallcurve_scheduler));
     for (iter = 0; iter < components_num; iter++)
     {
         if (((FreeRTOS_VT_OBJECT*)component_pointer)->signature_type == VT_SIGNATURE_TYPE_FALLCURVE)
         {
-
-            xResult = FreeRTOS_vt_fallcurve_compute_sensor_status_global(
-                &(((FreeRTOS_VT_OBJECT*)component_pointer)->component.fc), enable_verified_telemetry);
-            configASSERT(xResult == eAzureIoTSuccess);
+            fc_handles[fc_handles_num++] = &(((FreeRTOS_VT_OBJECT*)component_pointer)->component.fc);
+            if (fc_handles_num == VT_FC_MAX_BATCH_SENSORS)
+            {
+                xResult = FreeRTOS_vt_fallcurve_compute_sensor_status_global_batch(fc_handles,
+                    fc_handles_num,
+                    &(verified_telemetry_DB->fallcurve_scheduler),
+                    enable_verified_telemetry);
+                configASSERT(xResult == eAzureIoTSuccess);
+                fc_handles_num = 0;
+            }
         }
         component_pointer = (((FreeRTOS_VT_OBJECT*)component_pointer)->next_component);
     }
+    if (fc_handles_num)
+    {
+        xResult = FreeRTOS_vt_fallcurve_compute_sensor_status_global_batch(fc_handles,
+            fc_handles_num,
+            &(verified_telemetry_DB->fallcurve_scheduler),
+            enable_verified_telemetry);
+        configASSERT(xResult == eAzureIoTSuccess);
+    }
     return xResult;
 }
 
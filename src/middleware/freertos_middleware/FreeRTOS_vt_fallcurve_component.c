@@ -71,6 +71,14 @@ AzureIoTResult_t FreeRTOS_vt_fallcurve_init(FreeRTOS_VT_FALLCURVE_COMPONENT* han
 
     vt_fallcurve_object_initialize(&(handle->fc_object), device_driver, sensor_handle);
 
+    // Verify from the first telemetry message after boot if a template was persisted on the device
+    if (vt_fallcurve_object_database_load(&(handle->fc_object), (VT_CHAR*)handle->component_name_ptr) == VT_SUCCESS)
+    {
+        VTLogInfo("Restored stored fingerprint template for component %s \r\n", (CHAR*)handle->component_name_ptr);
+    }
+    vt_scheduler_component_initialize(&(handle->scheduler_component), 0);
+    vt_changepoint_detector_initialize(&(handle->drift_detector));
+
     return eAzureIoTSuccess;
 }
 
@@ -79,6 +87,8 @@ static AzureIoTResult_t reset_refernce_fallcurve(FreeRTOS_VT_FALLCURVE_COMPONENT
     uint8_t confidence_metric;
     AzureIoTResult_t status            = vt_fallcurve_object_sensor_calibrate(&(handle->fc_object), &confidence_metric);
     handle->template_confidence_metric = confidence_metric;
+    vt_changepoint_detector_reset(&(handle->drift_detector));
+    vt_scheduler_component_initialize(&(handle->scheduler_component), handle->scheduler_component.downtime_us);
     return (status);
 }
 
@@ -87,6 +97,8 @@ static AzureIoTResult_t retrain_refernce_fallcurve(FreeRTOS_VT_FALLCURVE_COMPONE
     uint8_t confidence_metric;
     AzureIoTResult_t status            = vt_fallcurve_object_sensor_recalibrate(&(handle->fc_object), &confidence_metric);
     handle->template_confidence_metric = confidence_metric;
+    vt_changepoint_detector_reset(&(handle->drift_detector));
+    vt_scheduler_component_initialize(&(handle->scheduler_component), handle->scheduler_component.downtime_us);
     return (status);
 }
 
@@ -98,6 +110,7 @@ static AzureIoTResult_t hub_store_all_db(FreeRTOS_VT_FALLCURVE_COMPONENT* handle
     int32_t lBytesWritten;
 
     vt_fallcurve_object_database_fetch(&(handle->fc_object), &flattened_db);
+    vt_fallcurve_object_database_store(&(handle->fc_object), (VT_CHAR*)handle->component_name_ptr);
 
     memset((void*)ucPropertyPayloadBuffer, 0, sizeof(ucPropertyPayloadBuffer));
 
@@ -407,6 +420,9 @@ static UINT sync_fingerprint_template(AzureIoTJSONReader_t* xReader, FreeRTOS_VT
     configASSERT(xResult == eAzureIoTSuccess);
 
     vt_fallcurve_object_database_sync(&(handle->fc_object), &flattened_db);
+    vt_fallcurve_object_database_store(&(handle->fc_object), (VT_CHAR*)handle->component_name_ptr);
+    vt_changepoint_detector_reset(&(handle->drift_detector));
+    vt_scheduler_component_initialize(&(handle->scheduler_component), handle->scheduler_component.downtime_us);
 
     return xResult;
 }
@@ -461,10 +477,76 @@ AzureIoTResult_t FreeRTOS_vt_fallcurve_compute_sensor_status_global(
     VT_UINT sensor_drift  = 100;
     printf("calling vt_fallcurve_object_sensor_status \n");
     vt_fallcurve_object_sensor_status(&(handle->fc_object), &sensor_status, &sensor_drift);
+    vt_changepoint_detector_update(&(handle->drift_detector), sensor_status, sensor_drift);
+    vt_changepoint_detector_fetch_status(&(handle->drift_detector), &sensor_status, &sensor_drift);
     handle->telemetry_status = (sensor_status > 0) ? false : true;
     return eAzureIoTSuccess;
 }
 
+AzureIoTResult_t FreeRTOS_vt_fallcurve_compute_sensor_status_global_batch(FreeRTOS_VT_FALLCURVE_COMPONENT** handles,
+    UINT num_handles,
+    VT_SCHEDULER* scheduler,
+    bool toggle_verified_telemetry)
+{
+    VT_FALLCURVE_OBJECT* fc_objects[VT_FC_MAX_BATCH_SENSORS];
+    FreeRTOS_VT_FALLCURVE_COMPONENT* batch_handles[VT_FC_MAX_BATCH_SENSORS];
+    VT_UINT sensor_status[VT_FC_MAX_BATCH_SENSORS];
+    VT_UINT sensor_drift[VT_FC_MAX_BATCH_SENSORS];
+    VT_ULONG capture_time_us = 0;
+    UINT num_objects         = 0;
+
+    if (num_handles > VT_FC_MAX_BATCH_SENSORS)
+    {
+        return eAzureIoTErrorFailed;
+    }
+
+    for (UINT iter = 0; iter < num_handles; iter++)
+    {
+        if (!toggle_verified_telemetry)
+        {
+            handles[iter]->telemetry_status = false;
+        }
+        else if (handles[iter]->telemetry_status_auto_update &&
+                 (scheduler == NULL || vt_scheduler_component_due(scheduler, &(handles[iter]->scheduler_component))))
+        {
+            fc_objects[num_objects]    = &(handles[iter]->fc_object);
+            batch_handles[num_objects] = handles[iter];
+            num_objects++;
+        }
+    }
+    if (num_objects == 0)
+    {
+        return eAzureIoTSuccess;
+    }
+
+    /* Compute fallcurve classification of every sensor from one discharge window, a lone sensor skips the batch bookkeeping */
+    if (num_objects == 1)
+    {
+        vt_fallcurve_object_sensor_status(fc_objects[0], &sensor_status[0], &sensor_drift[0]);
+    }
+    else if (vt_fallcurve_object_sensor_status_batch(fc_objects, num_objects, sensor_status, sensor_drift))
+    {
+        return eAzureIoTErrorFailed;
+    }
+    for (UINT iter = 0; iter < num_objects; iter++)
+    {
+        if (scheduler)
+        {
+            vt_fallcurve_object_capture_time_fetch_status(&(batch_handles[iter]->fc_object), &capture_time_us);
+            vt_scheduler_component_record(scheduler,
+                &(batch_handles[iter]->scheduler_component),
+                sensor_status[iter],
+                sensor_drift[iter],
+                capture_time_us);
+        }
+        vt_changepoint_detector_update(&(batch_handles[iter]->drift_detector), sensor_status[iter], sensor_drift[iter]);
+        vt_changepoint_detector_fetch_status(
+            &(batch_handles[iter]->drift_detector), &sensor_status[iter], &sensor_drift[iter]);
+        batch_handles[iter]->telemetry_status = (sensor_status[iter] > 0) ? false : true;
+    }
+    return eAzureIoTSuccess;
+}
+
 AzureIoTResult_t FreeRTOS_vt_fallcurve_process_command(FreeRTOS_VT_FALLCURVE_COMPONENT* handle,
     AzureIoTHubClient_t* xAzureIoTHubClient,
     UCHAR* component_name_ptr,
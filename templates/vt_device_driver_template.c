@@ -131,3 +131,18 @@ void vt_interrupt_disable()
 {
     /* Disable global interrupts */
 }
+
+/* Optional, both storage hooks are only called once enabled with vt_device_driver_storage_set() */
+uint16_t vt_storage_store(char* key, uint8_t* buffer, unsigned long size)
+{
+    /* Write the blob to non-volatile storage under key, replacing any previous blob */
+    /* Write to a spare location and switch over once complete so a power loss keeps the previous blob */
+    return 0;
+}
+
+uint16_t vt_storage_load(char* key, uint8_t* buffer, unsigned long buffer_size, unsigned long* size)
+{
+    /* Copy the blob stored under key into buffer and set size */
+    /* Return 1 if no blob is stored under key or it is larger than buffer_size */
+    return 1;
+}
@@ -0,0 +1,133 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+#include "test_vt_changepoint_definitions.h"
+
+#include "vt_changepoint_api.h"
+
+#include "cmocka.h"
+
+static VT_UINT updates_until_status(VT_CHANGEPOINT_DETECTOR* detector, VT_UINT sensor_status, VT_UINT sensor_drift)
+{
+    VT_UINT debounced_status;
+    VT_UINT debounced_drift;
+
+    for (VT_UINT iter = 1; iter <= 100; iter++)
+    {
+        vt_changepoint_detector_update(detector, sensor_status, sensor_drift);
+        vt_changepoint_detector_fetch_status(detector, &debounced_status, &debounced_drift);
+        if (debounced_status == sensor_status)
+        {
+            return iter;
+        }
+    }
+
+    return 0;
+}
+
+// vt_changepoint_detector_initialize() & vt_changepoint_detector_configure()
+static VT_VOID test_vt_changepoint_detector_configure(VT_VOID** state)
+{
+    VT_CHANGEPOINT_DETECTOR detector;
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
+
+    vt_changepoint_detector_initialize(&detector);
+    vt_changepoint_detector_fetch_status(&detector, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_EVAL_DEFAULT_VALUE);
+    assert_int_equal(sensor_drift, VT_SIGNATURE_DRIFT_DEFAULT_VALUE);
+
+    assert_int_equal(vt_changepoint_detector_configure(&detector, 0, 0.05f, 0.5f, 0.25f), VT_ERROR);
+    assert_int_equal(vt_changepoint_detector_configure(&detector, 0.001f, 0.5f, 0.05f, 0.25f), VT_ERROR);
+    assert_int_equal(vt_changepoint_detector_configure(&detector, 0.001f, 0.05f, 0.5f, 0), VT_ERROR);
+    assert_int_equal(vt_changepoint_detector_configure(&detector, 0.001f, 0.05f, 0.5f, 0.25f), VT_SUCCESS);
+}
+
+// vt_changepoint_detector_update() ignores a single failing check and flags a persistent change
+static VT_VOID test_vt_changepoint_detector_update(VT_VOID** state)
+{
+    VT_CHANGEPOINT_DETECTOR detector;
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
+    VT_UINT alarm_delay;
+
+    // Until the first decision every check is reported as is, the first one included
+    vt_changepoint_detector_initialize(&detector);
+    vt_changepoint_detector_update(&detector, VT_SIGNATURE_NOT_MATCHING, 100);
+    vt_changepoint_detector_fetch_status(&detector, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_NOT_MATCHING);
+    for (VT_UINT iter = 0; iter < 20 && !detector.decided; iter++)
+    {
+        vt_changepoint_detector_update(&detector, VT_SIGNATURE_MATCHING, 0);
+        vt_changepoint_detector_fetch_status(&detector, &sensor_status, &sensor_drift);
+        assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+    }
+    assert_true(detector.decided);
+
+    // Once decided a single failing check is ignored
+    for (VT_UINT iter = 0; iter < 20; iter++)
+    {
+        vt_changepoint_detector_update(&detector, (iter % 10 == 5) ? VT_SIGNATURE_NOT_MATCHING : VT_SIGNATURE_MATCHING, 0);
+        vt_changepoint_detector_fetch_status(&detector, &sensor_status, &sensor_drift);
+        assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+    }
+
+    // ln(1000) / ln(10) failures with the default rates, a bound met exactly still alarms
+    alarm_delay = updates_until_status(&detector, VT_SIGNATURE_NOT_MATCHING, 100);
+    assert_int_equal(alarm_delay, 3);
+    vt_changepoint_detector_fetch_status(&detector, &sensor_status, &sensor_drift);
+    assert_true(sensor_drift > 50);
+
+    // A stricter false alarm rate needs more evidence before flagging the change
+    vt_changepoint_detector_configure(&detector, 0.00001f, 0.05f, 0.5f, 0.25f);
+    assert_true(updates_until_status(&detector, VT_SIGNATURE_MATCHING, 0) == 1);
+    while (!detector.decided)
+    {
+        vt_changepoint_detector_update(&detector, VT_SIGNATURE_MATCHING, 0);
+    }
+    assert_true(updates_until_status(&detector, VT_SIGNATURE_NOT_MATCHING, 100) > alarm_delay);
+
+    // Recovery needs a run of matching checks as well
+    assert_true(updates_until_status(&detector, VT_SIGNATURE_MATCHING, 0) > 1);
+
+    vt_changepoint_detector_update(&detector, VT_SIGNATURE_DB_EMPTY, 100);
+    vt_changepoint_detector_fetch_status(&detector, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_DB_EMPTY);
+}
+
+// A sensor failing from the first check after a reset is never reported as matching
+static VT_VOID test_vt_changepoint_detector_failing_from_start(VT_VOID** state)
+{
+    VT_CHANGEPOINT_DETECTOR detector;
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
+
+    vt_changepoint_detector_initialize(&detector);
+    for (VT_UINT iter = 0; iter < 10; iter++)
+    {
+        vt_changepoint_detector_update(&detector, VT_SIGNATURE_NOT_MATCHING, 100);
+        vt_changepoint_detector_fetch_status(&detector, &sensor_status, &sensor_drift);
+        assert_int_equal(sensor_status, VT_SIGNATURE_NOT_MATCHING);
+    }
+    assert_true(detector.decided);
+
+    vt_changepoint_detector_reset(&detector);
+    vt_changepoint_detector_update(&detector, VT_SIGNATURE_COMPUTE_FAIL, 0);
+    vt_changepoint_detector_fetch_status(&detector, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_COMPUTE_FAIL);
+}
+
+VT_INT test_vt_changepoint_detector()
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_vt_changepoint_detector_configure),
+        cmocka_unit_test(test_vt_changepoint_detector_update),
+        cmocka_unit_test(test_vt_changepoint_detector_failing_from_start),
+    };
+
+    return cmocka_run_group_tests_name("test_vt_changepoint_detector", tests, NULL, NULL);
+}
@@ -0,0 +1,284 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "test_vt_codec_definitions.h"
+
+#include "vt_codec_api.h"
+
+#include "cmocka.h"
+
+// vt_codec_fallcurve_database_encode(), vt_codec_fallcurve_database_decode()
+static VT_VOID test_vt_codec_fallcurve_database(VT_VOID** state)
+{
+    VT_FALLCURVE_DATABASE database = {0};
+    VT_FALLCURVE_DATABASE decoded  = {0};
+    VT_FALLCURVE_OBJECT fc_object  = {0};
+    VT_CURRENTSENSE_DATABASE cs_database;
+    VT_UCHAR buffer[VT_CODEC_FALLCURVE_MAX_SIZE];
+    VT_ULONG encoded_size = 0;
+
+    database.num_signatures             = 2;
+    database.db[0].sampling_interval_us = 1;
+    database.db[0].falltime             = 4200;
+    database.db[0].pearson_coeff        = 62914.0f / 65536.0f;
+    database.db[1].sampling_interval_us = 60000;
+    database.db[1].falltime             = 3000000;
+    database.db[1].pearson_coeff        = 0.9123f;
+
+    /* Templates without a rise curve leave its fields out */
+    assert_int_equal(vt_codec_fallcurve_database_encode(&database, buffer, sizeof(buffer), &encoded_size), VT_SUCCESS);
+    assert_int_equal(encoded_size, VT_CODEC_HEADER_SIZE + 2 + (2 * 12) + VT_CODEC_CRC_SIZE);
+    assert_int_equal(buffer[0], VT_CODEC_VERSION);
+    assert_int_equal(buffer[1], VT_CODEC_KIND_FALLCURVE);
+    assert_int_equal(buffer[2], encoded_size - VT_CODEC_HEADER_SIZE - VT_CODEC_CRC_SIZE);
+    assert_int_equal(buffer[3], 0);
+
+    /* Little-endian falltime of the first signature */
+    assert_int_equal(buffer[VT_CODEC_HEADER_SIZE + 6], 4200 & 0xFF);
+    assert_int_equal(buffer[VT_CODEC_HEADER_SIZE + 7], 4200 >> 8);
+
+    assert_int_equal(vt_codec_fallcurve_database_decode(&decoded, buffer, encoded_size), VT_SUCCESS);
+    assert_int_equal(decoded.num_signatures, 2);
+    assert_int_equal(decoded.db[1].sampling_interval_us, 60000);
+    assert_int_equal(decoded.db[1].falltime, 3000000);
+
+    /* Q16 shape scores of the fixed point fit survive exactly */
+    assert_true(decoded.db[0].pearson_coeff == database.db[0].pearson_coeff);
+    assert_float_equal(decoded.db[1].pearson_coeff, 0.9123f, 0.0001f);
+    assert_int_equal(decoded.db[0].risetime, 0);
+
+    /* Rise curves are carried when present */
+    database.db[1].risetime           = 1500;
+    database.db[1].rise_pearson_coeff = 0.87f;
+    assert_int_equal(vt_codec_fallcurve_database_encode(&database, buffer, sizeof(buffer), &encoded_size), VT_SUCCESS);
+    assert_int_equal(encoded_size, VT_CODEC_HEADER_SIZE + 2 + (2 * 20) + VT_CODEC_CRC_SIZE);
+    assert_int_equal(vt_fallcurve_object_database_sync_binary(&fc_object, buffer, encoded_size), VT_SUCCESS);
+    assert_int_equal(fc_object.fingerprintdb.db[1].risetime, 1500);
+    assert_float_equal(fc_object.fingerprintdb.db[1].rise_pearson_coeff, 0.87f, 0.0001f);
+
+    /* Templates scored with another shape fit are rejected rather than evaluated with the fit in use */
+    database.shape_fit = VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT;
+    assert_int_equal(vt_codec_fallcurve_database_encode(&database, buffer, sizeof(buffer), &encoded_size), VT_SUCCESS);
+    assert_int_equal(vt_codec_fallcurve_database_decode(&decoded, buffer, encoded_size), VT_SUCCESS);
+    assert_int_equal(decoded.shape_fit, VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT);
+    database.db[1].falltime = 2000000;
+    assert_int_equal(vt_codec_fallcurve_database_encode(&database, buffer, sizeof(buffer), &encoded_size), VT_SUCCESS);
+    assert_int_equal(vt_fallcurve_object_database_sync_binary(&fc_object, buffer, encoded_size), VT_ERROR);
+    assert_int_equal(fc_object.fingerprintdb.db[1].falltime, 3000000);
+    fc_object.plan.shape_fit = VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT;
+    assert_int_equal(vt_fallcurve_object_database_sync_binary(&fc_object, buffer, encoded_size), VT_SUCCESS);
+    assert_int_equal(fc_object.fingerprintdb.db[1].falltime, 2000000);
+    database.shape_fit       = VT_FC_SHAPE_FIT_PEARSON;
+    database.db[1].falltime  = 3000000;
+    fc_object.plan.shape_fit = VT_FC_SHAPE_FIT_PEARSON;
+    assert_int_equal(vt_codec_fallcurve_database_encode(&database, buffer, sizeof(buffer), &encoded_size), VT_SUCCESS);
+    assert_int_equal(vt_fallcurve_object_database_sync_binary(&fc_object, buffer, encoded_size), VT_SUCCESS);
+
+    /* Corrupted, truncated, foreign and oversized encodings are rejected and leave the template alone */
+    buffer[VT_CODEC_HEADER_SIZE + 6] ^= 0x01;
+    assert_int_equal(vt_fallcurve_object_database_sync_binary(&fc_object, buffer, encoded_size), VT_ERROR);
+    buffer[VT_CODEC_HEADER_SIZE + 6] ^= 0x01;
+    assert_int_equal(vt_codec_fallcurve_database_decode(&decoded, buffer, encoded_size - 1), VT_ERROR);
+    assert_int_equal(vt_codec_currentsense_database_decode(&cs_database, buffer, encoded_size), VT_ERROR);
+    buffer[0] = VT_CODEC_VERSION + 1;
+    assert_int_equal(vt_codec_fallcurve_database_decode(&decoded, buffer, encoded_size), VT_ERROR);
+    assert_int_equal(fc_object.fingerprintdb.db[1].falltime, 3000000);
+
+    assert_int_equal(vt_codec_fallcurve_database_encode(&database, buffer, encoded_size - 1, &encoded_size), VT_ERROR);
+    database.db[0].pearson_coeff = 40000.0f;
+    assert_int_equal(vt_codec_fallcurve_database_encode(&database, buffer, sizeof(buffer), &encoded_size), VT_ERROR);
+}
+
+// vt_codec_currentsense_database_encode(), vt_codec_currentsense_database_decode()
+static VT_VOID test_vt_codec_currentsense_database(VT_VOID** state)
+{
+    VT_CURRENTSENSE_DATABASE database = {0};
+    VT_CURRENTSENSE_DATABASE decoded  = {0};
+    VT_CURRENTSENSE_OBJECT cs_object  = {0};
+    VT_UCHAR buffer[VT_CODEC_CURRENTSENSE_MAX_SIZE];
+    VT_ULONG encoded_size = 0;
+
+    database.template_type                                    = VT_CS_REPEATING_SIGNATURE;
+    database.template.repeating_signatures.num_signatures     = VT_CS_MAX_SIGNATURES;
+    database.template.repeating_signatures.offset_current     = VT_DATA_NOT_AVAILABLE;
+    database.template.repeating_signatures.lowest_sample_freq = 0.48f;
+    for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
+    {
+        database.template.repeating_signatures.signatures[iter].sampling_freq      = VT_CS_ADC_MAX_SAMPLING_FREQ / (iter + 1.0f);
+        database.template.repeating_signatures.signatures[iter].signature_freq     = 15.2224f * (iter + 1);
+        database.template.repeating_signatures.signatures[iter].relative_curr_draw = 2.5f;
+        database.template.repeating_signatures.signatures[iter].duty_cycle         = 0.33f;
+    }
+
+    /* A fraction of the string template it replaces */
+    assert_int_equal(vt_codec_currentsense_database_encode(&database, buffer, sizeof(buffer), &encoded_size), VT_SUCCESS);
+    assert_int_equal(encoded_size, VT_CODEC_CURRENTSENSE_MAX_SIZE);
+    assert_true(encoded_size * 2 < sizeof(VT_CURRENTSENSE_DATABASE_FLATTENED));
+
+    assert_int_equal(vt_codec_currentsense_database_decode(&decoded, buffer, encoded_size), VT_SUCCESS);
+    assert_int_equal(decoded.template_type, VT_CS_REPEATING_SIGNATURE);
+    assert_int_equal(decoded.template.repeating_signatures.num_signatures, VT_CS_MAX_SIGNATURES);
+    assert_float_equal(decoded.template.repeating_signatures.offset_current, VT_DATA_NOT_AVAILABLE, 0.0001f);
+    assert_float_equal(decoded.template.repeating_signatures.lowest_sample_freq, 0.48f, 0.0001f);
+    for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
+    {
+        assert_float_equal(decoded.template.repeating_signatures.signatures[iter].sampling_freq,
+            database.template.repeating_signatures.signatures[iter].sampling_freq,
+            0.0001f);
+        assert_float_equal(decoded.template.repeating_signatures.signatures[iter].signature_freq,
+            database.template.repeating_signatures.signatures[iter].signature_freq,
+            0.0001f);
+        assert_float_equal(decoded.template.repeating_signatures.signatures[iter].duty_cycle, 0.33f, 0.0001f);
+    }
+
+    /* Non-repeating templates hold the on and off currents only */
+    database.template_type                                 = VT_CS_NON_REPEATING_SIGNATURE;
+    database.template.non_repeating_signature.avg_curr_on  = 48.125f;
+    database.template.non_repeating_signature.avg_curr_off = 3.5f;
+    assert_int_equal(vt_codec_currentsense_database_encode(&database, buffer, sizeof(buffer), &encoded_size), VT_SUCCESS);
+    assert_int_equal(encoded_size, VT_CODEC_HEADER_SIZE + 1 + 8 + VT_CODEC_CRC_SIZE);
+
+    /* Syncing a binary template drops calibrated tolerances just like the string one */
+    cs_object.template_tolerance.avg_curr_drift = VT_CS_MIN_AVG_CURR_DRIFT;
+    cs_object.precheck.bounds.num_captures      = 3;
+    assert_int_equal(vt_currentsense_object_database_sync_binary(&cs_object, buffer, encoded_size), VT_SUCCESS);
+    assert_int_equal(cs_object.fingerprintdb.template_type, VT_CS_NON_REPEATING_SIGNATURE);
+    assert_float_equal(cs_object.fingerprintdb.template.non_repeating_signature.avg_curr_on, 48.125f, 0.0001f);
+    assert_float_equal(cs_object.template_tolerance.avg_curr_drift, VT_CS_MAX_AVG_CURR_DRIFT, 0.0001f);
+    assert_int_equal(cs_object.precheck.bounds.num_captures, 0);
+
+    buffer[encoded_size - 1] ^= 0x80;
+    assert_int_equal(vt_currentsense_object_database_sync_binary(&cs_object, buffer, encoded_size), VT_ERROR);
+    database.template_type = 0;
+    assert_int_equal(vt_codec_currentsense_database_encode(&database, buffer, sizeof(buffer), &encoded_size), VT_ERROR);
+}
+
+// vt_codec_base64_encode(), vt_codec_base64_decode()
+static VT_VOID test_vt_codec_base64(VT_VOID** state)
+{
+    VT_UCHAR data[]        = {'M', 'a', 'n', 0xFB, 0xFF};
+    VT_CHAR invalid_text[] = "TW=u";
+    VT_CHAR truncated_text[] = "TWF";
+    VT_CHAR text[VT_CODEC_BASE64_SIZE(sizeof(data))];
+    VT_UCHAR decoded[sizeof(data)];
+    VT_ULONG decoded_size = 0;
+
+    assert_int_equal(vt_codec_base64_encode(data, 3, text, sizeof(text)), VT_SUCCESS);
+    assert_string_equal(text, "TWFu");
+    assert_int_equal(vt_codec_base64_encode(data, 2, text, sizeof(text)), VT_SUCCESS);
+    assert_string_equal(text, "TWE=");
+    assert_int_equal(vt_codec_base64_encode(data, sizeof(data), text, sizeof(text)), VT_SUCCESS);
+    assert_string_equal(text, "TWFu+/8=");
+    assert_int_equal(vt_codec_base64_encode(data, sizeof(data), text, sizeof(text) - 1), VT_ERROR);
+
+    assert_int_equal(vt_codec_base64_decode(text, decoded, sizeof(decoded), &decoded_size), VT_SUCCESS);
+    assert_int_equal(decoded_size, sizeof(data));
+    assert_memory_equal(decoded, data, sizeof(data));
+    assert_int_equal(vt_codec_base64_decode(text, decoded, sizeof(decoded) - 1, &decoded_size), VT_ERROR);
+    assert_int_equal(vt_codec_base64_decode(invalid_text, decoded, sizeof(decoded), &decoded_size), VT_ERROR);
+    assert_int_equal(vt_codec_base64_decode(truncated_text, decoded, sizeof(decoded), &decoded_size), VT_ERROR);
+}
+
+// vt_codec_csv_append_fixed(), vt_codec_csv_append_unsigned(), vt_codec_csv_parse_float(), vt_codec_csv_parse_unsigned()
+static VT_VOID test_vt_codec_csv(VT_VOID** state)
+{
+    VT_CHAR text[32]         = "stale";
+    VT_CHAR short_text[8]    = {0};
+    VT_CHAR wide_text[48]    = {0};
+    VT_CHAR malformed_text[] = "1.5,abc,,2";
+    VT_CHAR unterminated[3]  = {'7', '2', '5'};
+    VT_ULONG text_length     = 0;
+    VT_ULONG position        = 0;
+    VT_ULONG unsigned_value  = 0;
+    VT_FLOAT float_value     = 0;
+
+    assert_int_equal(vt_codec_csv_append_unsigned(text, sizeof(text), &text_length, 7, 3), VT_SUCCESS);
+    assert_int_equal(vt_codec_csv_append_fixed(text, sizeof(text), &text_length, -0.5f, 4), VT_SUCCESS);
+    assert_int_equal(vt_codec_csv_append_fixed(text, sizeof(text), &text_length, 12.34567f, 4), VT_SUCCESS);
+    assert_int_equal(vt_codec_csv_append_fixed(text, sizeof(text), &text_length, -0.00001f, 4), VT_SUCCESS);
+    assert_string_equal(text, "007,-0.5000,12.3457,0.0000");
+    assert_int_equal(text_length, strlen(text));
+
+    // A field that does not fit leaves the text as it was
+    text_length = 0;
+    assert_int_equal(vt_codec_csv_append_fixed(short_text, sizeof(short_text), &text_length, 1.25f, 2), VT_SUCCESS);
+    assert_int_equal(vt_codec_csv_append_fixed(short_text, sizeof(short_text), &text_length, 1.25f, 2), VT_ERROR);
+    assert_string_equal(short_text, "1.25");
+    assert_int_equal(text_length, 4);
+    assert_int_equal(vt_codec_csv_append_fixed(short_text, sizeof(short_text), &text_length, 1e20f, 2), VT_ERROR);
+    assert_string_equal(short_text, "1.25");
+
+    // Values that fit the text but not VT_UINT64 once scaled to their decimals are rejected, not wrapped
+    text_length = 0;
+    assert_int_equal(vt_codec_csv_append_fixed(wide_text, sizeof(wide_text), &text_length, 1e12f, 9), VT_ERROR);
+    assert_string_equal(wide_text, "");
+    assert_int_equal(vt_codec_csv_append_fixed(wide_text, sizeof(wide_text), &text_length, 1e9f, 9), VT_SUCCESS);
+    assert_string_equal(wide_text, "1000000000.000000000");
+
+    assert_int_equal(vt_codec_csv_parse_unsigned(text, sizeof(text), &position, &unsigned_value), VT_SUCCESS);
+    assert_int_equal(unsigned_value, 7);
+    assert_int_equal(vt_codec_csv_parse_unsigned(text, sizeof(text), &position, &unsigned_value), VT_ERROR);
+    assert_int_equal(vt_codec_csv_parse_float(text, sizeof(text), &position, &float_value), VT_SUCCESS);
+    assert_float_equal(float_value, -0.5f, 1e-6f);
+    assert_int_equal(vt_codec_csv_parse_float(text, sizeof(text), &position, &float_value), VT_SUCCESS);
+    assert_float_equal(float_value, 12.3457f, 1e-6f);
+    assert_int_equal(vt_codec_csv_parse_float(text, sizeof(text), &position, &float_value), VT_SUCCESS);
+    assert_float_equal(float_value, 0.0f, 1e-6f);
+    assert_int_equal(vt_codec_csv_parse_float(text, sizeof(text), &position, &float_value), VT_ERROR);
+    assert_string_equal(text, "007,-0.5000,12.3457,0.0000");
+
+    position = 0;
+    assert_int_equal(vt_codec_csv_parse_float(malformed_text, sizeof(malformed_text), &position, &float_value), VT_SUCCESS);
+    assert_int_equal(vt_codec_csv_parse_float(malformed_text, sizeof(malformed_text), &position, &float_value), VT_ERROR);
+    assert_int_equal(position, 4);
+
+    // Parsing stops at the buffer size even without a null terminator
+    position = 0;
+    assert_int_equal(vt_codec_csv_parse_unsigned(unterminated, 2, &position, &unsigned_value), VT_SUCCESS);
+    assert_int_equal(unsigned_value, 72);
+    assert_int_equal(vt_codec_csv_parse_unsigned(unterminated, 2, &position, &unsigned_value), VT_ERROR);
+}
+
+// Round trip of a large list, each value is formatted and parsed exactly once
+static VT_VOID test_vt_codec_csv_round_trip(VT_VOID** state)
+{
+    static VT_CHAR text[TEST_VT_CODEC_CSV_VALUES * 16];
+    VT_ULONG text_length = 0;
+    VT_ULONG position    = 0;
+    VT_FLOAT value       = 0;
+    VT_FLOAT expected    = 0;
+
+    for (VT_UINT iter = 0; iter < TEST_VT_CODEC_CSV_VALUES; iter++)
+    {
+        expected = ((VT_FLOAT)iter * 1.37f) - 2000.0f;
+        assert_int_equal(
+            vt_codec_csv_append_fixed(text, sizeof(text), &text_length, expected, VT_CODEC_CSV_DECIMALS), VT_SUCCESS);
+    }
+
+    for (VT_UINT iter = 0; iter < TEST_VT_CODEC_CSV_VALUES; iter++)
+    {
+        expected = ((VT_FLOAT)iter * 1.37f) - 2000.0f;
+        assert_int_equal(vt_codec_csv_parse_float(text, text_length, &position, &value), VT_SUCCESS);
+        assert_float_equal(value, expected, 1e-3f);
+    }
+    assert_int_equal(position, text_length);
+    assert_int_equal(vt_codec_csv_parse_float(text, text_length, &position, &value), VT_ERROR);
+}
+
+VT_INT test_vt_codec()
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_vt_codec_fallcurve_database),
+        cmocka_unit_test(test_vt_codec_currentsense_database),
+        cmocka_unit_test(test_vt_codec_base64),
+        cmocka_unit_test(test_vt_codec_csv),
+        cmocka_unit_test(test_vt_codec_csv_round_trip),
+    };
+
+    return cmocka_run_group_tests_name("test_vt_codec", tests, NULL, NULL);
+}
@@ -0,0 +1,13 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#ifndef _TEST_VT_CODEC_DEFINITIONS_H
+#define _TEST_VT_CODEC_DEFINITIONS_H
+
+#include "vt_defs.h"
+
+#define TEST_VT_CODEC_CSV_VALUES 4000
+
+VT_INT test_vt_codec();
+
+#endif
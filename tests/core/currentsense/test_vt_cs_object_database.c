@@ -8,8 +8,10 @@
 
 #include "test_vt_cs_definitions.h"
 
+#include "vt_codec_api.h"
 #include "vt_cs_api.h"
 #include "vt_cs_config.h"
+#include "vt_storage_file.h"
 
 #include "cmocka.h"
 
@@ -19,12 +21,24 @@
 #define TEST_LOWEST_SAMPLE_FREQ_VALUE 12.58f
 #define TEST_OFFSET_CURRENT_VALUE     11.00f
 #define TEST_FLOAT_EPSILON            0.1f
+#define TEST_AVG_CURR_DRIFT_VALUE     4.25f
+#define TEST_MEAN_MIN_VALUE           12.5f
+#define TEST_MEAN_MAX_VALUE           30.75f
+#define TEST_STORAGE_KEY              "vTtestCurrentsenseStorage"
 
 static VT_FLOAT test_duty_cycle_values[VT_CS_MAX_SIGNATURES]         = {0.2794f, 0.9518f, 0.3319f, 0.8680f, 0.6204f};
 static VT_FLOAT test_relative_curr_draw_values[VT_CS_MAX_SIGNATURES] = {32.54f, 23.42f, 43.52f, 54.64f, 35.47f};
 static VT_FLOAT test_sampling_freq_values[VT_CS_MAX_SIGNATURES]      = {5000.0f, 12.80f, 15.34f, 78.34f, 0.13f};
 static VT_FLOAT test_signature_freq_values[VT_CS_MAX_SIGNATURES]     = {333.4f, 24.32f, 65.97f, 56.23f, 0.456f};
 
+static VT_UINT test_storage_writes = 0;
+
+static VT_UINT test_storage_store_counted(VT_CHAR* key, VT_UCHAR* buffer, VT_ULONG size)
+{
+    test_storage_writes++;
+    return vt_storage_file_store(key, buffer, size);
+}
+
 // vt_currentsense_object_database_fetch() & vt_currentsense_object_database_sync()
 static VT_VOID test_vt_currentsense_object_database_fetch_sync(VT_VOID** state)
 {
@@ -86,6 +100,27 @@ static VT_VOID test_vt_currentsense_object_database_fetch_sync(VT_VOID** state)
             TEST_FLOAT_EPSILON);
     }
 
+    /* A template reported after adapting keeps the baseline it drifted from, one calibrated elsewhere replaces it */
+    cs_object.adaptation.baseline                                                 = cs_object.fingerprintdb;
+    cs_object.adaptation.num_updates                                              = 3;
+    cs_object.fingerprintdb.template.repeating_signatures.signatures[0].duty_cycle = test_duty_cycle_values[0] * 1.1f;
+    vt_currentsense_object_database_fetch(&cs_object, &flattened_db, &db_updated_flag, &template_confidence_metric);
+    vt_currentsense_object_database_sync(&cs_object, &flattened_db);
+    assert_int_equal(cs_object.adaptation.num_updates, 3);
+    assert_true(cs_object.adaptation.cumulative_drift > 0);
+    assert_float_equal(cs_object.adaptation.baseline.template.repeating_signatures.signatures[0].duty_cycle,
+        test_duty_cycle_values[0],
+        TEST_FLOAT_EPSILON);
+
+    cs_object.fingerprintdb.template.repeating_signatures.signatures[0].sampling_freq = test_sampling_freq_values[0] * 2;
+    vt_currentsense_object_database_fetch(&cs_object, &flattened_db, &db_updated_flag, &template_confidence_metric);
+    vt_currentsense_object_database_sync(&cs_object, &flattened_db);
+    assert_int_equal(cs_object.adaptation.num_updates, 0);
+    assert_float_equal(cs_object.adaptation.cumulative_drift, 0, TEST_FLOAT_EPSILON);
+    assert_float_equal(cs_object.adaptation.baseline.template.repeating_signatures.signatures[0].sampling_freq,
+        test_sampling_freq_values[0] * 2,
+        TEST_FLOAT_EPSILON);
+
     cs_object.fingerprintdb.template_type                                 = VT_CS_NON_REPEATING_SIGNATURE;
     cs_object.fingerprintdb.template.non_repeating_signature.avg_curr_off = TEST_AVG_CURR_OFF_VALUE;
     cs_object.fingerprintdb.template.non_repeating_signature.avg_curr_on  = TEST_AVG_CURR_ON_VALUE;
@@ -105,10 +140,86 @@ static VT_VOID test_vt_currentsense_object_database_fetch_sync(VT_VOID** state)
         cs_object.fingerprintdb.template.non_repeating_signature.avg_curr_on, TEST_AVG_CURR_ON_VALUE, TEST_FLOAT_EPSILON);
 }
 
+// vt_currentsense_object_database_store() & vt_currentsense_object_database_load()
+static VT_VOID test_vt_currentsense_object_database_store_load(VT_VOID** state)
+{
+    VT_DEVICE_DRIVER device_driver            = {0};
+    VT_CURRENTSENSE_OBJECT cs_object          = {0};
+    VT_CURRENTSENSE_OBJECT cs_object_rebooted = {0};
+    VT_CURRENTSENSE_OBJECT cs_object_legacy   = {0};
+    VT_UCHAR corrupted_blob[]                 = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+    VT_UCHAR template_blob[VT_CODEC_CURRENTSENSE_MAX_SIZE];
+    VT_ULONG template_size = 0;
+
+    cs_object.device_driver          = &device_driver;
+    cs_object_rebooted.device_driver = &device_driver;
+    cs_object_legacy.device_driver   = &device_driver;
+
+    cs_object.fingerprintdb.template_type                                 = VT_CS_NON_REPEATING_SIGNATURE;
+    cs_object.fingerprintdb.template.non_repeating_signature.avg_curr_off = TEST_AVG_CURR_OFF_VALUE;
+    cs_object.fingerprintdb.template.non_repeating_signature.avg_curr_on  = TEST_AVG_CURR_ON_VALUE;
+    cs_object.adaptation.baseline                                         = cs_object.fingerprintdb;
+    cs_object.template_tolerance.avg_curr_drift                           = TEST_AVG_CURR_DRIFT_VALUE;
+    cs_object.precheck.bounds.num_captures                                = 2;
+    cs_object.precheck.bounds.mean_min                                    = TEST_MEAN_MIN_VALUE;
+    cs_object.precheck.bounds.mean_max                                    = TEST_MEAN_MAX_VALUE;
+
+    // Devices without persistent storage never enable the hooks, whatever their pointers hold
+    assert_int_equal(vt_currentsense_object_database_store(&cs_object, TEST_STORAGE_KEY), VT_ERROR);
+    assert_int_equal(vt_currentsense_object_database_load(&cs_object_rebooted, TEST_STORAGE_KEY), VT_ERROR);
+    device_driver.storage_store = &test_storage_store_counted;
+    device_driver.storage_load  = &vt_storage_file_load;
+    assert_int_equal(vt_currentsense_object_database_store(&cs_object, TEST_STORAGE_KEY), VT_ERROR);
+    assert_int_equal(test_storage_writes, 0);
+
+    vt_device_driver_storage_set(&device_driver, &test_storage_store_counted, &vt_storage_file_load);
+    vt_storage_file_erase(TEST_STORAGE_KEY);
+    assert_int_equal(vt_currentsense_object_database_load(&cs_object_rebooted, TEST_STORAGE_KEY), VT_ERROR);
+
+    assert_int_equal(vt_currentsense_object_database_store(&cs_object, TEST_STORAGE_KEY), VT_SUCCESS);
+    assert_int_equal(test_storage_writes, 1);
+    assert_int_equal(vt_currentsense_object_database_load(&cs_object_rebooted, TEST_STORAGE_KEY), VT_SUCCESS);
+    assert_int_equal(cs_object_rebooted.fingerprintdb.template_type, VT_CS_NON_REPEATING_SIGNATURE);
+    assert_float_equal(
+        cs_object_rebooted.fingerprintdb.template.non_repeating_signature.avg_curr_off, TEST_AVG_CURR_OFF_VALUE, 1e-4f);
+    assert_float_equal(
+        cs_object_rebooted.fingerprintdb.template.non_repeating_signature.avg_curr_on, TEST_AVG_CURR_ON_VALUE, 1e-4f);
+
+    // Calibration learnt before the reboot comes back with the template
+    assert_float_equal(cs_object_rebooted.template_tolerance.avg_curr_drift, TEST_AVG_CURR_DRIFT_VALUE, 1e-4f);
+    assert_int_equal(cs_object_rebooted.precheck.bounds.num_captures, 2);
+    assert_float_equal(cs_object_rebooted.precheck.bounds.mean_min, TEST_MEAN_MIN_VALUE, 1e-4f);
+    assert_float_equal(cs_object_rebooted.precheck.bounds.mean_max, TEST_MEAN_MAX_VALUE, 1e-4f);
+    assert_float_equal(
+        cs_object_rebooted.adaptation.baseline.template.non_repeating_signature.avg_curr_on, TEST_AVG_CURR_ON_VALUE, 1e-4f);
+
+    // Storing the unchanged template again leaves the flash alone
+    assert_int_equal(vt_currentsense_object_database_store(&cs_object_rebooted, TEST_STORAGE_KEY), VT_SUCCESS);
+    assert_int_equal(test_storage_writes, 1);
+
+    // A corrupted blob is rejected and the restored template kept
+    assert_int_equal(vt_storage_file_store(TEST_STORAGE_KEY, corrupted_blob, sizeof(corrupted_blob)), VT_SUCCESS);
+    assert_int_equal(vt_currentsense_object_database_load(&cs_object_rebooted, TEST_STORAGE_KEY), VT_ERROR);
+    assert_int_equal(cs_object_rebooted.fingerprintdb.template_type, VT_CS_NON_REPEATING_SIGNATURE);
+
+    // A blob holding the template alone still loads, with the configured tolerances and no pre-check bounds
+    assert_int_equal(vt_codec_currentsense_database_encode(
+                         &(cs_object.fingerprintdb), template_blob, sizeof(template_blob), &template_size),
+        VT_SUCCESS);
+    assert_int_equal(vt_storage_file_store(TEST_STORAGE_KEY, template_blob, template_size), VT_SUCCESS);
+    assert_int_equal(vt_currentsense_object_database_load(&cs_object_legacy, TEST_STORAGE_KEY), VT_SUCCESS);
+    assert_int_equal(cs_object_legacy.fingerprintdb.template_type, VT_CS_NON_REPEATING_SIGNATURE);
+    assert_float_equal(cs_object_legacy.template_tolerance.avg_curr_drift, VT_CS_MAX_AVG_CURR_DRIFT, 1e-4f);
+    assert_int_equal(cs_object_legacy.precheck.bounds.num_captures, 0);
+
+    assert_int_equal(vt_storage_file_erase(TEST_STORAGE_KEY), VT_SUCCESS);
+}
+
 VT_INT test_vt_cs_object_database()
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_vt_currentsense_object_database_fetch_sync),
+        cmocka_unit_test(test_vt_currentsense_object_database_store_load),
     };
 
     return cmocka_run_group_tests_name("test_vt_cs_object_database", tests, NULL, NULL);
@@ -18,8 +18,9 @@ static VT_VOID test_vt_currentsense_object_initialize(VT_VOID** state)
     VT_CURRENTSENSE_OBJECT cs_object;
     VT_DEVICE_DRIVER device_driver;
     VT_SENSOR_HANDLE sensor_handle;
-    static VT_CHAR scratch_buffer_1[sizeof(VT_CURRENTSENSE_RAW_SIGNATURES_READER) - 1];
-    static VT_CHAR scratch_buffer_2[sizeof(VT_CURRENTSENSE_RAW_SIGNATURES_READER)];
+    static VT_CHAR scratch_buffer_1[VT_CS_RAW_SIGNATURES_BUFFER_SIZE(0) - 1];
+    static VT_CHAR scratch_buffer_2[VT_CS_RAW_SIGNATURES_BUFFER_SIZE(0)];
+    static VT_CHAR scratch_buffer_3[VT_CS_RAW_SIGNATURES_BUFFER_MAX_SIZE];
 
     assert_int_equal(
         vt_currentsense_object_initialize(&cs_object, &device_driver, &sensor_handle, scratch_buffer_1, sizeof(scratch_buffer_1)),
@@ -30,12 +31,126 @@ static VT_VOID test_vt_currentsense_object_initialize(VT_VOID** state)
     assert_int_equal(cs_object.fingerprintdb.template_type, VT_CS_REPEATING_SIGNATURE);
     assert_int_equal(cs_object.fingerprintdb.template.repeating_signatures.num_signatures, 0);
     assert_int_equal(cs_object.raw_signatures_reader_initialized, true);
+    assert_int_equal(cs_object.raw_signatures_reader->repeating_raw_signatures_capacity, 0);
+    assert_null(cs_object.buffer_pool);
+    assert_int_equal(cs_object.calibration.num_captures_required, 1);
+    assert_int_equal(cs_object.calibration.num_captures, 0);
+    assert_float_equal(cs_object.template_tolerance.avg_curr_drift, VT_CS_MAX_AVG_CURR_DRIFT, 0.0001f);
+    assert_int_equal(cs_object.adaptation.enabled, false);
+    assert_int_equal(cs_object.adaptation.num_updates, 0);
+    assert_int_equal(cs_object.precheck.enabled, true);
+    assert_int_equal(cs_object.precheck.bounds.num_captures, 0);
+    assert_int_equal(cs_object.precheck.num_full, 0);
+
+    assert_int_equal(
+        vt_currentsense_object_initialize(&cs_object, &device_driver, &sensor_handle, scratch_buffer_3, sizeof(scratch_buffer_3)),
+        VT_SUCCESS);
+    assert_int_equal(cs_object.raw_signatures_reader->repeating_raw_signatures_capacity, VT_CS_MAX_SIGNATURES);
+    assert_int_equal(cs_object.plan.sample_length, VT_CS_SAMPLE_LENGTH);
+    assert_int_equal(cs_object.plan.auto_correlation_lag, VT_CS_AUTO_CORRELATION_LAG);
+    assert_int_equal(cs_object.plan.num_calibration_ranges, 3);
+    assert_float_equal(cs_object.plan.calibration_ranges[0].sampling_freq, VT_CS_ADC_MAX_SAMPLING_FREQ, 0.001f);
+    assert_float_equal(
+        cs_object.plan.calibration_ranges[0].bin_width, VT_CS_ADC_MAX_SAMPLING_FREQ / (VT_FLOAT)VT_CS_SAMPLE_LENGTH, 0.001f);
+    assert_float_equal(cs_object.plan.calibration_ranges[2].sampling_freq, VT_CS_FMIN * VT_CS_SAMPLE_LENGTH, 0.001f);
+    vt_currentsense_object_plan_dump(&cs_object);
+
+    assert_int_equal(
+        vt_currentsense_object_plan_create(&cs_object, VT_CS_SAMPLE_LENGTH * 2, VT_CS_AUTO_CORRELATION_LAG), VT_ERROR);
+    assert_int_equal(
+        vt_currentsense_object_plan_create(&cs_object, VT_CS_SAMPLE_LENGTH - 1, VT_CS_AUTO_CORRELATION_LAG), VT_ERROR);
+    assert_int_equal(vt_currentsense_object_plan_create(&cs_object, VT_CS_MIN_SAMPLE_LENGTH, VT_CS_MIN_SAMPLE_LENGTH), VT_ERROR);
+    assert_int_equal(cs_object.plan.sample_length, VT_CS_SAMPLE_LENGTH);
+
+    assert_int_equal(vt_currentsense_object_plan_create(&cs_object, VT_CS_SAMPLE_LENGTH / 2, VT_CS_AUTO_CORRELATION_LAG / 2),
+        VT_SUCCESS);
+    assert_int_equal(cs_object.plan.sample_length, VT_CS_SAMPLE_LENGTH / 2);
+    assert_int_equal(cs_object.plan.fft_length, VT_CS_SAMPLE_LENGTH / 4);
+    assert_float_equal(cs_object.plan.hamming_window[0], 0.08f, 0.001f);
+}
+
+static VT_UINT vt_adc_buffer_read(VT_ADC_ID adc_id,
+    VT_ADC_CONTROLLER* adc_controller,
+    VT_ADC_CHANNEL* adc_channel,
+    VT_FLOAT* adc_read_buffer,
+    VT_UINT buffer_length,
+    VT_FLOAT sampling_frequency,
+    VT_ADC_BUFFER_READ_CALLBACK_FUNC vt_adc_buffer_read_conv_half_cplt_callback,
+    VT_ADC_BUFFER_READ_CALLBACK_FUNC vt_adc_buffer_read_conv_cplt_callback)
+{
+    return 0;
+}
+
+static VT_VOID test_vt_currentsense_object_repeating_template_set(VT_CURRENTSENSE_OBJECT* cs_object, VT_UINT num_signatures)
+{
+    cs_object->fingerprintdb.template.repeating_signatures.num_signatures = num_signatures;
+    for (VT_UINT iter = 0; iter < num_signatures; iter++)
+    {
+        cs_object->fingerprintdb.template.repeating_signatures.signatures[iter].sampling_freq = 5000.0f / (iter + 1);
+    }
+}
+
+// vt_currentsense_object_initialize_from_pool()
+static VT_VOID test_vt_currentsense_object_initialize_from_pool(VT_VOID** state)
+{
+    VT_CURRENTSENSE_BUFFER_POOL buffer_pool;
+    VT_CURRENTSENSE_OBJECT cs_object_1;
+    VT_CURRENTSENSE_OBJECT cs_object_2;
+    VT_DEVICE_DRIVER device_driver;
+    VT_SENSOR_HANDLE sensor_handle;
+    static VT_ULONG pool_buffer[(2 * VT_CS_RAW_SIGNATURES_BUFFER_SIZE(2)) / sizeof(VT_ULONG)];
+
+    device_driver.adc_buffer_read = &vt_adc_buffer_read;
+
+    assert_int_equal(vt_currentsense_buffer_pool_initialize(&buffer_pool, (VT_CHAR*)pool_buffer, 1), VT_ERROR);
+    assert_int_equal(
+        vt_currentsense_buffer_pool_initialize(&buffer_pool, (VT_CHAR*)pool_buffer, sizeof(pool_buffer)), VT_SUCCESS);
+
+    /* Empty templates need no repeating buffers, both readers are packed at minimum size */
+    assert_int_equal(
+        vt_currentsense_object_initialize_from_pool(&cs_object_1, &device_driver, &sensor_handle, &buffer_pool), VT_SUCCESS);
+    assert_int_equal(
+        vt_currentsense_object_initialize_from_pool(&cs_object_2, &device_driver, &sensor_handle, &buffer_pool), VT_SUCCESS);
+    assert_int_equal(vt_currentsense_object_raw_signatures_buffer_size(&cs_object_1), VT_CS_RAW_SIGNATURES_BUFFER_SIZE(0));
+    assert_ptr_equal(cs_object_1.raw_signatures_reader, pool_buffer);
+    assert_true((VT_CHAR*)cs_object_2.raw_signatures_reader < (VT_CHAR*)pool_buffer + VT_CS_RAW_SIGNATURES_BUFFER_SIZE(1));
+    assert_int_equal(cs_object_2.raw_signatures_reader->repeating_raw_signatures_capacity, 0);
+
+    /* A grown template is resized at read time and the other reader moves out of its way */
+    test_vt_currentsense_object_repeating_template_set(&cs_object_1, 2);
+    assert_int_equal(vt_currentsense_object_raw_signatures_buffer_size(&cs_object_1), VT_CS_RAW_SIGNATURES_BUFFER_SIZE(2));
+    assert_int_equal(vt_currentsense_object_signature_read(&cs_object_1), VT_SUCCESS);
+    assert_int_equal(cs_object_1.raw_signatures_reader->repeating_raw_signatures_capacity, 2);
+    assert_int_equal(cs_object_1.raw_signatures_reader->num_repeating_raw_signatures, 2);
+    assert_true((VT_CHAR*)cs_object_2.raw_signatures_reader >= (VT_CHAR*)pool_buffer + VT_CS_RAW_SIGNATURES_BUFFER_SIZE(2));
+
+    /* Readers are not moved while another object is collecting, the read is skipped rather than truncated */
+    test_vt_currentsense_object_repeating_template_set(&cs_object_2, 1);
+    assert_int_equal(vt_currentsense_object_signature_read(&cs_object_2), VT_ERROR);
+    assert_int_equal(cs_object_2.raw_signatures_reader->num_repeating_raw_signatures, 0);
+    assert_false(cs_object_2.raw_signatures_reader->repeating_raw_signature_ongoing_collection);
+
+    cs_object_1.raw_signatures_reader->repeating_raw_signature_ongoing_collection  = false;
+    cs_object_1.raw_signatures_reader->non_repeating_raw_signature_stop_collection = true;
+    cs_object_2.raw_signatures_reader->repeating_raw_signature_ongoing_collection  = false;
+    cs_object_2.raw_signatures_reader->non_repeating_raw_signature_stop_collection = true;
+    assert_int_equal(vt_currentsense_object_signature_read(&cs_object_2), VT_SUCCESS);
+    assert_int_equal(cs_object_2.raw_signatures_reader->num_repeating_raw_signatures, 1);
+
+    /* Requests beyond the pool are refused, the buffers already owned are left as they were */
+    cs_object_2.raw_signatures_reader->repeating_raw_signature_ongoing_collection  = false;
+    cs_object_2.raw_signatures_reader->non_repeating_raw_signature_stop_collection = true;
+    test_vt_currentsense_object_repeating_template_set(&cs_object_2, VT_CS_MAX_SIGNATURES);
+    assert_int_equal(vt_currentsense_object_signature_read(&cs_object_2), VT_ERROR);
+    assert_int_equal(cs_object_2.raw_signatures_reader->num_repeating_raw_signatures, 1);
+    assert_int_equal(cs_object_2.raw_signatures_reader->repeating_raw_signatures_capacity, 1);
 }
 
 VT_INT test_vt_cs_object_initialize()
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_vt_currentsense_object_initialize),
+        cmocka_unit_test(test_vt_currentsense_object_initialize_from_pool),
     };
 
     return cmocka_run_group_tests_name("test_vt_cs_object_initialize", tests, NULL, NULL);
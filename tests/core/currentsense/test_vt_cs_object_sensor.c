@@ -20,6 +20,22 @@ static VT_VOID test_vt_currentsense_object_sensor_calibrate(VT_VOID** state)
     cs_object.mode = 0x00;
     vt_currentsense_object_sensor_calibrate(&cs_object);
     assert_int_equal(cs_object.mode, VT_MODE_CALIBRATE);
+    assert_int_equal(cs_object.calibration.num_captures_required, 1);
+    assert_int_equal(cs_object.calibration.num_captures, 0);
+}
+
+// vt_currentsense_object_sensor_calibrate_multi_capture()
+static VT_VOID test_vt_currentsense_object_sensor_calibrate_multi_capture(VT_VOID** state)
+{
+    VT_CURRENTSENSE_OBJECT cs_object;
+
+    cs_object.mode = 0x00;
+    assert_int_equal(vt_currentsense_object_sensor_calibrate_multi_capture(&cs_object, 0), VT_ERROR);
+    assert_int_equal(cs_object.mode, 0x00);
+    assert_int_equal(vt_currentsense_object_sensor_calibrate_multi_capture(&cs_object, 5), VT_SUCCESS);
+    assert_int_equal(cs_object.mode, VT_MODE_CALIBRATE);
+    assert_int_equal(cs_object.calibration.num_captures_required, 5);
+    assert_int_equal(cs_object.calibration.num_captures, 0);
 }
 
 // vt_currentsense_object_sensor_recalibrate()
@@ -30,6 +46,7 @@ static VT_VOID test_vt_currentsense_object_sensor_recalibrate(VT_VOID** state)
     cs_object.mode = 0x00;
     vt_currentsense_object_sensor_recalibrate(&cs_object);
     assert_int_equal(cs_object.mode, VT_MODE_RECALIBRATE);
+    assert_int_equal(cs_object.calibration.num_captures_required, 1);
 }
 
 // vt_currentsense_object_sensor_fetch_status()
@@ -50,6 +67,7 @@ VT_INT test_vt_cs_object_sensor()
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_vt_currentsense_object_sensor_calibrate),
+        cmocka_unit_test(test_vt_currentsense_object_sensor_calibrate_multi_capture),
         cmocka_unit_test(test_vt_currentsense_object_sensor_recalibrate),
         cmocka_unit_test(test_vt_currentsense_object_sensor_fetch_status),
     };
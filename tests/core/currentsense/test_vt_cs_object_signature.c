@@ -32,7 +32,8 @@ static VT_FLOAT sampling_frequencies_template[VT_CS_MAX_SIGNATURES] = {5000.0f,
 VT_CURRENTSENSE_OBJECT cs_object;
 VT_DEVICE_DRIVER device_driver;
 VT_SENSOR_HANDLE sensor_handle;
-VT_CURRENTSENSE_RAW_SIGNATURES_READER raw_signatures_reader;
+static VT_ULONG raw_signatures_storage[(VT_CS_RAW_SIGNATURES_BUFFER_MAX_SIZE + sizeof(VT_ULONG) - 1) / sizeof(VT_ULONG)];
+VT_CURRENTSENSE_RAW_SIGNATURES_READER* raw_signatures_reader = (VT_CURRENTSENSE_RAW_SIGNATURES_READER*)raw_signatures_storage;
 
 static VT_UINT vt_adc_buffer_read_with_real_func(VT_ADC_ID adc_id,
     VT_ADC_CONTROLLER* adc_controller,
@@ -74,6 +75,35 @@ static VT_UINT vt_adc_buffer_read(VT_ADC_ID adc_id,
     return 0;
 }
 
+static VT_FLOAT precheck_test_scale = 1;
+static VT_BOOL precheck_test_reading = false;
+
+/* Non-repeating signature scaled by precheck_test_scale, delivered as one half and one full buffer */
+static VT_UINT vt_adc_buffer_read_pattern(VT_ADC_ID adc_id,
+    VT_ADC_CONTROLLER* adc_controller,
+    VT_ADC_CHANNEL* adc_channel,
+    VT_FLOAT* adc_read_buffer,
+    VT_UINT buffer_length,
+    VT_FLOAT sampling_frequency,
+    VT_ADC_BUFFER_READ_CALLBACK_FUNC vt_adc_buffer_read_conv_half_cplt_callback,
+    VT_ADC_BUFFER_READ_CALLBACK_FUNC vt_adc_buffer_read_conv_cplt_callback)
+{
+    if (precheck_test_reading)
+    {
+        return 0;
+    }
+    precheck_test_reading = true;
+    for (VT_UINT iter = 0; iter < buffer_length; iter++)
+    {
+        adc_read_buffer[iter] =
+            non_repeating_raw_signature[iter % TEST_NON_REPEATING_RAW_SIGNATURE_SAMPLE_LENGTH] * precheck_test_scale;
+    }
+    vt_adc_buffer_read_conv_half_cplt_callback();
+    vt_adc_buffer_read_conv_cplt_callback();
+    precheck_test_reading = false;
+    return 0;
+}
+
 static VT_UINT calculate_fft_ranges()
 {
     VT_UINT ranges = 1;
@@ -103,15 +133,17 @@ static VT_VOID test_vt_currentsense_object_signature_read(VT_VOID** state)
     sensor_handle.gpio_id               = 1;
     sensor_handle.adc_id                = 1;
 
-    raw_signatures_reader.non_repeating_raw_signature.num_datapoints = TEST_NON_REPEATING_RAW_SIGNATURE_SAMPLE_LENGTH;
-    raw_signatures_reader.non_repeating_raw_signature.sample_length  = TEST_NON_REPEATING_RAW_SIGNATURE_SAMPLE_LENGTH;
+    raw_signatures_reader->non_repeating_raw_signature.num_datapoints = TEST_NON_REPEATING_RAW_SIGNATURE_SAMPLE_LENGTH;
+    raw_signatures_reader->non_repeating_raw_signature.sample_length  = TEST_NON_REPEATING_RAW_SIGNATURE_SAMPLE_LENGTH;
+    raw_signatures_reader->repeating_raw_signatures_capacity          = VT_CS_MAX_SIGNATURES;
 
     cs_object.device_driver         = &device_driver;
     cs_object.sensor_handle         = &sensor_handle;
-    cs_object.raw_signatures_reader = &raw_signatures_reader;
-    // VT_CHAR raw_signatures_buffer[sizeof(VT_CURRENTSENSE_RAW_SIGNATURES_READER)] = {0};
+    cs_object.raw_signatures_reader = raw_signatures_reader;
+    // VT_CHAR raw_signatures_buffer[VT_CS_RAW_SIGNATURES_BUFFER_MAX_SIZE] = {0};
 
     cs_object.raw_signatures_reader_initialized = true;
+    assert_int_equal(vt_currentsense_object_plan_create(&cs_object, VT_CS_SAMPLE_LENGTH, VT_CS_AUTO_CORRELATION_LAG), VT_SUCCESS);
     // cs_object.raw_signatures_reader             = (VT_CURRENTSENSE_RAW_SIGNATURES_READER*)raw_signatures_buffer;
     cs_object.device_driver->adc_buffer_read = &vt_adc_buffer_read;
 
@@ -157,16 +189,107 @@ static VT_VOID test_vt_currentsense_object_signature_read(VT_VOID** state)
     cs_object.mode                           = VT_MODE_RUNTIME_EVALUATE;
     cs_object.device_driver->adc_buffer_read = &vt_adc_buffer_read_with_real_func;
     vt_currentsense_object_signature_read(&cs_object);
+
+    /* Every sample read feeds the pre-check statistics, one ADC count is ref_voltage / 2^adc_res volts */
+    assert_true(cs_object.raw_signatures_reader->precheck_statistics.count > 0);
+    assert_float_equal(cs_object.raw_signatures_reader->precheck_statistics.mean,
+        (ref_voltage * 1000.0f) / (VT_FLOAT)(1 << adc_res),
+        0.0001f);
+}
+
+// vt_currentsense_object_precheck_enable(), vt_currentsense_object_precheck_fetch_status()
+static VT_VOID test_vt_currentsense_object_signature_precheck(VT_VOID** state)
+{
+    VT_CURRENTSENSE_OBJECT cs_object;
+    static VT_CHAR raw_signatures_buffer[VT_CS_RAW_SIGNATURES_BUFFER_MAX_SIZE];
+    static float ref_voltage   = 4.096f;
+    static uint16_t adc_res    = 12;
+    static float mv_to_ma      = 1;
+    VT_ULONG num_tier0_matching;
+    VT_ULONG num_tier0_not_matching;
+    VT_ULONG num_full;
+    VT_CURRENTSENSE_DATABASE_FLATTENED flattened_db = {0};
+
+    sensor_handle.adc_ref_volt          = &ref_voltage;
+    sensor_handle.adc_resolution        = &adc_res;
+    sensor_handle.currentsense_mV_to_mA = &mv_to_ma;
+    device_driver.adc_buffer_read       = &vt_adc_buffer_read_pattern;
+    assert_int_equal(vt_currentsense_object_initialize(
+                         &cs_object, &device_driver, &sensor_handle, raw_signatures_buffer, sizeof(raw_signatures_buffer)),
+        VT_SUCCESS);
+
+    /* Calibration records the range of capture statistics, the first capture sets the on threshold */
+    precheck_test_scale = 1;
+    assert_int_equal(vt_currentsense_object_sensor_calibrate_multi_capture(&cs_object, 2), VT_SUCCESS);
+    for (VT_UINT iter = 0; iter < 2; iter++)
+    {
+        vt_currentsense_object_signature_read(&cs_object);
+        cs_object.raw_signatures_reader->repeating_raw_signature_ongoing_collection = false;
+        vt_currentsense_object_signature_process(&cs_object);
+    }
+    assert_int_equal(cs_object.mode, VT_MODE_RUNTIME_EVALUATE);
+    assert_int_equal(cs_object.precheck.bounds.num_captures, 2);
+    assert_float_equal(cs_object.precheck.bounds.on_threshold, 38.0938f, 0.01f);
+    assert_float_equal(cs_object.precheck.bounds.on_ratio_min, 0.3203f, 0.001f);
+
+    /* Statistics within calibration match without feature extraction */
+    vt_currentsense_object_signature_read(&cs_object);
+    cs_object.raw_signatures_reader->repeating_raw_signature_ongoing_collection = false;
+    vt_currentsense_object_signature_process(&cs_object);
+    assert_int_equal(cs_object.sensor_status, VT_SIGNATURE_MATCHING);
+    vt_currentsense_object_precheck_fetch_status(&cs_object, &num_tier0_matching, &num_tier0_not_matching, &num_full);
+    assert_int_equal(num_tier0_matching, 1);
+    assert_int_equal(num_tier0_not_matching, 0);
+    assert_int_equal(num_full, 0);
+
+    /* A collapsed mean current fails without feature extraction */
+    precheck_test_scale = 0.05f;
+    vt_currentsense_object_signature_read(&cs_object);
+    cs_object.raw_signatures_reader->repeating_raw_signature_ongoing_collection = false;
+    vt_currentsense_object_signature_process(&cs_object);
+    assert_int_equal(cs_object.sensor_status, VT_SIGNATURE_NOT_MATCHING);
+    vt_currentsense_object_precheck_fetch_status(&cs_object, &num_tier0_matching, &num_tier0_not_matching, &num_full);
+    assert_int_equal(num_tier0_not_matching, 1);
+    assert_int_equal(num_full, 0);
+
+    /* Anything in between is left to the full check */
+    precheck_test_scale = 1.3f;
+    vt_currentsense_object_signature_read(&cs_object);
+    cs_object.raw_signatures_reader->repeating_raw_signature_ongoing_collection = false;
+    vt_currentsense_object_signature_process(&cs_object);
+    vt_currentsense_object_precheck_fetch_status(&cs_object, &num_tier0_matching, &num_tier0_not_matching, &num_full);
+    assert_int_equal(num_tier0_matching, 1);
+    assert_int_equal(num_full, 1);
+
+    /* Disabled, every evaluation runs the full check */
+    vt_currentsense_object_precheck_enable(&cs_object, false);
+    precheck_test_scale = 1;
+    vt_currentsense_object_signature_read(&cs_object);
+    cs_object.raw_signatures_reader->repeating_raw_signature_ongoing_collection = false;
+    vt_currentsense_object_signature_process(&cs_object);
+    vt_currentsense_object_precheck_fetch_status(&cs_object, &num_tier0_matching, &num_tier0_not_matching, &num_full);
+    assert_int_equal(num_tier0_matching, 1);
+    assert_int_equal(num_full, 2);
+
+    /* A synced template carries no pre-check bounds */
+    flattened_db.template_type[0] = '0' + VT_CS_NON_REPEATING_SIGNATURE;
+    vt_currentsense_object_database_sync(&cs_object, &flattened_db);
+    assert_int_equal(cs_object.precheck.bounds.num_captures, 0);
+
+    device_driver.adc_buffer_read = &vt_adc_buffer_read;
 }
 
 // vt_currentsense_object_signature_process()
 static VT_VOID test_vt_currentsense_object_signature_process(VT_VOID** state)
 {
     VT_CURRENTSENSE_OBJECT cs_object;
-    VT_CHAR raw_signatures_buffer[sizeof(VT_CURRENTSENSE_RAW_SIGNATURES_READER)] = {0};
+    VT_CHAR raw_signatures_buffer[VT_CS_RAW_SIGNATURES_BUFFER_MAX_SIZE] = {0};
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
 
     cs_object.raw_signatures_reader_initialized = true;
     cs_object.raw_signatures_reader             = (VT_CURRENTSENSE_RAW_SIGNATURES_READER*)raw_signatures_buffer;
+    assert_int_equal(vt_currentsense_object_plan_create(&cs_object, VT_CS_SAMPLE_LENGTH, VT_CS_AUTO_CORRELATION_LAG), VT_SUCCESS);
 
     cs_object.fingerprintdb.template_type                                    = VT_CS_REPEATING_SIGNATURE;
     cs_object.fingerprintdb.template.repeating_signatures.num_signatures     = 0;
@@ -174,6 +297,16 @@ static VT_VOID test_vt_currentsense_object_signature_process(VT_VOID** state)
     cs_object.fingerprintdb.template.repeating_signatures.offset_current     = VT_DATA_NOT_AVAILABLE;
     cs_object.fingerprintdb.template.non_repeating_signature.avg_curr_on     = VT_DATA_NOT_AVAILABLE;
     cs_object.fingerprintdb.template.non_repeating_signature.avg_curr_off    = VT_DATA_NOT_AVAILABLE;
+    for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
+    {
+        cs_object.template_tolerance.repeating_signature_drift[iter] = VT_CS_MAX_SIGNATURE_DRIFT;
+    }
+    cs_object.template_tolerance.offset_current_drift = VT_CS_MAX_AVG_CURR_DRIFT;
+    cs_object.template_tolerance.avg_curr_drift       = VT_CS_MAX_AVG_CURR_DRIFT;
+    cs_object.calibration.num_captures_required       = 1;
+    cs_object.calibration.num_captures                = 0;
+    cs_object.adaptation.enabled                      = false;
+    cs_object.sensor_status_updated                   = false;
 
     cs_object.raw_signatures_reader->repeating_raw_signature_ongoing_collection = false;
     cs_object.mode                                                              = VT_MODE_RUNTIME_EVALUATE;
@@ -298,6 +431,77 @@ static VT_VOID test_vt_currentsense_object_signature_process(VT_VOID** state)
     assert_int_equal(cs_object.fingerprintdb.template_type, VT_CS_REPEATING_SIGNATURE);
     assert_int_equal(cs_object.fingerprintdb.template.repeating_signatures.num_signatures, 2);
 
+    /* Calibration temporaries come from the scratch arena and are fully released */
+    assert_int_equal(cs_object.raw_signatures_reader->scratch_arena.used, 0);
+    assert_true(cs_object.raw_signatures_reader->scratch_arena.peak > 0);
+    assert_true(cs_object.raw_signatures_reader->scratch_arena.peak <= VT_CS_ARENA_SIZE);
+
+    /* A single capture leaves the spread unknown, template keeps the configured tolerance */
+    assert_int_equal(cs_object.template_confidence_metric, 100 - VT_CS_MAX_SIGNATURE_DRIFT);
+    assert_float_equal(cs_object.template_tolerance.repeating_signature_drift[0], VT_CS_MAX_SIGNATURE_DRIFT, 0.0001f);
+
+    /* Multi-capture calibration keeps calibrating until every capture is accumulated */
+    assert_int_equal(vt_currentsense_object_sensor_calibrate_multi_capture(&cs_object, 0), VT_ERROR);
+    assert_int_equal(vt_currentsense_object_sensor_calibrate_multi_capture(&cs_object, 2), VT_SUCCESS);
+    cs_object.db_updated            = false;
+    cs_object.sensor_status_updated = false;
+    vt_currentsense_object_signature_process(&cs_object);
+    assert_int_equal(cs_object.mode, VT_MODE_CALIBRATE);
+    assert_int_equal(cs_object.db_updated, false);
+    assert_int_equal(cs_object.calibration.num_captures, 1);
+
+    /* The first capture has no reference, later captures are checked against the template it chose */
+    assert_int_equal(vt_currentsense_object_sensor_fetch_status_update(&cs_object, &sensor_status, &sensor_drift), VT_ERROR);
+    assert_int_equal(vt_currentsense_object_signature_process_partial(&cs_object), 0);
+    assert_int_equal(vt_currentsense_object_sensor_fetch_status_update(&cs_object, &sensor_status, &sensor_drift), VT_SUCCESS);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+    assert_int_equal(cs_object.template_confidence_metric, VT_CS_PROVISIONAL_TEMPLATE_CONFIDENCE / 2);
+    assert_int_equal(vt_currentsense_object_sensor_fetch_status_update(&cs_object, &sensor_status, &sensor_drift), VT_ERROR);
+
+    vt_currentsense_object_signature_process(&cs_object);
+    assert_int_equal(vt_currentsense_object_sensor_fetch_status_update(&cs_object, &sensor_status, &sensor_drift), VT_SUCCESS);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+    assert_int_equal(cs_object.mode, VT_MODE_RUNTIME_EVALUATE);
+    assert_int_equal(cs_object.db_updated, true);
+    assert_int_equal(cs_object.calibration.num_captures, 0);
+    assert_int_equal(cs_object.fingerprintdb.template.repeating_signatures.num_signatures, 2);
+
+    /* Identical captures have no spread, tolerances settle on their floor */
+    assert_int_equal(cs_object.template_confidence_metric, 100);
+    assert_int_equal(cs_object.calibration.signature_freq[0].count, 0);
+    assert_float_equal(cs_object.template_tolerance.repeating_signature_drift[0], VT_CS_MIN_SIGNATURE_DRIFT, 0.0001f);
+    assert_float_equal(cs_object.template_tolerance.repeating_signature_drift[1], VT_CS_MIN_SIGNATURE_DRIFT, 0.0001f);
+    cs_object.calibration.num_captures_required = 1;
+
+    /* Progressive calibration publishes a provisional template from the ranges read so far */
+    cs_object.mode                                                              = VT_MODE_CALIBRATE;
+    cs_object.db_updated                                                        = false;
+    cs_object.raw_signatures_reader->repeating_raw_signature_buffers_filled     = false;
+    cs_object.raw_signatures_reader->calibration_ranges_processed               = 0;
+    cs_object.raw_signatures_reader->repeating_raw_signatures[0].num_datapoints = 0;
+    cs_object.raw_signatures_reader->repeating_raw_signatures[1].num_datapoints = 0;
+    assert_int_equal(vt_currentsense_object_signature_process_partial(&cs_object), 2);
+    assert_int_equal(cs_object.db_updated, false);
+
+    cs_object.raw_signatures_reader->repeating_raw_signatures[0].num_datapoints = TEST_REPEATING_RAW_SIGNATURE_SAMPLE_LENGTH;
+    assert_int_equal(vt_currentsense_object_signature_process_partial(&cs_object), 1);
+    assert_int_equal(cs_object.db_updated, true);
+    assert_int_equal(cs_object.fingerprintdb.template.repeating_signatures.num_signatures, 1);
+    assert_int_equal(cs_object.template_confidence_metric, VT_CS_PROVISIONAL_TEMPLATE_CONFIDENCE / 2);
+    assert_int_equal(vt_currentsense_object_signature_process_partial(&cs_object), 1);
+
+    cs_object.raw_signatures_reader->repeating_raw_signatures[1].num_datapoints = TEST_REPEATING_RAW_SIGNATURE_SAMPLE_LENGTH;
+    assert_int_equal(vt_currentsense_object_signature_process_partial(&cs_object), 0);
+    assert_int_equal(cs_object.fingerprintdb.template.repeating_signatures.num_signatures, 2);
+    assert_int_equal(cs_object.template_confidence_metric, VT_CS_PROVISIONAL_TEMPLATE_CONFIDENCE);
+    assert_int_equal(cs_object.mode, VT_MODE_CALIBRATE);
+
+    cs_object.raw_signatures_reader->repeating_raw_signature_buffers_filled = true;
+    vt_currentsense_object_signature_process(&cs_object);
+    assert_int_equal(cs_object.mode, VT_MODE_RUNTIME_EVALUATE);
+    assert_int_equal(cs_object.fingerprintdb.template.repeating_signatures.num_signatures, 2);
+    assert_int_equal(cs_object.template_confidence_metric, 100 - VT_CS_MAX_SIGNATURE_DRIFT);
+
     cs_object.raw_signatures_reader->repeating_raw_signature_ongoing_collection = false;
     cs_object.mode                                                              = VT_MODE_RECALIBRATE;
     cs_object.raw_signatures_reader_initialized                                 = true;
@@ -333,8 +537,12 @@ static VT_VOID test_vt_currentsense_object_signature_process(VT_VOID** state)
     {
         cs_object.raw_signatures_reader->non_repeating_raw_signature.current_measured[iter1] = non_repeating_raw_signature[iter1];
     }
+    cs_object.sensor_status_updated = false;
     vt_currentsense_object_signature_process(&cs_object);
 
+    /* Recalibration checks the capture against the template it replaces */
+    assert_int_equal(vt_currentsense_object_sensor_fetch_status_update(&cs_object, &sensor_status, &sensor_drift), VT_SUCCESS);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
     assert_int_equal(cs_object.mode, VT_MODE_RUNTIME_EVALUATE);
     assert_int_equal(cs_object.db_updated, true);
     assert_int_equal(cs_object.fingerprintdb.template_type, VT_CS_REPEATING_SIGNATURE);
@@ -385,6 +593,68 @@ static VT_VOID test_vt_currentsense_object_signature_process(VT_VOID** state)
     assert_int_equal(cs_object.fingerprintdb.template_type, VT_CS_REPEATING_SIGNATURE);
     assert_int_equal(cs_object.fingerprintdb.template.repeating_signatures.num_signatures, 4);
 
+    /* Partial processing evaluates signatures as soon as their own buffer fills */
+    cs_object.raw_signatures_reader->repeating_raw_signature_buffers_filled     = false;
+    cs_object.raw_signatures_reader->repeating_raw_signatures[0].num_datapoints = TEST_REPEATING_RAW_SIGNATURE_SAMPLE_LENGTH;
+    cs_object.raw_signatures_reader->repeating_raw_signatures[1].num_datapoints = 0;
+    cs_object.sensor_status                                                     = VT_SIGNATURE_DB_EMPTY;
+    assert_int_equal(vt_currentsense_object_signature_process_partial(&cs_object), 2);
+    assert_int_equal(cs_object.sensor_status, VT_SIGNATURE_MATCHING);
+
+    cs_object.raw_signatures_reader->repeating_raw_signatures[1].num_datapoints = TEST_REPEATING_RAW_SIGNATURE_SAMPLE_LENGTH;
+    assert_int_equal(vt_currentsense_object_signature_process_partial(&cs_object), 0);
+    assert_int_equal(cs_object.sensor_status, VT_SIGNATURE_MATCHING);
+
+    cs_object.raw_signatures_reader->repeating_raw_signature_buffers_filled = true;
+    vt_currentsense_object_signature_process(&cs_object);
+    assert_int_equal(cs_object.sensor_status, VT_SIGNATURE_MATCHING);
+
+    /* Matching evaluations with low drift are folded into the template, bounded by the drift from calibration */
+    VT_UINT adaptation_updates;
+    VT_UINT adaptation_rejected;
+    VT_FLOAT adaptation_drift;
+    VT_FLOAT signature_freq_saved = cs_object.fingerprintdb.template.repeating_signatures.signatures[1].signature_freq;
+    assert_int_equal(vt_currentsense_object_adaptation_enable(&cs_object, true, 0), VT_ERROR);
+    assert_int_equal(vt_currentsense_object_adaptation_enable(&cs_object, true, 0.5f), VT_SUCCESS);
+    cs_object.db_updated = false;
+    vt_currentsense_object_signature_process(&cs_object);
+    assert_int_equal(cs_object.sensor_status, VT_SIGNATURE_MATCHING);
+    vt_currentsense_object_adaptation_fetch_status(&cs_object, &adaptation_updates, &adaptation_rejected, &adaptation_drift);
+    assert_int_equal(adaptation_updates, 1);
+    assert_int_equal(adaptation_rejected, 0);
+    assert_true(adaptation_drift <= VT_CS_ADAPTATION_MAX_CUMULATIVE_DRIFT);
+    assert_true(adaptation_drift >= VT_CS_ADAPTATION_REPORT_DRIFT);
+    assert_int_equal(cs_object.db_updated, true);
+
+    /* The template is reported again only once it moved VT_CS_ADAPTATION_REPORT_DRIFT since the last report */
+    cs_object.db_updated = false;
+    vt_currentsense_object_signature_process(&cs_object);
+    vt_currentsense_object_adaptation_fetch_status(&cs_object, &adaptation_updates, &adaptation_rejected, &adaptation_drift);
+    assert_int_equal(adaptation_updates, 2);
+    assert_true(adaptation_drift - cs_object.adaptation.reported_drift < VT_CS_ADAPTATION_REPORT_DRIFT);
+    assert_int_equal(cs_object.db_updated, false);
+    vt_currentsense_object_signature_process(&cs_object);
+    vt_currentsense_object_adaptation_fetch_status(&cs_object, &adaptation_updates, &adaptation_rejected, &adaptation_drift);
+    assert_int_equal(adaptation_updates, 3);
+    assert_float_equal(cs_object.adaptation.reported_drift, adaptation_drift, 0.0001f);
+    assert_int_equal(cs_object.db_updated, true);
+
+    /* An update that would move the template too far from its baseline is rejected */
+    for (VT_UINT iter = 0; iter < VT_CS_MAX_SIGNATURES; iter++)
+    {
+        cs_object.adaptation.baseline.template.repeating_signatures.signatures[iter].signature_freq *= 10;
+        cs_object.adaptation.baseline.template.repeating_signatures.signatures[iter].duty_cycle *= 10;
+        cs_object.adaptation.baseline.template.repeating_signatures.signatures[iter].relative_curr_draw *= 10;
+    }
+    signature_freq_saved = cs_object.fingerprintdb.template.repeating_signatures.signatures[1].signature_freq;
+    vt_currentsense_object_signature_process(&cs_object);
+    vt_currentsense_object_adaptation_fetch_status(&cs_object, &adaptation_updates, &adaptation_rejected, &adaptation_drift);
+    assert_int_equal(adaptation_updates, 3);
+    assert_int_equal(adaptation_rejected, 1);
+    assert_float_equal(
+        cs_object.fingerprintdb.template.repeating_signatures.signatures[1].signature_freq, signature_freq_saved, 0.0001f);
+    assert_int_equal(vt_currentsense_object_adaptation_enable(&cs_object, false, 0), VT_SUCCESS);
+
     cs_object.raw_signatures_reader->repeating_raw_signature_ongoing_collection = false;
     cs_object.mode                                                              = VT_MODE_RUNTIME_EVALUATE;
     cs_object.raw_signatures_reader_initialized                                 = true;
@@ -799,6 +1069,7 @@ VT_INT test_vt_cs_object_signature()
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_vt_currentsense_object_signature_process),
         cmocka_unit_test(test_vt_currentsense_object_signature_read),
+        cmocka_unit_test(test_vt_currentsense_object_signature_precheck),
     };
 
     return cmocka_run_group_tests_name("vt_cs_object_signature", tests, NULL, NULL);
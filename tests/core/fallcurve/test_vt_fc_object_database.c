@@ -10,13 +10,24 @@
 
 #include "vt_fc_api.h"
 #include "vt_fc_config.h"
+#include "vt_storage_file.h"
 
 #include "cmocka.h"
 
+#define TEST_STORAGE_KEY "vTtestFallcurveStorage"
+
 static VT_UINT random_sampling_interval_array[VT_FC_MAX_SIGNATURES] = {26317, 6696, 278, 14072, 19332};
 static VT_UINT random_falltime_array[VT_FC_MAX_SIGNATURES]          = {22914, 21767, 8921, 8518, 6110};
 static VT_FLOAT random_pearson_coeff_array[VT_FC_MAX_SIGNATURES]    = {0.2794f, 0.9518f, 0.3319f, 0.8680f, 0.6204f};
 
+static VT_UINT test_storage_writes = 0;
+
+static VT_UINT test_storage_store_counted(VT_CHAR* key, VT_UCHAR* buffer, VT_ULONG size)
+{
+    test_storage_writes++;
+    return vt_storage_file_store(key, buffer, size);
+}
+
 // vt_fallcurve_object_database_fetch() & vt_fallcurve_object_database_sync()
 static VT_VOID test_vt_fallcurve_object_database_fetch_sync(VT_VOID** state)
 {
@@ -53,10 +64,65 @@ static VT_VOID test_vt_fallcurve_object_database_fetch_sync(VT_VOID** state)
     }
 }
 
+// vt_fallcurve_object_database_store() & vt_fallcurve_object_database_load()
+static VT_VOID test_vt_fallcurve_object_database_store_load(VT_VOID** state)
+{
+    VT_DEVICE_DRIVER device_driver         = {0};
+    VT_FALLCURVE_OBJECT fc_object          = {0};
+    VT_FALLCURVE_OBJECT fc_object_rebooted = {0};
+    VT_UCHAR corrupted_blob[]              = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+
+    fc_object.device_driver          = &device_driver;
+    fc_object_rebooted.device_driver = &device_driver;
+    for (VT_UINT iter = 0; iter < VT_FC_MAX_SIGNATURES; iter++)
+    {
+        fc_object.fingerprintdb.db[iter].sampling_interval_us = random_sampling_interval_array[iter];
+        fc_object.fingerprintdb.db[iter].falltime             = random_falltime_array[iter];
+        fc_object.fingerprintdb.db[iter].pearson_coeff        = random_pearson_coeff_array[iter];
+    }
+    fc_object.fingerprintdb.num_signatures = VT_FC_MAX_SIGNATURES;
+
+    // Devices without persistent storage never enable the hooks, whatever their pointers hold
+    assert_int_equal(vt_fallcurve_object_database_store(&fc_object, TEST_STORAGE_KEY), VT_ERROR);
+    assert_int_equal(vt_fallcurve_object_database_load(&fc_object_rebooted, TEST_STORAGE_KEY), VT_ERROR);
+    device_driver.storage_store = &test_storage_store_counted;
+    device_driver.storage_load  = &vt_storage_file_load;
+    assert_int_equal(vt_fallcurve_object_database_store(&fc_object, TEST_STORAGE_KEY), VT_ERROR);
+    assert_int_equal(test_storage_writes, 0);
+
+    vt_device_driver_storage_set(&device_driver, &test_storage_store_counted, &vt_storage_file_load);
+    vt_storage_file_erase(TEST_STORAGE_KEY);
+    assert_int_equal(vt_fallcurve_object_database_load(&fc_object_rebooted, TEST_STORAGE_KEY), VT_ERROR);
+    assert_int_equal(fc_object_rebooted.fingerprintdb.num_signatures, 0);
+
+    assert_int_equal(vt_fallcurve_object_database_store(&fc_object, TEST_STORAGE_KEY), VT_SUCCESS);
+    assert_int_equal(test_storage_writes, 1);
+    assert_int_equal(vt_fallcurve_object_database_load(&fc_object_rebooted, TEST_STORAGE_KEY), VT_SUCCESS);
+    assert_int_equal(fc_object_rebooted.fingerprintdb.num_signatures, VT_FC_MAX_SIGNATURES);
+    for (VT_UINT iter = 0; iter < VT_FC_MAX_SIGNATURES; iter++)
+    {
+        assert_int_equal(fc_object_rebooted.fingerprintdb.db[iter].sampling_interval_us, random_sampling_interval_array[iter]);
+        assert_int_equal(fc_object_rebooted.fingerprintdb.db[iter].falltime, random_falltime_array[iter]);
+        assert_float_equal(fc_object_rebooted.fingerprintdb.db[iter].pearson_coeff, random_pearson_coeff_array[iter], 1e-4f);
+    }
+
+    // Storing the unchanged template again leaves the flash alone
+    assert_int_equal(vt_fallcurve_object_database_store(&fc_object_rebooted, TEST_STORAGE_KEY), VT_SUCCESS);
+    assert_int_equal(test_storage_writes, 1);
+
+    // A corrupted blob is rejected and the restored template kept
+    assert_int_equal(vt_storage_file_store(TEST_STORAGE_KEY, corrupted_blob, sizeof(corrupted_blob)), VT_SUCCESS);
+    assert_int_equal(vt_fallcurve_object_database_load(&fc_object_rebooted, TEST_STORAGE_KEY), VT_ERROR);
+    assert_int_equal(fc_object_rebooted.fingerprintdb.num_signatures, VT_FC_MAX_SIGNATURES);
+
+    assert_int_equal(vt_storage_file_erase(TEST_STORAGE_KEY), VT_SUCCESS);
+}
+
 VT_INT test_vt_fc_object_database()
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_vt_fallcurve_object_database_fetch_sync),
+        cmocka_unit_test(test_vt_fallcurve_object_database_store_load),
     };
 
     return cmocka_run_group_tests_name("test_vt_fc_object_database", tests, NULL, NULL);
@@ -24,7 +24,7 @@ static VT_ULONG vt_tick()
 static VT_VOID test_vt_fallcurve_object_initialize(VT_VOID** state)
 {
     VT_FALLCURVE_OBJECT fc_object;
-    VT_DEVICE_DRIVER device_driver;
+    VT_DEVICE_DRIVER device_driver = {0};
     VT_SENSOR_HANDLE sensor_handle;
 
     device_driver.tick   = &vt_tick;
@@ -35,6 +35,15 @@ static VT_VOID test_vt_fallcurve_object_initialize(VT_VOID** state)
     assert_int_equal(fc_object.fingerprintdb.num_signatures, 0);
     assert_int_equal(fc_object.device_driver->tick(), TEST_TICK_VALUE_RANDOM);
     assert_int_equal(fc_object.sensor_handle->adc_id, TEST_ADC_ID_RANDOM);
+    assert_int_equal(fc_object.plan.sample_length, VT_FC_SAMPLE_LENGTH);
+    assert_null(fc_object.dma_capture.adc_read_buffer);
+    assert_false(fc_object.dma_capture.ongoing_collection);
+
+    assert_int_equal(vt_fallcurve_object_plan_create(&fc_object, VT_FC_SAMPLE_LENGTH + 1), VT_ERROR);
+    assert_int_equal(vt_fallcurve_object_plan_create(&fc_object, VT_FC_MIN_SAMPLE_LENGTH - 1), VT_ERROR);
+    assert_int_equal(fc_object.plan.sample_length, VT_FC_SAMPLE_LENGTH);
+    assert_int_equal(vt_fallcurve_object_plan_create(&fc_object, VT_FC_SAMPLE_LENGTH / 2), VT_SUCCESS);
+    assert_int_equal(fc_object.plan.sample_length, VT_FC_SAMPLE_LENGTH / 2);
 }
 
 VT_INT test_vt_fc_object_initialize()
@@ -16,6 +16,18 @@
 static VT_UINT vt_adc_iter;
 static VT_ULONG vt_tick_iter;
 static VT_UINT vt_adc_inconsistent_response_iter = 0;
+static VT_UINT vt_gpio_off_count                 = 0;
+static VT_UINT vt_interrupt_disable_count         = 0;
+static VT_BOOL vt_interrupts_disabled             = false;
+static VT_UINT vt_rc_rise_blackout_reads          = 0;
+static VT_UINT vt_adc_unselected_reads            = 0;
+static VT_UINT vt_adc_selected_id;
+static VT_FLOAT vt_adc_buffer_read_sampling_frequency;
+static VT_UINT vt_rc_switch_iter;
+static VT_FLOAT vt_rc_switch_value;
+static VT_FLOAT vt_rc_value;
+static VT_BOOL vt_rc_discharging;
+static VT_FLOAT vt_rc_rise_tau;
 
 static VT_UINT vt_adc_single_read_init(
     VT_UINT adc_id, VT_VOID* adc_controller, VT_VOID* adc_channel, VT_UINT* adc_resolution, float* adc_ref_volt)
@@ -24,6 +36,30 @@ static VT_UINT vt_adc_single_read_init(
     return 0;
 }
 
+// Selects the channel of adc_id, reselecting it between the round-robin reads of a capture does not restart the discharge
+static VT_UINT vt_adc_single_read_init_channel(
+    VT_UINT adc_id, VT_VOID* adc_controller, VT_VOID* adc_channel, VT_UINT* adc_resolution, float* adc_ref_volt)
+{
+    vt_adc_selected_id = adc_id;
+    if (!vt_interrupts_disabled)
+    {
+        vt_adc_iter = 0;
+    }
+    return 0;
+}
+
+// RC sensor that discharges while its GPIO is off and recharges while it is on, fully charged at the start of each capture
+static VT_UINT vt_adc_single_read_init_rc_voltage_response(
+    VT_UINT adc_id, VT_VOID* adc_controller, VT_VOID* adc_channel, VT_UINT* adc_resolution, float* adc_ref_volt)
+{
+    vt_adc_iter        = 0;
+    vt_rc_switch_iter  = 0;
+    vt_rc_switch_value = 1000;
+    vt_rc_value        = 1000;
+    vt_rc_discharging  = false;
+    return 0;
+}
+
 static VT_UINT vt_adc_single_read_init_inconsistent_voltage_response(
     VT_UINT adc_id, VT_VOID* adc_controller, VT_VOID* adc_channel, VT_UINT* adc_resolution, float* adc_ref_volt)
 {
@@ -106,6 +142,22 @@ static VT_UINT vt_adc_single_read_exponential_fall_voltage_response(VT_UINT adc_
     return value;
 }
 
+static VT_UINT vt_adc_single_read_rc_voltage_response(VT_UINT adc_id, VT_VOID* adc_controller, VT_VOID* adc_channel)
+{
+    VT_FLOAT time = (VT_FLOAT)(vt_adc_iter - vt_rc_switch_iter);
+    if (vt_rc_discharging)
+    {
+        vt_rc_value = vt_rc_switch_value * (VT_FLOAT)exp(-1.0f * (time / (VT_FLOAT)(VT_FC_SAMPLE_LENGTH - 1)));
+    }
+    else
+    {
+        vt_rc_value = 1000.0f - ((1000.0f - vt_rc_switch_value) * (VT_FLOAT)exp(-1.0f * (time / vt_rc_rise_tau)));
+        vt_rc_rise_blackout_reads += vt_interrupts_disabled ? 1 : 0;
+    }
+    vt_adc_iter++;
+    return round(vt_rc_value);
+}
+
 static VT_UINT vt_adc_single_read_fast_exponential_fall_voltage_response(
     VT_UINT adc_id, VT_VOID* adc_controller, VT_VOID* adc_channel)
 {
@@ -124,6 +176,13 @@ static VT_UINT vt_adc_single_read_slow_exponential_fall_voltage_response(
     return value;
 }
 
+static VT_UINT vt_adc_single_read_channel_exponential_fall_voltage_response(
+    VT_UINT adc_id, VT_VOID* adc_controller, VT_VOID* adc_channel)
+{
+    vt_adc_unselected_reads += (adc_id != vt_adc_selected_id) ? 1 : 0;
+    return vt_adc_single_read_exponential_fall_voltage_response(adc_id, adc_controller, adc_channel);
+}
+
 static VT_UINT vt_adc_single_read_different_amplitude_exponential_fall_voltage_response(
     VT_UINT adc_id, VT_VOID* adc_controller, VT_VOID* adc_channel)
 {
@@ -149,6 +208,13 @@ static VT_UINT vt_adc_single_read_half_exponential_half_linear_fall_voltage_resp
     return value;
 }
 
+static VT_UINT vt_adc_single_read_noisy_exponential_fall_voltage_response(
+    VT_UINT adc_id, VT_VOID* adc_controller, VT_VOID* adc_channel)
+{
+    VT_INT noise = (vt_adc_iter % 2) ? 40 : -40;
+    return vt_adc_single_read_exponential_fall_voltage_response(adc_id, adc_controller, adc_channel) + noise;
+}
+
 static VT_UINT vt_adc_single_read_inconsistent_voltage_response(VT_UINT adc_id, VT_VOID* adc_controller, VT_VOID* adc_channel)
 {
     if (vt_adc_inconsistent_response_iter < 3)
@@ -168,6 +234,24 @@ static VT_UINT vt_gpio_on(VT_UINT gpio_id, VT_VOID* gpio_port, VT_VOID* gpio_pin
 
 static VT_UINT vt_gpio_off(VT_UINT gpio_id, VT_VOID* gpio_port, VT_VOID* gpio_pin)
 {
+    vt_gpio_off_count++;
+    return 0;
+}
+
+static VT_UINT vt_gpio_on_rc(VT_UINT gpio_id, VT_VOID* gpio_port, VT_VOID* gpio_pin)
+{
+    vt_rc_switch_iter  = vt_adc_iter;
+    vt_rc_switch_value = vt_rc_value;
+    vt_rc_discharging  = false;
+    return 0;
+}
+
+static VT_UINT vt_gpio_off_rc(VT_UINT gpio_id, VT_VOID* gpio_port, VT_VOID* gpio_pin)
+{
+    vt_gpio_off_count++;
+    vt_rc_switch_iter  = vt_adc_iter;
+    vt_rc_switch_value = vt_rc_value;
+    vt_rc_discharging  = true;
     return 0;
 }
 
@@ -198,22 +282,42 @@ static unsigned long vt_tick()
 
 void vt_interrupt_enable()
 {
-    // do nothing
+    vt_interrupts_disabled = false;
 }
 
 void vt_interrupt_disable()
 {
-    // do nothing
+    vt_interrupt_disable_count++;
+    vt_interrupts_disabled = true;
+}
+
+static VT_UINT vt_adc_buffer_read_exponential_fall(VT_ADC_ID adc_id,
+    VT_ADC_CONTROLLER* adc_controller,
+    VT_ADC_CHANNEL* adc_channel,
+    VT_FLOAT* adc_read_buffer,
+    VT_UINT buffer_length,
+    VT_FLOAT sampling_frequency,
+    VT_ADC_BUFFER_READ_CALLBACK_FUNC vt_adc_buffer_read_conv_half_cplt_callback,
+    VT_ADC_BUFFER_READ_CALLBACK_FUNC vt_adc_buffer_read_conv_cplt_callback)
+{
+    vt_adc_buffer_read_sampling_frequency = sampling_frequency;
+    for (VT_UINT iter = 0; iter < buffer_length; iter++)
+    {
+        VT_FLOAT time_us      = (VT_FLOAT)(iter + 1) * (1000000.0f / sampling_frequency);
+        adc_read_buffer[iter] = 1000.0f * (VT_FLOAT)exp(-1.0f * (time_us / 990.0f));
+    }
+    vt_adc_buffer_read_conv_half_cplt_callback();
+    vt_adc_buffer_read_conv_cplt_callback();
+    return 0;
 }
 
 // vt_fallcurve_object_sensor_calibrate() & vt_fallcurve_object_sensor_recalibrate()
 static VT_VOID test_vt_fallcurve_object_sensor_calibrate_recalibrate(VT_VOID** state)
 {
     VT_FALLCURVE_OBJECT fc_object;
-    VT_DEVICE_DRIVER device_driver;
+    VT_DEVICE_DRIVER device_driver = {0};
     VT_SENSOR_HANDLE sensor_handle;
-    fc_object.device_driver = &device_driver;
-    fc_object.sensor_handle = &sensor_handle;
+    vt_fallcurve_object_initialize(&fc_object, &device_driver, &sensor_handle);
     VT_UINT8 confidence_metric;
     fc_object.device_driver->adc_single_read_init = &vt_adc_single_read_init;
     fc_object.device_driver->gpio_on              = &vt_gpio_on;
@@ -245,7 +349,10 @@ static VT_VOID test_vt_fallcurve_object_sensor_calibrate_recalibrate(VT_VOID** s
     assert_int_equal(vt_fallcurve_object_sensor_recalibrate(&fc_object, &confidence_metric), VT_ERROR);
 
     fc_object.device_driver->adc_single_read = &vt_adc_single_read_exponential_fall_voltage_response;
+    vt_gpio_off_count                        = 0;
     assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    assert_int_equal(vt_gpio_off_count, 1);
+    assert_int_equal(confidence_metric, 100);
     assert_int_equal(fc_object.fingerprintdb.num_signatures, 1);
     assert_int_equal(vt_fallcurve_object_sensor_recalibrate(&fc_object, &confidence_metric), VT_SUCCESS);
     assert_int_equal(fc_object.fingerprintdb.num_signatures, 2);
@@ -264,20 +371,26 @@ static VT_VOID test_vt_fallcurve_object_sensor_calibrate_recalibrate(VT_VOID** s
     fc_object.device_driver->adc_single_read = &vt_adc_single_read_slow_exponential_fall_voltage_response;
     assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
 
+    // Calibration uses a single discharge, so an inconsistent response only shows up on later captures
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
+    vt_adc_inconsistent_response_iter             = 0;
     fc_object.device_driver->adc_single_read_init = &vt_adc_single_read_init_inconsistent_voltage_response;
     fc_object.device_driver->adc_single_read      = &vt_adc_single_read_inconsistent_voltage_response;
-    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_ERROR);
-    assert_int_equal(vt_fallcurve_object_sensor_recalibrate(&fc_object, &confidence_metric), VT_ERROR);
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_COMPUTE_FAIL);
 }
 
 // vt_fallcurve_object_sensor_status()
 static VT_VOID test_vt_fallcurve_object_sensor_status(VT_VOID** state)
 {
     VT_FALLCURVE_OBJECT fc_object;
-    VT_DEVICE_DRIVER device_driver;
+    VT_DEVICE_DRIVER device_driver = {0};
     VT_SENSOR_HANDLE sensor_handle;
-    fc_object.device_driver = &device_driver;
-    fc_object.sensor_handle = &sensor_handle;
+    vt_fallcurve_object_initialize(&fc_object, &device_driver, &sensor_handle);
     VT_UINT sensor_status;
     VT_UINT sensor_drift;
     VT_UINT8 confidence_metric;
@@ -344,17 +457,437 @@ static VT_VOID test_vt_fallcurve_object_sensor_status(VT_VOID** state)
     vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
     assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
 
+    fc_object.device_driver->adc_single_read = &vt_adc_single_read_fast_exponential_fall_voltage_response;
+    assert_int_equal(vt_fallcurve_object_sensor_recalibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    fc_object.device_driver->adc_single_read = &vt_adc_single_read_slow_exponential_fall_voltage_response;
+    assert_int_equal(vt_fallcurve_object_sensor_recalibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    assert_int_equal(fc_object.fingerprintdb.num_signatures, 3);
+    vt_gpio_off_count = 0;
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+    assert_int_equal(vt_gpio_off_count, 1);
+
     fc_object.device_driver->tick_init       = &vt_tick_init_with_some_values;
     fc_object.device_driver->adc_single_read = &vt_adc_single_read_exponential_fall_voltage_response;
     vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
     assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
 }
 
+// vt_fallcurve_object_sensor_status_batch()
+static VT_VOID test_vt_fallcurve_object_sensor_status_batch(VT_VOID** state)
+{
+    VT_FALLCURVE_OBJECT fc_object[3];
+    VT_FALLCURVE_OBJECT* fc_objects[3] = {&fc_object[0], &fc_object[1], &fc_object[2]};
+    VT_DEVICE_DRIVER device_driver[3]  = {0};
+    VT_SENSOR_HANDLE sensor_handle[3];
+    VT_UINT sensor_status[3];
+    VT_UINT sensor_drift[3];
+    VT_UINT8 confidence_metric;
+
+    for (VT_UINT iter = 0; iter < 3; iter++)
+    {
+        sensor_handle[iter].adc_id               = iter;
+        device_driver[iter].adc_single_read_init = &vt_adc_single_read_init_channel;
+        device_driver[iter].adc_single_read      = &vt_adc_single_read_channel_exponential_fall_voltage_response;
+        device_driver[iter].gpio_on              = &vt_gpio_on;
+        device_driver[iter].gpio_off             = &vt_gpio_off;
+        device_driver[iter].tick_init            = &vt_tick_init;
+        device_driver[iter].tick_deinit          = &vt_tick_deinit;
+        device_driver[iter].tick                 = &vt_tick;
+        device_driver[iter].interrupt_enable     = &vt_interrupt_enable;
+        device_driver[iter].interrupt_disable    = &vt_interrupt_disable;
+        vt_fallcurve_object_initialize(&fc_object[iter], &device_driver[iter], &sensor_handle[iter]);
+    }
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object[0], &confidence_metric), VT_SUCCESS);
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object[1], &confidence_metric), VT_SUCCESS);
+
+    assert_int_equal(vt_fallcurve_object_sensor_status_batch(fc_objects, 0, sensor_status, sensor_drift), VT_ERROR);
+    assert_int_equal(
+        vt_fallcurve_object_sensor_status_batch(fc_objects, VT_FC_MAX_BATCH_SENSORS + 1, sensor_status, sensor_drift), VT_ERROR);
+
+    // Sensors with templates share one blackout, the sensor without templates is never powered down. Every read is of the
+    // channel selected for it
+    vt_gpio_off_count          = 0;
+    vt_interrupt_disable_count = 0;
+    vt_adc_unselected_reads    = 0;
+    assert_int_equal(vt_fallcurve_object_sensor_status_batch(fc_objects, 3, sensor_status, sensor_drift), VT_SUCCESS);
+    assert_int_equal(vt_interrupt_disable_count, 1);
+    assert_int_equal(vt_gpio_off_count, 2);
+    assert_int_equal(vt_adc_unselected_reads, 0);
+    assert_int_equal(sensor_status[0], VT_SIGNATURE_MATCHING);
+    assert_int_equal(sensor_status[1], VT_SIGNATURE_MATCHING);
+    assert_int_equal(sensor_status[2], VT_SIGNATURE_DB_EMPTY);
+
+    // Three sensors read round-robin space the samples of their fastest templates wider than a read alone does, the
+    // falltime follows the spacing actually sampled
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object[2], &confidence_metric), VT_SUCCESS);
+    assert_int_equal(vt_fallcurve_object_sensor_status_batch(fc_objects, 3, sensor_status, sensor_drift), VT_SUCCESS);
+    assert_int_equal(vt_adc_unselected_reads, 0);
+    assert_int_equal(sensor_status[0], VT_SIGNATURE_MATCHING);
+    assert_int_equal(sensor_status[1], VT_SIGNATURE_MATCHING);
+    assert_int_equal(sensor_status[2], VT_SIGNATURE_MATCHING);
+
+    device_driver[1].adc_single_read = &vt_adc_single_read_fast_exponential_fall_voltage_response;
+    assert_int_equal(vt_fallcurve_object_sensor_status_batch(fc_objects, 2, sensor_status, sensor_drift), VT_SUCCESS);
+    assert_int_equal(sensor_status[0], VT_SIGNATURE_MATCHING);
+    assert_int_equal(sensor_status[1], VT_SIGNATURE_NOT_MATCHING);
+    assert_int_equal(sensor_drift[1], 100);
+}
+
+// vt_fallcurve_object_oversampling_enable() & vt_fallcurve_object_oversampling_fetch_status()
+static VT_VOID test_vt_fallcurve_object_oversampling(VT_VOID** state)
+{
+    VT_FALLCURVE_OBJECT fc_object;
+    VT_DEVICE_DRIVER device_driver = {0};
+    VT_SENSOR_HANDLE sensor_handle;
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
+    VT_UINT8 confidence_metric;
+    VT_FLOAT sample_variance;
+
+    device_driver.adc_single_read_init = &vt_adc_single_read_init;
+    device_driver.adc_single_read      = &vt_adc_single_read_noisy_exponential_fall_voltage_response;
+    device_driver.gpio_on              = &vt_gpio_on;
+    device_driver.gpio_off             = &vt_gpio_off;
+    device_driver.tick_init            = &vt_tick_init;
+    device_driver.tick_deinit          = &vt_tick_deinit;
+    device_driver.tick                 = &vt_tick;
+    device_driver.interrupt_enable     = &vt_interrupt_enable;
+    device_driver.interrupt_disable    = &vt_interrupt_disable;
+    vt_fallcurve_object_initialize(&fc_object, &device_driver, &sensor_handle);
+    assert_false(fc_object.plan.oversampling);
+
+    vt_fallcurve_object_oversampling_enable(&fc_object, true);
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    vt_fallcurve_object_oversampling_fetch_status(&fc_object, &sample_variance);
+    assert_true(sample_variance > 0);
+
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+    vt_fallcurve_object_oversampling_fetch_status(&fc_object, &sample_variance);
+    assert_true(sample_variance > 0);
+
+    // Several reads per interval on a slow fall, the discharge slope is detrended and only the read noise remains
+    device_driver.adc_single_read = &vt_adc_single_read_slow_exponential_fall_voltage_response;
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    vt_fallcurve_object_oversampling_fetch_status(&fc_object, &sample_variance);
+    assert_true(sample_variance < 0.5f);
+
+    device_driver.adc_single_read = &vt_adc_single_read_noisy_exponential_fall_voltage_response;
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    vt_fallcurve_object_oversampling_fetch_status(&fc_object, &sample_variance);
+    assert_true(sample_variance > 1000);
+
+    vt_fallcurve_object_oversampling_enable(&fc_object, false);
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    vt_fallcurve_object_oversampling_fetch_status(&fc_object, &sample_variance);
+    assert_float_equal(sample_variance, 0, 0.0001f);
+}
+
+// vt_fallcurve_object_early_stop_set() & vt_fallcurve_object_early_stop_fetch_status()
+static VT_VOID test_vt_fallcurve_object_early_stop(VT_VOID** state)
+{
+    VT_FALLCURVE_OBJECT fc_object;
+    VT_DEVICE_DRIVER device_driver = {0};
+    VT_SENSOR_HANDLE sensor_handle;
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
+    VT_UINT8 confidence_metric;
+    VT_UINT samples_used;
+    VT_ULONG capture_time_us;
+
+    device_driver.adc_single_read_init = &vt_adc_single_read_init;
+    device_driver.adc_single_read      = &vt_adc_single_read_exponential_fall_voltage_response;
+    device_driver.gpio_on              = &vt_gpio_on;
+    device_driver.gpio_off             = &vt_gpio_off;
+    device_driver.tick_init            = &vt_tick_init;
+    device_driver.tick_deinit          = &vt_tick_deinit;
+    device_driver.tick                 = &vt_tick;
+    device_driver.interrupt_enable     = &vt_interrupt_enable;
+    device_driver.interrupt_disable    = &vt_interrupt_disable;
+    vt_fallcurve_object_initialize(&fc_object, &device_driver, &sensor_handle);
+    assert_float_equal(fc_object.plan.early_stop_fraction, VT_FC_EARLY_STOP_FRACTION, 0.0001f);
+
+    assert_int_equal(vt_fallcurve_object_early_stop_set(&fc_object, -0.1f), VT_ERROR);
+    assert_int_equal(vt_fallcurve_object_early_stop_set(&fc_object, 0.37f), VT_ERROR);
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+
+    // A faster decay settles well before the template's sample_length samples have been read
+    device_driver.adc_single_read = &vt_adc_single_read_fast_exponential_fall_voltage_response;
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    vt_fallcurve_object_early_stop_fetch_status(&fc_object, &samples_used);
+    assert_true(samples_used < VT_FC_SAMPLE_LENGTH);
+    assert_int_equal(sensor_status, VT_SIGNATURE_NOT_MATCHING);
+
+    assert_int_equal(vt_fallcurve_object_early_stop_set(&fc_object, 0), VT_SUCCESS);
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    vt_fallcurve_object_early_stop_fetch_status(&fc_object, &samples_used);
+    assert_int_equal(samples_used, VT_FC_SAMPLE_LENGTH);
+    assert_int_equal(sensor_status, VT_SIGNATURE_NOT_MATCHING);
+    vt_fallcurve_object_capture_time_fetch_status(&fc_object, &capture_time_us);
+    assert_int_equal(capture_time_us, VT_FC_SAMPLE_LENGTH * fc_object.fingerprintdb.db[0].sampling_interval_us);
+}
+
+// vt_fallcurve_object_shape_fit_set() & vt_fallcurve_object_shape_fit_fetch_status()
+static VT_VOID test_vt_fallcurve_object_shape_fit(VT_VOID** state)
+{
+    VT_FALLCURVE_OBJECT fc_object;
+    VT_DEVICE_DRIVER device_driver = {0};
+    VT_SENSOR_HANDLE sensor_handle;
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
+    VT_UINT8 confidence_metric;
+    VT_FALLCURVE_FIT fit;
+
+    device_driver.adc_single_read_init = &vt_adc_single_read_init;
+    device_driver.adc_single_read      = &vt_adc_single_read_exponential_fall_voltage_response;
+    device_driver.gpio_on              = &vt_gpio_on;
+    device_driver.gpio_off             = &vt_gpio_off;
+    device_driver.tick_init            = &vt_tick_init;
+    device_driver.tick_deinit          = &vt_tick_deinit;
+    device_driver.tick                 = &vt_tick;
+    device_driver.interrupt_enable     = &vt_interrupt_enable;
+    device_driver.interrupt_disable    = &vt_interrupt_disable;
+    vt_fallcurve_object_initialize(&fc_object, &device_driver, &sensor_handle);
+    assert_int_equal(fc_object.plan.shape_fit, VT_FC_SHAPE_FIT_PEARSON);
+
+    assert_int_equal(vt_fallcurve_object_shape_fit_set(&fc_object, VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT + 1), VT_ERROR);
+    assert_int_equal(vt_fallcurve_object_shape_fit_set(&fc_object, VT_FC_SHAPE_FIT_LOG_LINEAR), VT_SUCCESS);
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    vt_fallcurve_object_shape_fit_fetch_status(&fc_object, &fit);
+    assert_true(fit.r_squared > 0.999f);
+    assert_true(fit.residual_rms < 0.01f);
+    assert_true(fit.num_datapoints > VT_FC_MIN_FALLTIME_DATAPOINTS);
+    // Two mock reads per sample at a 1us interval, so the 99 read time constant spans about 49.5us
+    assert_float_equal(fit.tau_us, 49.5f, 1.0f);
+    assert_int_equal(fc_object.fingerprintdb.db[0].falltime, round(fit.tau_us));
+
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+
+    device_driver.adc_single_read = &vt_adc_single_read_fast_exponential_fall_voltage_response;
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_NOT_MATCHING);
+
+    device_driver.adc_single_read = &vt_adc_single_read_step_voltage_response;
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_COMPUTE_FAIL);
+}
+
+// vt_fallcurve_object_shape_fit_set() with VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT
+static VT_VOID test_vt_fallcurve_object_fixed_point(VT_VOID** state)
+{
+    VT_FALLCURVE_OBJECT fc_object;
+    VT_DEVICE_DRIVER device_driver = {0};
+    VT_SENSOR_HANDLE sensor_handle;
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
+    VT_UINT8 confidence_metric;
+    VT_ULONG falltime_float;
+    VT_FLOAT pearson_coeff_float;
+
+    device_driver.adc_single_read_init = &vt_adc_single_read_init;
+    device_driver.adc_single_read      = &vt_adc_single_read_exponential_fall_voltage_response;
+    device_driver.gpio_on              = &vt_gpio_on;
+    device_driver.gpio_off             = &vt_gpio_off;
+    device_driver.tick_init            = &vt_tick_init;
+    device_driver.tick_deinit          = &vt_tick_deinit;
+    device_driver.tick                 = &vt_tick;
+    device_driver.interrupt_enable     = &vt_interrupt_enable;
+    device_driver.interrupt_disable    = &vt_interrupt_disable;
+    vt_fallcurve_object_initialize(&fc_object, &device_driver, &sensor_handle);
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    falltime_float      = fc_object.fingerprintdb.db[0].falltime;
+    pearson_coeff_float = fc_object.fingerprintdb.db[0].pearson_coeff;
+
+    vt_fallcurve_object_initialize(&fc_object, &device_driver, &sensor_handle);
+    assert_int_equal(vt_fallcurve_object_shape_fit_set(&fc_object, VT_FC_SHAPE_FIT_PEARSON_FIXED_POINT), VT_SUCCESS);
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    // Same falltime as the float path and a shape score on the Q16 grid that agrees with it
+    assert_int_equal(fc_object.fingerprintdb.db[0].falltime, falltime_float);
+    assert_float_equal(fc_object.fingerprintdb.db[0].pearson_coeff, pearson_coeff_float, 0.001f);
+    assert_float_equal(fc_object.fingerprintdb.db[0].pearson_coeff * 65536.0f,
+        round(fc_object.fingerprintdb.db[0].pearson_coeff * 65536.0f),
+        0.0f);
+
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+
+    device_driver.adc_single_read = &vt_adc_single_read_fast_exponential_fall_voltage_response;
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_NOT_MATCHING);
+
+    device_driver.adc_single_read = &vt_adc_single_read_step_voltage_response;
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_COMPUTE_FAIL);
+}
+
+// vt_fallcurve_object_rise_curve_enable()
+static VT_VOID test_vt_fallcurve_object_rise_curve(VT_VOID** state)
+{
+    VT_FALLCURVE_OBJECT fc_object;
+    VT_DEVICE_DRIVER device_driver = {0};
+    VT_SENSOR_HANDLE sensor_handle;
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
+    VT_UINT8 confidence_metric;
+    VT_UINT rise_buffer[VT_FC_RISE_CURVE_BUFFER_LENGTH];
+
+    device_driver.adc_single_read_init = &vt_adc_single_read_init_rc_voltage_response;
+    device_driver.adc_single_read      = &vt_adc_single_read_rc_voltage_response;
+    device_driver.gpio_on              = &vt_gpio_on_rc;
+    device_driver.gpio_off             = &vt_gpio_off_rc;
+    device_driver.tick_init            = &vt_tick_init;
+    device_driver.tick_deinit          = &vt_tick_deinit;
+    device_driver.tick                 = &vt_tick;
+    device_driver.interrupt_enable     = &vt_interrupt_enable;
+    device_driver.interrupt_disable    = &vt_interrupt_disable;
+    vt_rc_rise_tau                     = (VT_FLOAT)(VT_FC_SAMPLE_LENGTH - 1) / 2.0f;
+    vt_fallcurve_object_initialize(&fc_object, &device_driver, &sensor_handle);
+    assert_false(fc_object.plan.rise_curve);
+
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    assert_int_equal(fc_object.fingerprintdb.db[0].risetime, 0);
+
+    assert_int_equal(vt_fallcurve_object_rise_curve_enable(&fc_object, rise_buffer, VT_FC_SAMPLE_LENGTH), VT_ERROR);
+    assert_false(fc_object.plan.rise_curve);
+
+    assert_int_equal(vt_fallcurve_object_rise_curve_enable(&fc_object, rise_buffer, VT_FC_RISE_CURVE_BUFFER_LENGTH), VT_SUCCESS);
+    vt_gpio_off_count          = 0;
+    vt_interrupt_disable_count = 0;
+    vt_rc_rise_blackout_reads  = 0;
+    assert_int_equal(vt_fallcurve_object_sensor_calibrate(&fc_object, &confidence_metric), VT_SUCCESS);
+    assert_true(fc_object.fingerprintdb.db[0].risetime > 0);
+    assert_true(fc_object.fingerprintdb.db[0].rise_pearson_coeff > VT_FC_MIN_SHAPE_MATCH);
+    // The recharge follows the same discharge but outside its interrupt blackout
+    assert_int_equal(vt_gpio_off_count, 1);
+    assert_int_equal(vt_interrupt_disable_count, 1);
+    assert_int_equal(vt_rc_rise_blackout_reads, 0);
+
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+    assert_int_equal(vt_rc_rise_blackout_reads, 0);
+
+    // Same discharge but a slower recharge only fails on the rise curve
+    vt_rc_rise_tau = (VT_FLOAT)(VT_FC_SAMPLE_LENGTH - 1) * 2.0f;
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_NOT_MATCHING);
+
+    assert_int_equal(vt_fallcurve_object_rise_curve_enable(&fc_object, NULL, 0), VT_SUCCESS);
+    vt_fallcurve_object_sensor_status(&fc_object, &sensor_status, &sensor_drift);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+}
+
+// vt_fallcurve_object_signature_read() & vt_fallcurve_object_signature_process()
+static VT_ADC_BUFFER_READ_CALLBACK_FUNC vt_adc_buffer_read_deferred_callback;
+
+// DMA that only completes once the test calls the stored callback
+static VT_UINT vt_adc_buffer_read_deferred(VT_ADC_ID adc_id,
+    VT_ADC_CONTROLLER* adc_controller,
+    VT_ADC_CHANNEL* adc_channel,
+    VT_FLOAT* adc_read_buffer,
+    VT_UINT buffer_length,
+    VT_FLOAT sampling_frequency,
+    VT_ADC_BUFFER_READ_CALLBACK_FUNC vt_adc_buffer_read_conv_half_cplt_callback,
+    VT_ADC_BUFFER_READ_CALLBACK_FUNC vt_adc_buffer_read_conv_cplt_callback)
+{
+    vt_adc_buffer_read_deferred_callback = vt_adc_buffer_read_conv_cplt_callback;
+    return 0;
+}
+
+static VT_VOID test_vt_fallcurve_object_signature_dma(VT_VOID** state)
+{
+    VT_FALLCURVE_OBJECT fc_object;
+    VT_DEVICE_DRIVER device_driver = {0};
+    VT_SENSOR_HANDLE sensor_handle;
+    VT_FLOAT adc_read_buffer[4 * VT_FC_SAMPLE_LENGTH];
+    VT_UINT sensor_status;
+    VT_UINT sensor_drift;
+
+    device_driver.gpio_on           = &vt_gpio_on;
+    device_driver.gpio_off          = &vt_gpio_off;
+    device_driver.interrupt_enable  = &vt_interrupt_enable;
+    device_driver.interrupt_disable = &vt_interrupt_disable;
+    device_driver.adc_buffer_read   = &vt_adc_buffer_read_exponential_fall;
+    vt_fallcurve_object_initialize(&fc_object, &device_driver, &sensor_handle);
+
+    assert_int_equal(vt_fallcurve_object_signature_read(&fc_object), VT_ERROR);
+    assert_int_equal(vt_fallcurve_object_dma_buffer_assign(&fc_object, adc_read_buffer, VT_FC_SAMPLE_LENGTH - 1), VT_ERROR);
+    assert_int_equal(vt_fallcurve_object_dma_buffer_assign(&fc_object, adc_read_buffer, 4 * VT_FC_SAMPLE_LENGTH), VT_SUCCESS);
+    assert_int_equal(vt_fallcurve_object_signature_read(&fc_object), VT_ERROR);
+
+    fc_object.fingerprintdb.num_signatures             = 1;
+    fc_object.fingerprintdb.db[0].sampling_interval_us = 10;
+    fc_object.fingerprintdb.db[0].falltime             = 990;
+    fc_object.fingerprintdb.db[0].pearson_coeff        = 0.99f;
+    assert_int_equal(vt_fallcurve_object_signature_process(&fc_object, &sensor_status, &sensor_drift), VT_ERROR);
+
+    vt_gpio_off_count          = 0;
+    vt_interrupt_disable_count = 0;
+    assert_int_equal(vt_fallcurve_object_signature_read(&fc_object), VT_SUCCESS);
+    assert_int_equal(vt_gpio_off_count, 1);
+    assert_int_equal(vt_interrupt_disable_count, 0);
+    assert_float_equal(vt_adc_buffer_read_sampling_frequency, 100000.0f, 0.1f);
+    assert_int_equal(vt_fallcurve_object_signature_process(&fc_object, &sensor_status, &sensor_drift), VT_SUCCESS);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+    assert_int_equal(vt_fallcurve_object_signature_process(&fc_object, &sensor_status, &sensor_drift), VT_ERROR);
+
+    // The slowest template needs 50us x VT_FC_SAMPLE_LENGTH of discharge, more than the buffer holds at 10us
+    fc_object.fingerprintdb.num_signatures             = 2;
+    fc_object.fingerprintdb.db[1].sampling_interval_us = 50;
+    fc_object.fingerprintdb.db[1].falltime             = 4950;
+    fc_object.fingerprintdb.db[1].pearson_coeff        = 0.99f;
+    assert_int_equal(vt_fallcurve_object_signature_read(&fc_object), VT_SUCCESS);
+    assert_float_equal(vt_adc_buffer_read_sampling_frequency, 1000000.0f / 13.0f, 0.1f);
+    assert_int_equal(vt_fallcurve_object_signature_process(&fc_object, &sensor_status, &sensor_drift), VT_SUCCESS);
+    assert_int_equal(sensor_status, VT_SIGNATURE_MATCHING);
+}
+
+static VT_VOID test_vt_fallcurve_object_signature_dma_exclusive(VT_VOID** state)
+{
+    VT_FALLCURVE_OBJECT fc_object[2];
+    VT_DEVICE_DRIVER device_driver = {0};
+    VT_SENSOR_HANDLE sensor_handle[2];
+    VT_FLOAT adc_read_buffer[2][VT_FC_SAMPLE_LENGTH];
+
+    device_driver.gpio_on         = &vt_gpio_on;
+    device_driver.gpio_off        = &vt_gpio_off;
+    device_driver.adc_buffer_read = &vt_adc_buffer_read_deferred;
+    for (VT_UINT iter = 0; iter < 2; iter++)
+    {
+        vt_fallcurve_object_initialize(&fc_object[iter], &device_driver, &sensor_handle[iter]);
+        assert_int_equal(vt_fallcurve_object_dma_buffer_assign(&fc_object[iter], adc_read_buffer[iter], VT_FC_SAMPLE_LENGTH),
+            VT_SUCCESS);
+        fc_object[iter].fingerprintdb.num_signatures             = 1;
+        fc_object[iter].fingerprintdb.db[0].sampling_interval_us = 10;
+    }
+
+    // The second capture would take over the completion callback of the first
+    assert_int_equal(vt_fallcurve_object_signature_read(&fc_object[0]), VT_SUCCESS);
+    assert_int_equal(vt_fallcurve_object_signature_read(&fc_object[1]), VT_ERROR);
+
+    vt_adc_buffer_read_deferred_callback();
+    assert_true(fc_object[0].dma_capture.collection_complete);
+    assert_false(fc_object[1].dma_capture.collection_complete);
+    assert_int_equal(vt_fallcurve_object_signature_read(&fc_object[1]), VT_SUCCESS);
+    vt_adc_buffer_read_deferred_callback();
+    assert_true(fc_object[1].dma_capture.collection_complete);
+}
+
 VT_INT test_vt_fc_object_sensor()
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_vt_fallcurve_object_sensor_calibrate_recalibrate),
         cmocka_unit_test(test_vt_fallcurve_object_sensor_status),
+        cmocka_unit_test(test_vt_fallcurve_object_sensor_status_batch),
+        cmocka_unit_test(test_vt_fallcurve_object_oversampling),
+        cmocka_unit_test(test_vt_fallcurve_object_early_stop),
+        cmocka_unit_test(test_vt_fallcurve_object_shape_fit),
+        cmocka_unit_test(test_vt_fallcurve_object_fixed_point),
+        cmocka_unit_test(test_vt_fallcurve_object_rise_curve),
+        cmocka_unit_test(test_vt_fallcurve_object_signature_dma),
+        cmocka_unit_test(test_vt_fallcurve_object_signature_dma_exclusive),
     };
 
     return cmocka_run_group_tests_name("vt_fc_object_sensor", tests, NULL, NULL);
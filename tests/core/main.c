@@ -9,8 +9,11 @@
 
 #include <cmocka.h>
 
+#include "test_vt_changepoint_definitions.h"
+#include "test_vt_codec_definitions.h"
 #include "test_vt_cs_definitions.h"
 #include "test_vt_fc_definitions.h"
+#include "test_vt_scheduler_definitions.h"
 
 int main()
 {
@@ -25,5 +28,8 @@ int main()
     result += test_vt_cs_object_database();
     result += test_vt_cs_object_initialize();
     result += test_vt_cs_object_sensor();
+    result += test_vt_scheduler_object();
+    result += test_vt_changepoint_detector();
+    result += test_vt_codec();
     return result;
 }
\ No newline at end of file
@@ -0,0 +1,11 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#ifndef _TEST_VT_SCHEDULER_DEFINITIONS_H
+#define _TEST_VT_SCHEDULER_DEFINITIONS_H
+
+#include "vt_defs.h"
+
+VT_INT test_vt_scheduler_object();
+
+#endif
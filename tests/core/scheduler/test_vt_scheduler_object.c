@@ -0,0 +1,158 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+#include "test_vt_scheduler_definitions.h"
+
+#include "vt_scheduler_api.h"
+
+#include "cmocka.h"
+
+static VT_UINT check_cycles(VT_SCHEDULER* scheduler, VT_SCHEDULER_COMPONENT* component, VT_UINT num_cycles, VT_UINT drift)
+{
+    VT_UINT num_checks = 0;
+
+    for (VT_UINT iter = 0; iter < num_cycles; iter++)
+    {
+        vt_scheduler_cycle_start(scheduler);
+        if (vt_scheduler_component_due(scheduler, component))
+        {
+            vt_scheduler_component_record(scheduler, component, VT_SIGNATURE_MATCHING, drift, 0);
+            num_checks++;
+        }
+    }
+
+    return num_checks;
+}
+
+// vt_scheduler_initialize() and vt_scheduler_component_initialize()
+static VT_VOID test_vt_scheduler_initialize(VT_VOID** state)
+{
+    VT_SCHEDULER scheduler;
+    VT_SCHEDULER_COMPONENT component;
+    VT_SCHEDULER_SCHEDULE schedule;
+
+    vt_scheduler_initialize(&scheduler, 2, 5000);
+    vt_scheduler_component_initialize(&component, 1000);
+    assert_int_equal(scheduler.cycle, 0);
+    assert_int_equal(scheduler.max_checks_per_cycle, 2);
+    assert_int_equal(scheduler.max_downtime_us_per_cycle, 5000);
+    assert_int_equal(component.interval, VT_SCHEDULER_MIN_INTERVAL);
+    assert_int_equal(component.downtime_us, 1000);
+
+    vt_scheduler_component_fetch_schedule(&scheduler, &component, &schedule);
+    assert_int_equal(schedule.cycles_until_check, 0);
+    assert_int_equal(schedule.cycles_since_check, 0);
+    assert_int_equal(schedule.last_status, VT_SIGNATURE_EVAL_DEFAULT_VALUE);
+}
+
+// vt_scheduler_component_record() lengthens the interval of a stable sensor up to the maximum
+static VT_VOID test_vt_scheduler_component_record_stable(VT_VOID** state)
+{
+    VT_SCHEDULER scheduler;
+    VT_SCHEDULER_COMPONENT component;
+    VT_SCHEDULER_SCHEDULE schedule;
+
+    vt_scheduler_initialize(&scheduler, 0, 0);
+    vt_scheduler_component_initialize(&component, 0);
+    assert_int_equal(check_cycles(&scheduler, &component, VT_SCHEDULER_STABLE_CHECKS, 10), VT_SCHEDULER_STABLE_CHECKS);
+    assert_int_equal(component.interval, 2 * VT_SCHEDULER_MIN_INTERVAL);
+    assert_true(check_cycles(&scheduler, &component, 20 * VT_SCHEDULER_MAX_INTERVAL, 10) < 40);
+    assert_int_equal(component.interval, VT_SCHEDULER_MAX_INTERVAL);
+
+    // Telemetry status between two checks is the last status recorded
+    vt_scheduler_component_fetch_schedule(&scheduler, &component, &schedule);
+    assert_int_equal(schedule.interval, VT_SCHEDULER_MAX_INTERVAL);
+    assert_int_equal(schedule.cycles_since_check + schedule.cycles_until_check, VT_SCHEDULER_MAX_INTERVAL);
+    assert_int_equal(schedule.last_status, VT_SIGNATURE_MATCHING);
+    assert_int_equal(schedule.last_drift, 10);
+}
+
+// vt_scheduler_component_record() shortens the interval when drift trends up or the sensor stops matching
+static VT_VOID test_vt_scheduler_component_record_drift(VT_VOID** state)
+{
+    VT_SCHEDULER scheduler;
+    VT_SCHEDULER_COMPONENT component;
+
+    vt_scheduler_initialize(&scheduler, 0, 0);
+    vt_scheduler_component_initialize(&component, 0);
+    check_cycles(&scheduler, &component, 20 * VT_SCHEDULER_MAX_INTERVAL, 10);
+    assert_int_equal(component.interval, VT_SCHEDULER_MAX_INTERVAL);
+
+    scheduler.cycle = component.next_check;
+    vt_scheduler_component_record(&scheduler, &component, VT_SIGNATURE_MATCHING, 10 + VT_SCHEDULER_DRIFT_TREND_RISE + 1, 0);
+    assert_int_equal(component.interval, VT_SCHEDULER_MAX_INTERVAL / 2);
+    assert_int_equal(component.next_check, scheduler.cycle + VT_SCHEDULER_MAX_INTERVAL / 2);
+
+    scheduler.cycle = component.next_check;
+    vt_scheduler_component_record(&scheduler, &component, VT_SIGNATURE_NOT_MATCHING, 60, 0);
+    assert_int_equal(component.interval, VT_SCHEDULER_MIN_INTERVAL);
+}
+
+// vt_scheduler_component_initialize() after a template change makes a backed-off component due again
+static VT_VOID test_vt_scheduler_component_reinitialize(VT_VOID** state)
+{
+    VT_SCHEDULER scheduler;
+    VT_SCHEDULER_COMPONENT component;
+    VT_SCHEDULER_SCHEDULE schedule;
+
+    vt_scheduler_initialize(&scheduler, 0, 0);
+    vt_scheduler_component_initialize(&component, 1000);
+    check_cycles(&scheduler, &component, 20 * VT_SCHEDULER_MAX_INTERVAL, 10);
+    assert_int_equal(component.interval, VT_SCHEDULER_MAX_INTERVAL);
+
+    vt_scheduler_component_initialize(&component, component.downtime_us);
+    assert_int_equal(component.interval, VT_SCHEDULER_MIN_INTERVAL);
+    assert_int_equal(component.downtime_us, 1000);
+    vt_scheduler_component_fetch_schedule(&scheduler, &component, &schedule);
+    assert_int_equal(schedule.cycles_until_check, 0);
+    assert_int_equal(schedule.last_status, VT_SIGNATURE_EVAL_DEFAULT_VALUE);
+
+    vt_scheduler_cycle_start(&scheduler);
+    assert_true(vt_scheduler_component_due(&scheduler, &component));
+}
+
+// vt_scheduler_component_due() keeps checks and downtime within the budget of a cycle
+static VT_VOID test_vt_scheduler_component_due_budget(VT_VOID** state)
+{
+    VT_SCHEDULER scheduler;
+    VT_SCHEDULER_COMPONENT components[3];
+
+    vt_scheduler_initialize(&scheduler, 2, 2500);
+    for (VT_UINT iter = 0; iter < 3; iter++)
+    {
+        vt_scheduler_component_initialize(&components[iter], 1000);
+    }
+
+    vt_scheduler_cycle_start(&scheduler);
+    assert_true(vt_scheduler_component_due(&scheduler, &components[0]));
+    assert_true(vt_scheduler_component_due(&scheduler, &components[1]));
+    assert_false(vt_scheduler_component_due(&scheduler, &components[2]));
+    assert_int_equal(scheduler.downtime_spent_us, 2000);
+
+    scheduler.max_checks_per_cycle = 3;
+    vt_scheduler_cycle_start(&scheduler);
+    components[0].downtime_us = 2000;
+    assert_true(vt_scheduler_component_due(&scheduler, &components[0]));
+    assert_false(vt_scheduler_component_due(&scheduler, &components[1]));
+
+    // A component deferred for VT_SCHEDULER_MAX_INTERVAL cycles is checked past the budget
+    scheduler.cycle += VT_SCHEDULER_MAX_INTERVAL;
+    assert_true(vt_scheduler_component_due(&scheduler, &components[2]));
+}
+
+VT_INT test_vt_scheduler_object()
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_vt_scheduler_initialize),
+        cmocka_unit_test(test_vt_scheduler_component_record_stable),
+        cmocka_unit_test(test_vt_scheduler_component_record_drift),
+        cmocka_unit_test(test_vt_scheduler_component_reinitialize),
+        cmocka_unit_test(test_vt_scheduler_component_due_budget),
+    };
+
+    return cmocka_run_group_tests_name("test_vt_scheduler_object", tests, NULL, NULL);
+}
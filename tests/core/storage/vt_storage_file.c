@@ -0,0 +1,104 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "vt_storage_file.h"
+
+static VT_CHAR* storage_file_directory = ".";
+
+static VT_UINT storage_file_path(VT_CHAR* key, VT_CHAR* suffix, VT_CHAR* path, VT_ULONG path_size)
+{
+    VT_INT str_manipulation_return;
+
+    // Keys name a file inside the storage directory and nothing else
+    if (key == NULL || key[0] == '\0' || key[0] == '.' || strchr(key, '/') != NULL)
+    {
+        return VT_ERROR;
+    }
+
+    str_manipulation_return =
+        snprintf(path, path_size, "%s/%s%s%s", storage_file_directory, key, VT_STORAGE_FILE_EXTENSION, suffix);
+    if (str_manipulation_return < 0 || (VT_ULONG)str_manipulation_return >= path_size)
+    {
+        return VT_ERROR;
+    }
+
+    return VT_SUCCESS;
+}
+
+VT_VOID vt_storage_file_directory_set(VT_CHAR* directory)
+{
+    storage_file_directory = directory;
+}
+
+VT_UINT vt_storage_file_store(VT_CHAR* key, VT_UCHAR* buffer, VT_ULONG size)
+{
+    VT_CHAR path[VT_STORAGE_FILE_PATH_MAX_LENGTH];
+    VT_CHAR temporary_path[VT_STORAGE_FILE_PATH_MAX_LENGTH];
+    FILE* file;
+    VT_ULONG written;
+
+    if (storage_file_path(key, "", path, sizeof(path)) || storage_file_path(key, ".tmp", temporary_path, sizeof(temporary_path)))
+    {
+        return VT_ERROR;
+    }
+
+    if ((file = fopen(temporary_path, "wb")) == NULL)
+    {
+        return VT_ERROR;
+    }
+    written = (VT_ULONG)fwrite(buffer, 1, size, file);
+    if (fclose(file) != 0 || written != size)
+    {
+        remove(temporary_path);
+        return VT_ERROR;
+    }
+
+    if (rename(temporary_path, path) != 0)
+    {
+        remove(temporary_path);
+        return VT_ERROR;
+    }
+
+    return VT_SUCCESS;
+}
+
+VT_UINT vt_storage_file_load(VT_CHAR* key, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* size)
+{
+    VT_CHAR path[VT_STORAGE_FILE_PATH_MAX_LENGTH];
+    FILE* file;
+    VT_UINT status = VT_SUCCESS;
+
+    if (storage_file_path(key, "", path, sizeof(path)))
+    {
+        return VT_ERROR;
+    }
+
+    if ((file = fopen(path, "rb")) == NULL)
+    {
+        return VT_ERROR;
+    }
+    *size = (VT_ULONG)fread(buffer, 1, buffer_size, file);
+    if (ferror(file) || fgetc(file) != EOF)
+    {
+        // Read failed or the blob is larger than the buffer
+        status = VT_ERROR;
+    }
+    fclose(file);
+
+    return status;
+}
+
+VT_UINT vt_storage_file_erase(VT_CHAR* key)
+{
+    VT_CHAR path[VT_STORAGE_FILE_PATH_MAX_LENGTH];
+
+    if (storage_file_path(key, "", path, sizeof(path)) || remove(path) != 0)
+    {
+        return VT_ERROR;
+    }
+
+    return VT_SUCCESS;
+}
@@ -0,0 +1,26 @@
+/* Copyright (c) Microsoft Corporation.
+   Licensed under the MIT License. */
+
+#ifndef _VT_STORAGE_FILE_H
+#define _VT_STORAGE_FILE_H
+
+#include "vt_defs.h"
+
+#define VT_STORAGE_FILE_PATH_MAX_LENGTH 256
+#define VT_STORAGE_FILE_EXTENSION       ".vtdb"
+
+/* File backed reference implementation of the storage hooks of VT_DEVICE_DRIVER, one file per key */
+
+// Directory in which blobs are kept, the working directory unless set
+VT_VOID vt_storage_file_directory_set(VT_CHAR* directory);
+
+// Storage store hook, the blob is written to a temporary file and renamed so a power loss never leaves half a blob
+VT_UINT vt_storage_file_store(VT_CHAR* key, VT_UCHAR* buffer, VT_ULONG size);
+
+// Storage load hook
+VT_UINT vt_storage_file_load(VT_CHAR* key, VT_UCHAR* buffer, VT_ULONG buffer_size, VT_ULONG* size);
+
+// Remove the blob stored under key
+VT_UINT vt_storage_file_erase(VT_CHAR* key);
+
+#endif